@@ -0,0 +1,173 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "axis_core.hpp"
+#include "bench_counters.hpp"
+
+// Compares three ways of holding N axes for a tick loop over all of them:
+//   interleaved  - per-axis {config, state} records, the layout you get when
+//                  gains live next to the integrators (the pre-split PI)
+//   split        - per-axis configs in one array, 64-byte hot states in another
+//   shared       - hot states only, one config shared by every axis
+//   plan         - as shared, with the config compiled once into a plan
+//   guarded      - as plan, plus the protection stage on a second line
+//   sensed       - as guarded, with two-shunt current reconstruction, gain
+//                  correction and calibrated offsets
+// Usage: bench_axis_layout [ticks]
+
+namespace {
+
+struct InterleavedAxis {
+    AxisCoreConfig cfg;
+    AxisCoreState st;
+};
+
+AxisCoreConfig make_cfg()
+{
+    AxisCoreConfig cfg{};
+    cfg.traj = TrajConfig{1.0f, 2.0f};
+    cfg.pos  = PositionLoopConfig{-100.0f, 100.0f, PIConfig{2.0f, 0.0f, -100.0f, 100.0f}};
+    cfg.spd  = SpeedLoopConfig{-10.0f, 10.0f, PIConfig{0.5f, 10.0f, -10.0f, 10.0f}};
+    cfg.cur  = CurrentLoopConfig{0.8f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                 PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.foc  = FocConfig{cfg.cur};
+    cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.lim  = LimitsConfig{-10.0f, 10.0f, -100.0f, 100.0f};
+    return cfg;
+}
+
+AxisCoreInput make_input(int axis, int tick)
+{
+    AxisCoreInput in{};
+    in.mode = AxisMode::Position;
+    in.theta_meas = position64_from_rad(0.001f * static_cast<float>((tick + axis) % 1000));
+    in.i_abc = {0.3f, -0.1f, -0.2f};
+    in.theta_target = position64_from_rad(1.0f);
+    in.v_bus = 24.0f;
+    in.theta_elec = 0.004f * static_cast<float>((tick + axis) % 1000);
+    return in;
+}
+
+struct Result {
+    double ns_per_axis_tick;
+    double misses_per_axis_tick;
+};
+
+template <typename Step>
+Result measure(L1MissCounter& pmu, int n_axes, int ticks, Step step)
+{
+    for (int k = 0; k < 10; ++k) {
+        step(k);
+    }
+    pmu.start();
+    int64_t t0 = bench_now_ns();
+    for (int k = 0; k < ticks; ++k) {
+        step(k);
+    }
+    int64_t t1 = bench_now_ns();
+    uint64_t misses = pmu.stop();
+    double n = static_cast<double>(n_axes) * ticks;
+    return Result{(t1 - t0) / n, misses / n};
+}
+
+void print_row(const char* name, int n_axes, const Result& r, bool have_pmu)
+{
+    if (have_pmu) {
+        std::printf("%-12s %6d %10.1f %14.3f\n", name, n_axes, r.ns_per_axis_tick, r.misses_per_axis_tick);
+    } else {
+        std::printf("%-12s %6d %10.1f %14s\n", name, n_axes, r.ns_per_axis_tick, "n/a");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int ticks = argc > 1 ? std::atoi(argv[1]) : 2000;
+    L1MissCounter pmu;
+
+    std::printf("sizeof(AxisCoreState)=%zu sizeof(AxisCoreConfig)=%zu\n",
+                sizeof(AxisCoreState), sizeof(AxisCoreConfig));
+    std::printf("%-12s %6s %10s %14s\n", "layout", "axes", "ns/axis", "L1D miss/axis");
+
+    const AxisCoreConfig base = make_cfg();
+    for (int n_axes : {16, 64, 256, 1024}) {
+        std::vector<InterleavedAxis> inter(n_axes, InterleavedAxis{base, AxisCoreState{}});
+        std::vector<AxisCoreConfig> cfgs(n_axes, base);
+        std::vector<AxisCoreState> hot(n_axes);
+        std::vector<AxisCoreState> hot_shared(n_axes);
+        float sink = 0.0f;
+
+        Result r_inter = measure(pmu, n_axes, ticks, [&](int k) {
+            for (int a = 0; a < n_axes; ++a) {
+                sink += run_axis_core(inter[a].st, inter[a].cfg, make_input(a, k), 5e-5f).m_a;
+            }
+        });
+        Result r_split = measure(pmu, n_axes, ticks, [&](int k) {
+            for (int a = 0; a < n_axes; ++a) {
+                sink += run_axis_core(hot[a], cfgs[a], make_input(a, k), 5e-5f).m_a;
+            }
+        });
+        Result r_shared = measure(pmu, n_axes, ticks, [&](int k) {
+            for (int a = 0; a < n_axes; ++a) {
+                sink += run_axis_core(hot_shared[a], base, make_input(a, k), 5e-5f).m_a;
+            }
+        });
+        AxisCorePlan plan;
+        compile_axis_config(plan, base, 5e-5f);
+        std::vector<AxisCoreState> hot_plan(n_axes);
+        Result r_plan = measure(pmu, n_axes, ticks, [&](int k) {
+            for (int a = 0; a < n_axes; ++a) {
+                sink += run_axis_plan(hot_plan[a], plan, make_input(a, k)).m_a;
+            }
+        });
+        AxisCoreConfig guarded_cfg = base;
+        // Every check enabled but out of reach of the synthetic inputs, whose
+        // sawtooth angle makes the speed estimate jump by thousands of rad/s.
+        guarded_cfg.prot = ProtectionConfig{50.0f, 10.0f, 100.0f, 10.0f, 20.0f, 0.1f, 1.0f, 1e5f};
+        AxisCorePlan guarded_plan;
+        compile_axis_config(guarded_plan, guarded_cfg, 5e-5f);
+        std::vector<AxisCoreState> hot_guarded(n_axes);
+        std::vector<AxisGuardState> guards(n_axes);
+        Result r_guarded = measure(pmu, n_axes, ticks, [&](int k) {
+            for (int a = 0; a < n_axes; ++a) {
+                sink += run_axis_plan(hot_guarded[a], guards[a], guarded_plan, make_input(a, k)).m_a;
+            }
+        });
+        AxisCoreConfig sensed_cfg = guarded_cfg;
+        sensed_cfg.sense = CurrentSenseConfig{true, {1.01f, 0.99f, 0.0f}, 1000};
+        AxisCorePlan sensed_plan;
+        compile_axis_config(sensed_plan, sensed_cfg, 5e-5f);
+        std::vector<AxisCoreState> hot_sensed(n_axes);
+        // Offsets already measured, so every tick runs the loops.
+        AxisGuardState calibrated{};
+        calibrated.sense.offset = {0.02f, -0.01f, 0.0f};
+        calibrated.sense.calib_count = sensed_cfg.sense.calib_ticks;
+        std::vector<AxisGuardState> sensed_guards(n_axes, calibrated);
+        Result r_sensed = measure(pmu, n_axes, ticks, [&](int k) {
+            for (int a = 0; a < n_axes; ++a) {
+                sink += run_axis_plan(hot_sensed[a], sensed_guards[a], sensed_plan, make_input(a, k)).m_a;
+            }
+        });
+        bench_do_not_optimize(sink);
+
+        print_row("interleaved", n_axes, r_inter, pmu.valid());
+        print_row("split", n_axes, r_split, pmu.valid());
+        print_row("shared", n_axes, r_shared, pmu.valid());
+        print_row("plan", n_axes, r_plan, pmu.valid());
+        print_row("guarded", n_axes, r_guarded, pmu.valid());
+        print_row("sensed", n_axes, r_sensed, pmu.valid());
+        for (const std::vector<AxisGuardState>* set : {&guards, &sensed_guards}) {
+            for (const AxisGuardState& g : *set) {
+                if (g.prot.faults != 0) {
+                    std::printf("guarded axis tripped (faults 0x%x); timing not comparable\n", g.prot.faults);
+                    return 1;
+                }
+            }
+        }
+    }
+    if (!pmu.valid()) {
+        std::printf("perf_event_open unavailable; L1D misses not reported\n");
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// L1D read-miss counter via perf_event_open. Unavailable under many
+// containers (perf_event_paranoid, seccomp); valid() is then false and
+// benchmarks report timing only.
+class L1MissCounter {
+public:
+    L1MissCounter()
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~L1MissCounter()
+    {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    L1MissCounter(const L1MissCounter&) = delete;
+    L1MissCounter& operator=(const L1MissCounter&) = delete;
+
+    bool valid() const { return fd_ >= 0; }
+
+    void start()
+    {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    uint64_t stop()
+    {
+        uint64_t n = 0;
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &n, sizeof(n)) != sizeof(n)) {
+                n = 0;
+            }
+        }
+        return n;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+inline int64_t bench_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+inline void bench_do_not_optimize(const T& v)
+{
+    asm volatile("" : : "r,m"(v) : "memory");
+}
@@ -0,0 +1,135 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "sim_axis_runner.hpp"
+#include "bench_counters.hpp"
+
+// Runs the simulated axis in velocity mode on a quantizing incremental
+// encoder, once with the low-pass speed estimator and once with the Kalman
+// filter, and reports speed-estimate noise at constant speed, the speed dip
+// after a load step, and the cost of one estimator step.
+// Usage: bench_estimator [lines] [passes]
+
+namespace {
+
+constexpr float dt = 5e-5f;
+constexpr uint16_t spd_div = 4;
+constexpr float w_target = 50.0f;
+constexpr float load_step = 0.05f;
+constexpr int steps = 40000;
+constexpr int load_at = 30000;
+
+struct Result {
+    float rms_est_err;      // |w_est - w_true| over the settled window
+    float rms_speed_err;    // |w_true - w_target| over the same window
+    float dip;              // largest w_target - w_true after the load step
+    std::vector<Position64> theta;
+    std::vector<float> iq;
+};
+
+SimAxisConfig make_config(SpeedEstimatorKind kind)
+{
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.spd = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f, PIConfig{5.0f, 500.0f, -100.0f, 100.0f},
+                                         PIConfig{5.0f, 500.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.lim = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+    cfg.axis_cfg.rate = MultirateConfig{spd_div, spd_div, 0};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+    cfg.v_bus = 24.0f;
+
+    const float kt = 1.5f * cfg.motor_params.p * cfg.motor_params.psi_m;
+    cfg.axis_cfg.est.lp = LowPassConfig{0.2f};
+    cfg.axis_cfg.est.kind = kind;
+    kalman_build(cfg.axis_cfg.est.kf,
+                 KalmanModel{cfg.motor_params.J, cfg.motor_params.B, kt, 0.05f, 5e-3f, 3e-3f},
+                 dt * spd_div);
+    return cfg;
+}
+
+Result run(SpeedEstimatorKind kind, uint32_t lines)
+{
+    SimEncoderConfig enc{};
+    encoder_build(enc.decoder, EncoderType::Incremental, lines, 4, 0, 0.0f);
+    SimAxisConfig cfg = make_config(kind);
+    cfg.encoder = &enc;
+
+    Result r{};
+    SimAxisState st{};
+    double est_sq = 0.0;
+    double spd_sq = 0.0;
+    int n = 0;
+    for (int k = 0; k < steps; ++k) {
+        if (k == load_at) {
+            cfg.load.T_const = load_step;
+        }
+        AxisCoreOutput out = sim_axis_step(st, cfg, dt, AxisMode::Velocity, 0.0f, w_target, 0.0f);
+        float w_true = st.motor_state.omega_m;
+        if (k % spd_div == 0) {
+            r.theta.push_back(st.theta_mech);
+            r.iq.push_back(out.iq_cmd);
+        }
+        if (k >= load_at / 2 && k < load_at) {
+            float e = st.axis_state.est.lp.y - w_true;
+            float s = w_true - w_target;
+            est_sq += static_cast<double>(e) * e;
+            spd_sq += static_cast<double>(s) * s;
+            ++n;
+        }
+        if (k >= load_at) {
+            r.dip = std::fmax(r.dip, w_target - w_true);
+        }
+    }
+    r.rms_est_err = static_cast<float>(std::sqrt(est_sq / n));
+    r.rms_speed_err = static_cast<float>(std::sqrt(spd_sq / n));
+    return r;
+}
+
+double ns_per_step(const SpeedEstimatorConfig& cfg, const Result& r, int passes)
+{
+    const float dt_spd = dt * spd_div;
+    float sink = 0.0f;
+    SpeedEstimatorState st{};
+    for (size_t k = 0; k < r.theta.size(); ++k) {
+        sink += run_speed_estimator(st, cfg, SpeedEstimatorInput{r.theta[k], r.iq[k]}, dt_spd).w_filtered;
+    }
+    int64_t t0 = bench_now_ns();
+    for (int p = 0; p < passes; ++p) {
+        st = SpeedEstimatorState{};
+        for (size_t k = 0; k < r.theta.size(); ++k) {
+            sink += run_speed_estimator(st, cfg, SpeedEstimatorInput{r.theta[k], r.iq[k]}, dt_spd).w_filtered;
+        }
+    }
+    int64_t t1 = bench_now_ns();
+    bench_do_not_optimize(sink);
+    return static_cast<double>(t1 - t0) / (static_cast<double>(passes) * r.theta.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t lines = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2048;
+    const int passes = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    const SpeedEstimatorKind kinds[] = {SpeedEstimatorKind::LowPass, SpeedEstimatorKind::Kalman};
+    const char* names[] = {"lowpass", "kalman"};
+
+    std::printf("%u lines, %.0f rad/s, %.3f N*m load step\n", lines, w_target, load_step);
+    std::printf("%-8s %14s %14s %12s %10s\n", "est", "rms est err", "rms spd err", "load dip", "ns/step");
+    for (int i = 0; i < 2; ++i) {
+        Result r = run(kinds[i], lines);
+        double ns = ns_per_step(make_config(kinds[i]).axis_cfg.est, r, passes);
+        std::printf("%-8s %14.3f %14.3f %12.3f %10.2f\n",
+                    names[i], r.rms_est_err, r.rms_speed_err, r.dip, ns);
+    }
+    return 0;
+}
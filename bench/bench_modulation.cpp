@@ -0,0 +1,80 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "modulation.hpp"
+#include "bench_counters.hpp"
+
+// Compares run_modulation (inverse Clarke, per-phase division, min/max
+// search) with run_modulator (cached 1/v_bus, sector lookup) over a sweep of
+// voltage vectors, and reports the largest duty difference between them.
+// Usage: bench_modulation [passes]
+
+namespace {
+
+template <typename Fn>
+double ns_per_call(int passes, int n, Fn fn)
+{
+    for (int k = 0; k < n; ++k) {
+        fn(k);
+    }
+    int64_t t0 = bench_now_ns();
+    for (int p = 0; p < passes; ++p) {
+        for (int k = 0; k < n; ++k) {
+            fn(k);
+        }
+    }
+    int64_t t1 = bench_now_ns();
+    return static_cast<double>(t1 - t0) / (static_cast<double>(passes) * n);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int passes = argc > 1 ? std::atoi(argv[1]) : 200;
+    const float v_bus = 24.0f;
+    const int n = 4096;
+
+    std::vector<AlphaBeta> v(n);
+    for (int k = 0; k < n; ++k) {
+        float th = two_pi_v * k / n;
+        float mag = v_bus * (0.05f + 0.8f * static_cast<float>(k % 97) / 97.0f);
+        v[k] = AlphaBeta{mag * std::cos(th), mag * std::sin(th)};
+    }
+
+    const ModulationMode modes[] = {
+        ModulationMode::Svpwm,
+        ModulationMode::Dpwm60,
+        ModulationMode::Overmod,
+    };
+    const char* names[] = {"svpwm", "dpwm60", "overmod"};
+
+    std::printf("%-8s %14s %14s %12s\n", "mode", "reference ns", "modulator ns", "max |dm|");
+    for (int m = 0; m < 3; ++m) {
+        ModulationConfig cfg{modes[m]};
+        ModulatorState mod{};
+        modulator_set_vbus(mod, v_bus);
+        float sink = 0.0f;
+
+        double t_ref = ns_per_call(passes, n, [&](int k) {
+            sink += run_modulation(cfg, ModulationInput{v[k], v_bus}).m_a;
+        });
+        double t_mod = ns_per_call(passes, n, [&](int k) {
+            modulator_set_vbus(mod, v_bus);
+            sink += run_modulator(mod, cfg, v[k]).m_a;
+        });
+        bench_do_not_optimize(sink);
+
+        float max_dm = 0.0f;
+        for (int k = 0; k < n; ++k) {
+            ModulationOutput a = run_modulation(cfg, ModulationInput{v[k], v_bus});
+            ModulationOutput b = run_modulator(mod, cfg, v[k]);
+            max_dm = std::fmax(max_dm, std::fabs(a.m_a - b.m_a));
+            max_dm = std::fmax(max_dm, std::fabs(a.m_b - b.m_b));
+            max_dm = std::fmax(max_dm, std::fabs(a.m_c - b.m_c));
+        }
+        std::printf("%-8s %14.2f %14.2f %12.2e\n", names[m], t_ref, t_mod, max_dm);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "bench_counters.hpp"
+#include "partitioned_executor.hpp"
+
+// Strong scaling of the partitioned executor: fixed axis count, 1..N
+// workers pinned to consecutive CPUs, free-running lock-step ticks.
+// Usage: bench_partitioned [ticks] [max_workers]
+
+namespace {
+
+AxisCoreConfig make_cfg()
+{
+    AxisCoreConfig cfg{};
+    cfg.traj = TrajConfig{1.0f, 2.0f};
+    cfg.pos  = PositionLoopConfig{-100.0f, 100.0f, PIConfig{2.0f, 0.0f, -100.0f, 100.0f}};
+    cfg.spd  = SpeedLoopConfig{-10.0f, 10.0f, PIConfig{0.5f, 10.0f, -10.0f, 10.0f}};
+    cfg.cur  = CurrentLoopConfig{0.8f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                 PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.foc  = FocConfig{cfg.cur};
+    cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.lim  = LimitsConfig{-10.0f, 10.0f, -100.0f, 100.0f};
+    return cfg;
+}
+
+void sense(void*, int axis, uint64_t tick, AxisCoreInput& in)
+{
+    in.theta_meas = position64_from_rad(0.001f * static_cast<float>((tick + axis) % 1000));
+    in.theta_elec = 0.004f * static_cast<float>((tick + axis) % 1000);
+    in.i_abc = {0.3f, -0.1f, -0.2f};
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint64_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    const int max_workers = argc > 2 ? std::atoi(argv[2]) : (hw > 0 ? hw : 1);
+
+    std::printf("%6s %8s %12s %10s\n", "axes", "workers", "ns/tick", "speedup");
+    for (int n_axes : {64, 256, 1024}) {
+        std::vector<AxisCoreConfig> cfgs(n_axes, make_cfg());
+        // Pair every even axis with its odd neighbour to exercise mailboxes.
+        std::vector<AxisLink> links;
+        for (int a = 0; a + 1 < n_axes; a += 2) {
+            links.push_back(AxisLink{static_cast<uint16_t>(a), static_cast<uint16_t>(a + 1), 1.0f, 0.0f});
+        }
+
+        double base_ns = 0.0;
+        for (int w = 1; w <= max_workers; w = w < 4 ? w + 1 : w * 2) {
+            PartitionedExecutor ex;
+            PartitionedConfig pcfg{w, 0, 0, ticks, 5e-5f};
+            if (!partitioned_setup(ex, pcfg, cfgs.data(), n_axes, links.data(),
+                                   static_cast<int>(links.size()), sense, nullptr, nullptr)) {
+                return 1;
+            }
+            for (int a = 0; a < n_axes; ++a) {
+                AxisCoreInput in{};
+                in.mode = AxisMode::Position;
+                in.theta_target = position64_from_rad(1.0f);
+                in.v_bus = 24.0f;
+                partitioned_set_command(ex, a, in);
+            }
+
+            int64_t t0 = bench_now_ns();
+            partitioned_run(ex);
+            double ns = static_cast<double>(bench_now_ns() - t0) / ticks;
+            if (w == 1) {
+                base_ns = ns;
+            }
+            std::printf("%6d %8d %12.0f %10.2f\n", n_axes, w, ns, base_ns / ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <cstdio>
+#include <cstdlib>
+#include "sim_axis_runner.hpp"
+#include "bench_counters.hpp"
+
+// Wall-clock cost of one sim_axis_step on the closed-loop regression
+// steps (sim/tests/test_regression.cpp), which check only the
+// deterministic step metrics.
+// Usage: bench_sim_step [passes]
+
+namespace {
+
+struct StepCase {
+    const char* name;
+    AxisMode mode;
+    float target;
+    float duration;
+    float t_dead;
+    float J;
+};
+
+constexpr StepCase cases[] = {
+    {"position_step",          AxisMode::Position,  1.0f,  1.5f,  0.0f,  1e-4f},
+    {"velocity_step",          AxisMode::Velocity,  50.0f, 1.5f,  0.0f,  1e-4f},
+    {"current_step",           AxisMode::CurrentIq, 2.0f,  0.05f, 0.0f,  0.1f},
+    {"velocity_step_deadtime", AxisMode::Velocity,  50.0f, 1.5f,  1e-6f, 1e-4f},
+};
+
+SimAxisConfig make_cfg(const StepCase& c)
+{
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.traj = TrajConfig{5.0f, 50.0f};
+    cfg.axis_cfg.pos  = PositionLoopConfig{-100.0f, 100.0f, PIConfig{20.0f, 0.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.spd  = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur  = CurrentLoopConfig{1.0f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                          PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = c.J;
+    cfg.motor_params.B = 0.001f;
+
+    cfg.inverter.t_dead = c.t_dead;
+    cfg.inverter.f_pwm = 20000.0f;
+    cfg.inverter.i_dead_band = 0.1f;
+
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int passes = argc > 1 ? std::atoi(argv[1]) : 3;
+    const float dt = 5e-5f;
+
+    std::printf("%-24s %10s %10s\n", "case", "averaged", "switched");
+    for (const StepCase& c : cases) {
+        double best[2] = {0.0, 0.0};
+        for (int sw = 0; sw < 2; ++sw) {
+            SimAxisConfig cfg = make_cfg(c);
+            cfg.switched_pwm = sw != 0;
+            const int steps = static_cast<int>(c.duration / dt);
+            for (int p = 0; p < passes; ++p) {
+                SimAxisState st{};
+                float sink = 0.0f;
+                const int64_t t0 = bench_now_ns();
+                for (int k = 0; k < steps; ++k) {
+                    sink += sim_axis_step(st, cfg, dt, c.mode, c.target, c.target, c.target).m_a;
+                }
+                const int64_t t1 = bench_now_ns();
+                bench_do_not_optimize(sink);
+                const double ns = static_cast<double>(t1 - t0) / steps;
+                best[sw] = (p == 0 || ns < best[sw]) ? ns : best[sw];
+            }
+        }
+        std::printf("%-24s %10.1f %10.1f\n", c.name, best[0], best[1]);
+    }
+    return 0;
+}
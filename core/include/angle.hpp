@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+// Angle as a 32-bit fraction of one turn: 2^32 counts = 2*pi rad. Unsigned
+// overflow is the wrap, so accumulating and differencing angles needs no
+// floor or division, and resolution does not decay with accumulated turns.
+using Angle32 = uint32_t;
+
+constexpr float angle32_rad_per_count = 6.28318530717958647692f / 4294967296.0f;
+constexpr float angle32_counts_per_rad = 4294967296.0f / 6.28318530717958647692f;
+
+// Defined for every float. From 2^55 counts up a float is a whole number of
+// turns (its ulp is 2^32 counts), so anything int64 cannot hold reduces to
+// 0, as does a non-finite input; the comparisons are false for NaN.
+[[nodiscard]] inline Angle32 angle32_from_rad(float rad) noexcept {
+    float counts = rad * angle32_counts_per_rad;
+    if (!(counts > -0x1p62f && counts < 0x1p62f)) {
+        return 0u;
+    }
+    return static_cast<Angle32>(static_cast<int64_t>(counts));
+}
+
+// [0, 2*pi). Conversion rounding just below a full turn lands on 0.
+[[nodiscard]] inline float angle32_to_rad(Angle32 a) noexcept {
+    float r = static_cast<float>(a) * angle32_rad_per_count;
+    return r < 6.28318530717958647692f ? r : 0.0f;
+}
+
+// [-pi, pi).
+[[nodiscard]] inline float angle32_to_signed_rad(Angle32 a) noexcept {
+    float r = static_cast<float>(static_cast<int32_t>(a)) * angle32_rad_per_count;
+    return r < 3.14159265358979323846f ? r : -3.14159265358979323846f;
+}
+
+// Shortest signed difference a - b, in counts.
+[[nodiscard]] inline int32_t angle32_delta(Angle32 a, Angle32 b) noexcept {
+    return static_cast<int32_t>(a - b);
+}
+
+// Multi-turn position in Q32.32 turns: the high word counts whole turns and
+// the low word is the Angle32 within the turn. Differences are exact integer
+// subtractions; only the final conversion to radians rounds.
+using Position64 = int64_t;
+
+constexpr Position64 position64_one_turn = Position64{1} << 32;
+
+[[nodiscard]] inline Position64 position64_from_rad(float rad) noexcept {
+    return static_cast<Position64>(rad * angle32_counts_per_rad);
+}
+
+[[nodiscard]] inline float position64_to_rad(Position64 p) noexcept {
+    return static_cast<float>(p) * angle32_rad_per_count;
+}
+
+[[nodiscard]] inline Angle32 position64_angle(Position64 p) noexcept {
+    return static_cast<Angle32>(p);
+}
+
+// a - b in radians.
+[[nodiscard]] inline float position64_delta_rad(Position64 a, Position64 b) noexcept {
+    return static_cast<float>(a - b) * angle32_rad_per_count;
+}
+
+// atan2 as an Angle32, without libm: octant reduction and an odd polynomial
+// on [0, 1], about 1e-5 rad worst case. (0, 0) maps to 0.
+[[nodiscard]] inline Angle32 angle32_atan2(float y, float x) noexcept {
+    float ax = x < 0.0f ? -x : x;
+    float ay = y < 0.0f ? -y : y;
+    float hi = ax > ay ? ax : ay;
+    if (hi <= 0.0f) {
+        return 0;
+    }
+    float z = (ax > ay ? ay : ax) / hi;
+    float z2 = z * z;
+    float a = z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f
+            + z2 * (-0.0851330f + z2 * 0.0208351f))));
+    if (ay > ax) a = 1.57079632679489661923f - a;
+    if (x < 0.0f) a = 3.14159265358979323846f - a;
+    if (y < 0.0f) a = -a;
+    return angle32_from_rad(a);
+}
@@ -5,10 +5,17 @@
 #include "speed_loop.hpp"
 #include "foc.hpp"
 #include "modulation.hpp"
+#include "deadtime_comp.hpp"
 #include "speed_estimator.hpp"
 #include "limits.hpp"
+#include "multirate.hpp"
+#include "protection.hpp"
+#include "thermal_estimator.hpp"
+#include "current_sense.hpp"
 
-enum class AxisMode {
+#include <cstdint>
+
+enum class AxisMode : uint8_t {
     Idle,
     CurrentIq,
     Velocity,
@@ -19,6 +26,10 @@ struct AxisCoreStatus {
     bool iq_limited;
     bool vel_limited;
     bool saturated;
+    uint8_t faults;     // latched axis_fault_* bits; nonzero holds the axis idle
+    float iq_scale;     // thermal derating applied to the iq limits; 1 = none
+    float t_winding;    // degC, estimated; ambient without a guard
+    bool calibrating;   // current-sense offset window open; the axis is held idle
 };
 
 struct AxisCoreConfig {
@@ -29,41 +40,133 @@ struct AxisCoreConfig {
     FocConfig            foc;
     SpeedEstimatorConfig est;
     LimitsConfig         lim;
+    ModulationConfig     mod;
+    DeadtimeCompConfig   dtc;
+    MultirateConfig      rate;
+    bool                 bumpless;
+    ProtectionConfig     prot;
+    ThermalEstimatorConfig thermal;
+    CurrentSenseConfig   sense;
 };
 
-struct AxisCoreState {
+// Everything touched per tick, and nothing else: gains and limits live in
+// AxisCoreConfig, which is shared read-only across axes. One line per axis
+// keeps an array of axes free of false sharing and split-line loads.
+struct alignas(64) AxisCoreState {
     TrajState             traj;
     PositionLoopState     pos;
     SpeedLoopState        spd;
     FocState              foc;
     SpeedEstimatorState   est;
+    MultirateState        rate;
     LimitsState           lim;
+    AxisMode              mode_prev;
+};
+
+static_assert(sizeof(AxisCoreState) == 64, "AxisCoreState must fit one cache line");
+
+// Supervision state and the modulator's cached bus scale, kept off the
+// control line so AxisCoreState stays one line; it is a line of its own
+// for the same reason.
+struct alignas(64) AxisGuardState {
+    ProtectionState prot;
+    ThermalEstimatorState thermal;
+    CurrentSenseState sense;
+    ModulatorState mod;
 };
 
+static_assert(sizeof(AxisGuardState) == 64, "AxisGuardState must fit one cache line");
+
 struct AxisCoreInput {
     AxisMode mode;
-    float theta_meas;
-    PhaseCurrents i_abc;
-    float theta_target;
+    Position64 theta_meas;
+    PhaseCurrents i_abc;    // raw readings; see CurrentSenseConfig
+    Position64 theta_target;
     float w_target;
     float iq_target;
     float v_bus;
     float theta_elec;
+    bool fault_reset;   // clears latched faults before this tick's checks
 };
 
+// m_abc = 0 is the zero vector, which still switches the bridge and shorts
+// the windings through it; pwm_enable is what lets the gates switch at all.
+// It is only set on ticks that run a loop, so Idle, a latched fault and
+// every other early exit leave the legs floating.
 struct AxisCoreOutput {
+    bool  pwm_enable;
     float m_a;
     float m_b;
     float m_c;
     DQ    i_dq;
     float iq_cmd;
     float w_cmd;
-    float theta_ref;
+    Position64 theta_ref;
     AxisCoreStatus status;
 };
 
+// AxisCoreConfig compiled for a fixed tick by compile_axis_config: every
+// stage's constants resolved once (clamped filter coefficient, 1 / max_acc,
+// gains pre-scaled by their loop's dt), so run_axis_plan does no validation
+// of its own and its only division is the modulator's 1 / v_bus. Like
+// AxisCoreConfig, one plan can be shared read-only by many axes.
+struct AxisCorePlan {
+    TrajPlan             traj;
+    PositionLoopPlan     pos;
+    SpeedLoopPlan        spd;
+    FocPlan              foc;
+    SpeedEstimatorPlan   est;
+    LimitsConfig         lim;
+    ModulationConfig     mod;
+    DeadtimeCompPlan     dtc;
+    MultirateConfig      rate;
+    bool                 bumpless;
+    ProtectionPlan       prot;
+    ThermalEstimatorPlan thermal;
+    CurrentSensePlan     sense;
+    float                dt;
+    float                dt_spd;
+    float                dt_pos;
+};
+
+// Always fills plan, reproducing what run_axis_core does with cfg; returns
+// false if any stage's config is invalid (negative gains, inverted limits,
+// a Kalman gain built for another speed-loop period, dt <= 0, ...). Callers
+// that own a config should refuse it then rather than run the plan.
+bool compile_axis_config(
+    AxisCorePlan& plan,
+    const AxisCoreConfig& cfg,
+    float dt) noexcept;
+
+// Without a guard the protection stage is skipped and faults stay 0, the
+// current readings get gain correction but no offset calibration, and
+// 1 / v_bus is recomputed every tick.
+AxisCoreOutput run_axis_plan(
+    AxisCoreState& state,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in) noexcept;
+
+// Runs the current-sense offset calibration until its window closes, and
+// the protection stage and the thermal estimator first, every tick and
+// whatever the mode, the calibration ticks included. While calibrating or
+// while a fault is latched the gates are off (pwm_enable false), and the
+// axis rejoins through the Idle bumpless path afterwards. The thermal estimate scales both iq limits for the tick.
+AxisCoreOutput run_axis_plan(
+    AxisCoreState& state,
+    AxisGuardState& guard,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in) noexcept;
+
+// Compiles cfg on every call; for callers whose config changes per tick.
+AxisCoreOutput run_axis_core(
+    AxisCoreState& state,
+    const AxisCoreConfig& cfg,
+    const AxisCoreInput& in,
+    float dt) noexcept;
+
 AxisCoreOutput run_axis_core(
     AxisCoreState& state,
+    AxisGuardState& guard,
     const AxisCoreConfig& cfg,
     const AxisCoreInput& in,
     float dt) noexcept;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include "multirate.hpp"
+
+constexpr int sched_max_slots = 64;
+
+struct SchedAxisLoad {
+    uint16_t spd_div;
+    uint16_t pos_div;
+    float tick_ns;
+    float spd_ns;
+    float pos_ns;
+};
+
+struct SchedConfig {
+    float tick_budget_ns;
+    float margin;
+};
+
+struct SchedReport {
+    int n_slots;
+    float slot_ns[sched_max_slots];
+    float worst_ns;
+    float mean_ns;
+    float worst_utilization;
+    int worst_slot;
+    bool hyperperiod_ok;
+    bool deadline_met;
+};
+
+bool plan_axis_schedule(
+    const SchedAxisLoad* axes,
+    int n_axes,
+    const SchedConfig& cfg,
+    uint16_t* phases,
+    SchedReport& report) noexcept;
+
+[[nodiscard]] inline MultirateConfig sched_multirate_config(
+    const SchedAxisLoad& axis,
+    uint16_t phase) noexcept
+{
+    return MultirateConfig{axis.spd_div, axis.pos_div, phase};
+}
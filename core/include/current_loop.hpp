@@ -5,11 +5,13 @@
 
 struct CurrentLoopConfig {
     float mod_radius;
+    PIConfig id;
+    PIConfig iq;
 };
 
 struct CurrentLoopState {
-    PI id;
-    PI iq;
+    PIState id;
+    PIState iq;
 };
 
 struct CurrentLoopInput {
@@ -27,3 +29,23 @@ CurrentLoopOutput run_current_loop(
     const CurrentLoopConfig& cfg,
     const CurrentLoopInput& in,
     float dt) noexcept;
+
+
+struct CurrentLoopPlan {
+    float mod_radius;
+    PIPlan id;
+    PIPlan iq;
+    bool enabled;       // mod_radius > 0; otherwise the loop outputs zero
+};
+
+// Always fills plan; returns false if either PI is invalid or mod_radius is
+// not positive.
+bool current_loop_plan_build(
+    CurrentLoopPlan& plan,
+    const CurrentLoopConfig& cfg,
+    float dt) noexcept;
+
+CurrentLoopOutput run_current_loop_plan(
+    CurrentLoopState& state,
+    const CurrentLoopPlan& plan,
+    const CurrentLoopInput& in) noexcept;
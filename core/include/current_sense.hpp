@@ -0,0 +1,59 @@
+#pragma once
+
+#include "foc_math.hpp"
+
+#include <cstdint>
+
+// Raw phase-current readings to the currents the loops use: per-phase
+// offset and gain correction, and on two-shunt boards phase c rebuilt from
+// a and b. Offsets are measured, not configured: for calib_ticks after
+// start-up (or current_sense_recalibrate) the gates are held off and the
+// readings, which should all be zero, are averaged.
+struct CurrentSenseConfig {
+    bool two_shunt;         // phase c is not measured
+    PhaseCurrents scale;    // per-phase gain correction; 0 = 1
+    uint32_t calib_ticks;   // offset averaging window; 0 = no offset correction
+};
+
+struct CurrentSensePlan {
+    PhaseCurrents scale;
+    float inv_calib;
+    uint32_t calib_ticks;
+    bool two_shunt;
+};
+
+struct CurrentSenseState {
+    PhaseCurrents offset;   // raw reading at zero current
+    PhaseCurrents acc;
+    uint32_t calib_count;   // samples averaged so far
+};
+
+// Always fills plan; returns false for a negative gain correction.
+bool current_sense_plan_build(
+    CurrentSensePlan& plan,
+    const CurrentSenseConfig& cfg) noexcept;
+
+// True while the offset window is still open; the caller must keep the
+// gates off for those ticks. Zero modulation is not enough: the zero
+// vector still switches, and the dead-time and ripple currents it drives
+// would be averaged into the offsets.
+[[nodiscard]] inline bool current_sense_calibrating(
+    const CurrentSenseState& state,
+    const CurrentSensePlan& plan) noexcept
+{
+    return state.calib_count < plan.calib_ticks;
+}
+
+// Adds raw to the offset window; the offsets are set on its last sample.
+void current_sense_calibrate(
+    CurrentSenseState& state,
+    const CurrentSensePlan& plan,
+    const PhaseCurrents& raw) noexcept;
+
+PhaseCurrents current_sense_correct(
+    const CurrentSenseState& state,
+    const CurrentSensePlan& plan,
+    const PhaseCurrents& raw) noexcept;
+
+// Discards the offsets and reopens the window.
+void current_sense_recalibrate(CurrentSenseState& state) noexcept;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "foc_math.hpp"
+
+struct DeadtimeCompConfig {
+    float v_comp;
+    float i_band;
+};
+
+struct DeadtimeCompInput {
+    float m_a;
+    float m_b;
+    float m_c;
+    PhaseCurrents i_abc;
+    float v_bus;
+};
+
+struct DeadtimeCompOutput {
+    float m_a;
+    float m_b;
+    float m_c;
+};
+
+DeadtimeCompOutput run_deadtime_comp(
+    const DeadtimeCompConfig& cfg,
+    const DeadtimeCompInput& in) noexcept;
+
+// The band reciprocal is taken once; the bus-dependent scale comes from the
+// modulator's cached 1 / (v_bus / 2).
+struct DeadtimeCompPlan {
+    float v_comp;
+    float inv_band;
+};
+
+// Always fills plan; returns false for negative or non-finite settings.
+bool deadtime_comp_plan_build(
+    DeadtimeCompPlan& plan,
+    const DeadtimeCompConfig& cfg) noexcept;
+
+DeadtimeCompOutput run_deadtime_comp_plan(
+    const DeadtimeCompPlan& plan,
+    const DeadtimeCompInput& in,
+    float inv_half_vbus) noexcept;
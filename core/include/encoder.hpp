@@ -0,0 +1,62 @@
+#pragma once
+
+#include "angle.hpp"
+
+#include <cstdint>
+
+enum class EncoderType : uint8_t {
+    Incremental,
+    SinCos,
+};
+
+// Built by encoder_build; index_scale / index_scale_frac split 2^32 / lines
+// so converting a line index to an angle needs no division per tick.
+struct EncoderConfig {
+    EncoderType type;
+    uint32_t lines;         // counts per turn (incremental) or sin/cos periods per turn
+    uint32_t pole_pairs;
+    Angle32 elec_offset;    // electrical angle at mechanical zero
+    float w_alpha;          // speed filter for extrapolation; 0 = raw difference
+    uint32_t index_scale;
+    uint32_t index_scale_frac;
+};
+
+struct EncoderState {
+    int32_t turns;
+    uint32_t index;         // count, or quarter period for SinCos, within the turn
+    uint16_t count_prev;
+    bool initialized;
+    Position64 theta_prev;
+    int64_t t_prev_ns;
+    float w;
+};
+
+// count is the free-running quadrature counter; for SinCos it counts the
+// comparator edges of the two channels, four per period. sin / cos are the
+// analog channels, used only by SinCos.
+struct EncoderInput {
+    uint16_t count;
+    float sin;
+    float cos;
+    int64_t t_sample_ns;
+    int64_t t_apply_ns;     // PWM centre the angle will be used at
+};
+
+struct EncoderOutput {
+    Position64 theta_mech;  // extrapolated to t_apply_ns
+    float theta_elec;       // [0, 2*pi), extrapolated to t_apply_ns
+    float w;
+};
+
+bool encoder_build(
+    EncoderConfig& cfg,
+    EncoderType type,
+    uint32_t lines,
+    uint32_t pole_pairs,
+    Angle32 elec_offset,
+    float w_alpha) noexcept;
+
+EncoderOutput run_encoder(
+    EncoderState& state,
+    const EncoderConfig& cfg,
+    const EncoderInput& in) noexcept;
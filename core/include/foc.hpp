@@ -28,4 +28,19 @@ FocOutput run_foc(
     const FocConfig& cfg,
     const FocInput& in,
     float dt
-) noexcept;
\ No newline at end of file
+) noexcept;
+
+struct FocPlan {
+    CurrentLoopPlan loop;
+};
+
+// Always fills plan; returns false if the current loop plan is invalid.
+bool foc_plan_build(
+    FocPlan& plan,
+    const FocConfig& cfg,
+    float dt) noexcept;
+
+FocOutput run_foc_plan(
+    FocState& state,
+    const FocPlan& plan,
+    const FocInput& in) noexcept;
\ No newline at end of file
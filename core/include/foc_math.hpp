@@ -3,6 +3,8 @@
 #include <cmath>
 #include <type_traits>
 
+#include "angle.hpp"
+
 struct PhaseCurrents {
     float a, b, c;
 };
@@ -32,20 +34,11 @@ template <typename T>
 
 
 [[nodiscard]] inline float wrap_2pi(float angle) noexcept {
-    float k = std::floor(angle / two_pi_v);
-    angle -= k * two_pi_v;
-    if (angle < 0.0f) {
-        angle += two_pi_v;
-    }
-    return angle;
+    return angle32_to_rad(angle32_from_rad(angle));
 }
 
 [[nodiscard]] inline float wrap_pi(float angle) noexcept {
-    angle = wrap_2pi(angle);
-    if (angle >= pi_v) {
-        angle -= two_pi_v;
-    }
-    return angle;
+    return angle32_to_signed_rad(angle32_from_rad(angle));
 }
 
 [[nodiscard]] inline AlphaBeta clarke(const PhaseCurrents& i) noexcept {
@@ -12,4 +12,19 @@ struct LowPassState {
 float lowpass_update(
     LowPassState& state,
     const LowPassConfig& cfg,
-    float x) noexcept;
\ No newline at end of file
+    float x) noexcept;
+
+// alpha clamped to [0, 1] once by lowpass_plan_build instead of per sample.
+struct LowPassPlan {
+    float alpha;
+};
+
+// Always fills plan; returns false when alpha is outside [0, 1].
+bool lowpass_plan_build(
+    LowPassPlan& plan,
+    const LowPassConfig& cfg) noexcept;
+
+float lowpass_plan_update(
+    LowPassState& state,
+    const LowPassPlan& plan,
+    float x) noexcept;
@@ -2,6 +2,18 @@
 
 #include "foc_math.hpp"
 
+enum class ModulationMode {
+    Svpwm,
+    Dpwm60,
+    Dpwm120High,
+    Dpwm120Low,
+    Overmod,
+};
+
+struct ModulationConfig {
+    ModulationMode mode;
+};
+
 struct ModulationInput {
     AlphaBeta v_ab;
     float v_bus;
@@ -14,4 +26,26 @@ struct ModulationOutput {
     bool saturated;
 };
 
-ModulationOutput run_modulation(const ModulationInput& in) noexcept;
\ No newline at end of file
+ModulationOutput run_modulation(const ModulationInput& in) noexcept;
+
+ModulationOutput run_modulation(
+    const ModulationConfig& cfg,
+    const ModulationInput& in) noexcept;
+
+// Bus-dependent scale for run_modulator. modulator_set_vbus only recomputes
+// the reciprocal when the reading changes, keeping divisions off the
+// per-tick path.
+struct ModulatorState {
+    float v_bus;
+    float inv_half_vbus;
+};
+
+void modulator_set_vbus(ModulatorState& state, float v_bus) noexcept;
+
+// Same duties as run_modulation, computed straight from alpha-beta: the
+// sector picks the max and min phases from a table instead of an inverse
+// Clarke followed by a min/max search.
+ModulationOutput run_modulator(
+    const ModulatorState& state,
+    const ModulationConfig& cfg,
+    const AlphaBeta& v_ab) noexcept;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+struct MultirateConfig {
+    uint16_t spd_div;
+    uint16_t pos_div;
+    uint16_t phase;
+};
+
+// Counters hold ticks-to-go plus one, so a zeroed state reads as not
+// started and needs no separate flag.
+struct MultirateState {
+    uint16_t spd_count;
+    uint16_t pos_count;
+    float w_cmd;
+    float iq_cmd;
+};
+
+// spd_hold / pos_hold mark a firing that only a restart caused: the loop
+// should produce a fresh output from its state but not step its integral,
+// since its next on-grid slot integrates a full period anyway.
+struct MultirateDue {
+    bool est;
+    bool spd;
+    bool pos;
+    bool spd_hold;
+    bool pos_hold;
+};
+
+[[nodiscard]] inline uint16_t multirate_div(uint16_t div) noexcept {
+    return div == 0 ? 1 : div;
+}
+
+[[nodiscard]] inline uint16_t multirate_stagger_phase(
+    int axis,
+    int n_axes,
+    uint16_t div) noexcept
+{
+    if (n_axes <= 0) {
+        return 0;
+    }
+    return static_cast<uint16_t>((axis * multirate_div(div)) / n_axes % multirate_div(div));
+}
+
+MultirateDue multirate_tick(
+    MultirateState& state,
+    const MultirateConfig& cfg,
+    bool restart) noexcept;
@@ -1,5 +1,101 @@
 #pragma once
 
+#include <cstdint>
+
+// Clamp only bounds the integral by the PI's own output limits. The other
+// two also react to limits applied downstream, via pi_antiwindup.
+enum class AntiWindup : uint8_t {
+    Clamp,
+    BackCalculation,
+    Conditional,
+};
+
+struct PIConfig {
+    float kp;
+    float ki;
+    float out_min;
+    float out_max;
+    AntiWindup aw;
+    float kb;
+};
+
+struct PIState {
+    float integral;
+};
+
+float pi_update(
+    PIState& state,
+    const PIConfig& cfg,
+    float error,
+    float dt) noexcept;
+
+// Two-degree-of-freedom form: the proportional term acts on err_p and the
+// integral on err_i, so setpoint weighting only reshapes the P path.
+float pi_update_2dof(
+    PIState& state,
+    const PIConfig& cfg,
+    float err_p,
+    float err_i,
+    float dt) noexcept;
+
+// Feeds back the output that was actually applied after pi_update returned
+// u. BackCalculation bleeds the difference into the integral at rate kb
+// (ki / kp when kb is 0); Conditional undoes this tick's integration when
+// the output is limited and the error pushes further into the limit.
+void pi_antiwindup(
+    PIState& state,
+    const PIConfig& cfg,
+    float error,
+    float u,
+    float u_applied,
+    float dt) noexcept;
+
+// Sets the integral so the next pi_update with this error returns u.
+void pi_preload(
+    PIState& state,
+    const PIConfig& cfg,
+    float u,
+    float error,
+    float dt) noexcept;
+
+// PIConfig resolved for one fixed dt by pi_plan_build: the integral and
+// back-calculation gains come pre-scaled by dt, and kb's default is filled
+// in, so a step is multiply-adds and clamps.
+struct PIPlan {
+    float kp;
+    float ki_dt;
+    float out_min;
+    float out_max;
+    AntiWindup aw;
+    float kb_dt;
+};
+
+// Always fills plan; returns false for negative or non-finite gains,
+// out_min > out_max or dt <= 0.
+bool pi_plan_build(
+    PIPlan& plan,
+    const PIConfig& cfg,
+    float dt) noexcept;
+
+float pi_plan_update_2dof(
+    PIState& state,
+    const PIPlan& plan,
+    float err_p,
+    float err_i) noexcept;
+
+void pi_plan_antiwindup(
+    PIState& state,
+    const PIPlan& plan,
+    float error,
+    float u,
+    float u_applied) noexcept;
+
+void pi_plan_preload(
+    PIState& state,
+    const PIPlan& plan,
+    float u,
+    float error) noexcept;
+
 struct PI {
     float kp;
     float ki;
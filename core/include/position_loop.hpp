@@ -1,27 +1,51 @@
 #pragma once
 
+#include "angle.hpp"
 #include "pi.hpp"
 
 struct PositionLoopConfig {
     float w_min;
     float w_max;
+    PIConfig pos_pi;
+    float kff_vel;  // share of the reference velocity fed forward; 1 = full
 };
 
 struct PositionLoopState {
-    PI pos_pi;
+    PIState pos_pi;
 };
 
 struct PositionLoopInput {
-    float theta_meas;
-    float theta_setpoint;
+    Position64 theta_meas;
+    Position64 theta_setpoint;
+    float w_ff;
 };
 
 struct PositionLoopOutput {
     float w_cmd;
+    float w_unsat;
+    float err;
 };
 
 PositionLoopOutput run_position_loop(
     PositionLoopState& state,
     const PositionLoopConfig& cfg,
     const PositionLoopInput& in,
-    float dt) noexcept;
\ No newline at end of file
+    float dt) noexcept;
+
+struct PositionLoopPlan {
+    float w_min;
+    float w_max;
+    PIPlan pos_pi;
+    float kff_vel;
+};
+
+// Always fills plan; returns false if the PI or the output range is invalid.
+bool position_loop_plan_build(
+    PositionLoopPlan& plan,
+    const PositionLoopConfig& cfg,
+    float dt) noexcept;
+
+PositionLoopOutput run_position_loop_plan(
+    PositionLoopState& state,
+    const PositionLoopPlan& plan,
+    const PositionLoopInput& in) noexcept;
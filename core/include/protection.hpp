@@ -0,0 +1,68 @@
+#pragma once
+
+#include "foc_math.hpp"
+
+#include <cstdint>
+
+// Fault bits, latched in ProtectionState::faults until cleared.
+constexpr uint8_t axis_fault_overcurrent = 1u << 0;  // any phase above i_phase_max
+constexpr uint8_t axis_fault_i2t = 1u << 1;          // winding heating budget spent
+constexpr uint8_t axis_fault_following = 1u << 2;    // position error outside window
+constexpr uint8_t axis_fault_stall = 1u << 3;        // torque without motion
+constexpr uint8_t axis_fault_overspeed = 1u << 4;
+
+// A zero threshold turns its check off, so a zeroed config protects
+// nothing.
+struct ProtectionConfig {
+    float i_phase_max;      // A, instantaneous per phase
+    float i_rated;          // A, continuous current the I2t model allows
+    float i2t_limit;        // A^2*s above i_rated before tripping
+    float follow_err_max;   // rad, Position mode only
+    float stall_iq;         // A, torque current that should be moving the axis
+    float stall_w;          // rad/s, below this counts as not moving
+    float stall_time;       // s
+    float w_max;            // rad/s, overspeed
+};
+
+// Disabled checks get infinite thresholds, so every check is evaluated
+// every tick without branching on whether it is enabled.
+struct ProtectionPlan {
+    float i_phase_max;
+    float i_rated_sq;
+    float i2t_limit;
+    float follow_err_max;
+    float stall_iq;
+    float stall_w;
+    uint32_t stall_ticks;
+    float w_max;
+    float dt;
+};
+
+struct ProtectionState {
+    float i2t;              // A^2*s accumulated above i_rated
+    uint32_t stall_ticks;
+    uint8_t faults;         // latched
+};
+
+struct ProtectionInput {
+    PhaseCurrents i_abc;
+    float w_meas;
+    float iq_cmd;
+    float follow_err;       // rad; 0 outside Position mode
+};
+
+// Always fills plan; returns false for negative thresholds or an I2t model
+// without a budget.
+bool protection_plan_build(
+    ProtectionPlan& plan,
+    const ProtectionConfig& cfg,
+    float dt) noexcept;
+
+// Runs every check, latches what tripped and returns the latched faults.
+uint8_t run_protection_plan(
+    ProtectionState& state,
+    const ProtectionPlan& plan,
+    const ProtectionInput& in) noexcept;
+
+// Clears the latch. The I2t budget is kept, so a hot winding trips again.
+void protection_clear(ProtectionState& state) noexcept;
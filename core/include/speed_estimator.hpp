@@ -1,29 +1,95 @@
 #pragma once
 
+#include "angle.hpp"
 #include "lowpass.hpp"
 
+#include <cstdint>
+
+enum class SpeedEstimatorKind : uint8_t {
+    LowPass,    // finite difference through a first-order filter
+    Kalman,     // steady-state Kalman filter on position, speed and load torque
+};
+
+// Rotor model for kalman_build, w' = (kt * iq - B * w - tau_load) / J, with
+// the load torque a random walk. Noise terms are standard deviations per
+// estimator step.
+struct KalmanModel {
+    float J;
+    float B;
+    float kt;
+    float q_w;      // rad/s, unmodelled torque
+    float q_tau;    // N*m, load torque drift
+    float r_theta;  // rad, position measurement
+};
+
+// Built by kalman_build for one step length: the discrete model and the
+// converged gain, so a step is a handful of multiply-adds. The step length
+// is fixed here; the dt passed to run_speed_estimator only gates it.
+struct KalmanConfig {
+    float dt;
+    float a_ww;     // 1 - B * dt / J
+    float a_wtau;   // -dt / J
+    float b_iq;     // kt * dt / J
+    float l_theta;
+    float l_w;
+    float l_tau;
+};
+
 struct SpeedEstimatorConfig {
     LowPassConfig lp;
+    SpeedEstimatorKind kind;
+    KalmanConfig kf;
 };
 
+// lp.initialized doubles as the estimator's own first-sample flag. Only
+// the angle within the turn is kept: consecutive samples are less than half
+// a turn apart, so the low word of the multi-turn position is enough.
+// The Kalman filter keeps its position estimate in theta_prev and its speed
+// estimate in lp.y, so readers of lp.y need not know which one runs.
 struct SpeedEstimatorState {
-    float theta_prev;
-    float w_raw;
+    Angle32 theta_prev;
     LowPassState lp;
-    bool initialized;
+    float tau_load;
 };
 
 struct SpeedEstimatorInput {
-    float theta_meas;
+    Position64 theta_meas;
+    float iq;               // torque current measured over the last step; Kalman only
 };
 
 struct SpeedEstimatorOutput {
     float w_raw;
     float w_filtered;
+    float tau_load;         // Kalman only
 };
 
+bool kalman_build(
+    KalmanConfig& cfg,
+    const KalmanModel& model,
+    float dt) noexcept;
+
 SpeedEstimatorOutput run_speed_estimator(
     SpeedEstimatorState& state,
     const SpeedEstimatorConfig& cfg,
     const SpeedEstimatorInput& in,
-    float dt) noexcept;
\ No newline at end of file
+    float dt) noexcept;
+
+// SpeedEstimatorConfig resolved for the estimator's step length.
+struct SpeedEstimatorPlan {
+    LowPassPlan lp;
+    SpeedEstimatorKind kind;
+    KalmanConfig kf;
+    float dt;
+};
+
+// Always fills plan; returns false for dt <= 0, an invalid filter, or a
+// Kalman gain built for a different step length.
+bool speed_estimator_plan_build(
+    SpeedEstimatorPlan& plan,
+    const SpeedEstimatorConfig& cfg,
+    float dt) noexcept;
+
+SpeedEstimatorOutput run_speed_estimator_plan(
+    SpeedEstimatorState& state,
+    const SpeedEstimatorPlan& plan,
+    const SpeedEstimatorInput& in) noexcept;
\ No newline at end of file
@@ -5,23 +5,48 @@
 struct SpeedLoopConfig {
     float iq_min;
     float iq_max;
+    PIConfig iq_pi;
+    float kff_acc;  // A per rad/s^2 of reference acceleration, ideally J / Kt
+    float b_cut;    // setpoint weight on the P term is 1 - b_cut; 0 = plain PI
 };
 
 struct SpeedLoopState {
-    PI iq_pi;
+    PIState iq_pi;
 };
 
 struct SpeedLoopInput {
     float w_meas;
     float w_setpoint;
+    float acc_ff;
 };
 
 struct SpeedLoopOutput {
     float iq_cmd;
+    float iq_unsat;
+    float err;
 };
 
 SpeedLoopOutput run_speed_loop(
     SpeedLoopState& state,
     const SpeedLoopConfig& cfg,
     const SpeedLoopInput& in,
-    float dt) noexcept;
\ No newline at end of file
+    float dt) noexcept;
+
+struct SpeedLoopPlan {
+    float iq_min;
+    float iq_max;
+    PIPlan iq_pi;
+    float kff_acc;
+    float b_cut;
+};
+
+// Always fills plan; returns false if the PI or the output range is invalid.
+bool speed_loop_plan_build(
+    SpeedLoopPlan& plan,
+    const SpeedLoopConfig& cfg,
+    float dt) noexcept;
+
+SpeedLoopOutput run_speed_loop_plan(
+    SpeedLoopState& state,
+    const SpeedLoopPlan& plan,
+    const SpeedLoopInput& in) noexcept;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "foc_math.hpp"
+
+// First-order winding model driven by the measured phase currents: the
+// copper loss 1.5 * Rs(T) * |i|^2 heats one lumped node that leaks to
+// ambient through r_th. The estimate scales the iq limits down linearly
+// from t_derate to zero at t_max. Temperatures are degC; a zeroed config
+// estimates and derates nothing.
+struct ThermalEstimatorConfig {
+    float rs;           // ohm, winding resistance at t_ambient
+    float alpha_cu;     // 1/K, copper resistance coefficient (about 0.0039)
+    float r_th;         // K/W, winding to ambient
+    float tau;          // s, winding thermal time constant
+    float t_ambient;
+    float t_derate;     // iq limits start falling; 0 = no derating
+    float t_max;        // iq limits reach zero
+};
+
+// The derate line is resolved to scale = 1 - (rise - rise_derate) * inv_span,
+// with inv_span = 0 when derating is off.
+struct ThermalEstimatorPlan {
+    float k;            // dt / tau, at most 1
+    float rs;
+    float alpha_cu;
+    float r_th;
+    float t_ambient;
+    float rise_derate;
+    float inv_span;
+};
+
+struct ThermalEstimatorState {
+    float rise;         // K above ambient, so a zeroed state starts cold
+};
+
+struct ThermalEstimatorOutput {
+    float t_winding;
+    float iq_scale;     // 0..1, applied to both iq limits
+};
+
+// Always fills plan; returns false for negative parameters, a model
+// without tau or r_th, or t_max not above t_derate when derating is on.
+bool thermal_estimator_plan_build(
+    ThermalEstimatorPlan& plan,
+    const ThermalEstimatorConfig& cfg,
+    float dt) noexcept;
+
+ThermalEstimatorOutput run_thermal_estimator_plan(
+    ThermalEstimatorState& state,
+    const ThermalEstimatorPlan& plan,
+    const PhaseCurrents& i_abc) noexcept;
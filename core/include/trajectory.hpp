@@ -1,26 +1,53 @@
 #pragma once
 
+#include "angle.hpp"
+
 struct TrajConfig {
     float max_vel;
     float max_acc;
 };
 
 struct TrajState {
-    float pos;
+    Position64 pos;
     float vel;
+    float acc;
 };
 
 struct TrajInput {
-    float target_pos;
+    Position64 target_pos;
 };
 
 struct TrajOutput {
-    float pos_ref;
+    Position64 pos_ref;
     float vel_ref;
+    float acc_ref;
 };
 
 TrajOutput run_traj_step(
     TrajState& state,
     const TrajConfig& cfg,
     const TrajInput& in,
-    float dt) noexcept;
\ No newline at end of file
+    float dt) noexcept;
+
+// TrajConfig and dt resolved by traj_plan_build: the stopping-distance and
+// acceleration divisions become multiplies.
+struct TrajPlan {
+    float max_vel;
+    float max_acc;
+    float half_inv_acc;  // 0.5 / max_acc
+    float dt;
+    float inv_dt;
+    bool enabled;        // both limits positive; otherwise the profile holds
+};
+
+// Always fills plan; returns false for dt <= 0 or negative or non-finite
+// limits. Zero limits are accepted and leave the profile holding.
+bool traj_plan_build(
+    TrajPlan& plan,
+    const TrajConfig& cfg,
+    float dt) noexcept;
+
+TrajOutput run_traj_plan(
+    TrajState& state,
+    const TrajPlan& plan,
+    const TrajInput& in) noexcept;
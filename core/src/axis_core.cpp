@@ -1,87 +1,328 @@
 #include "axis_core.hpp"
 #include "foc_math.hpp"
 
-AxisCoreOutput run_axis_core(
+// On a mode change the loops that take over are preloaded so their first
+// output equals the command the plant last saw: rate.iq_cmd / rate.w_cmd
+// track the applied iq and speed commands in every mode for this.
+static void bumpless_transfer(
     AxisCoreState& state,
-    const AxisCoreConfig& cfg,
+    const AxisCorePlan& plan,
     const AxisCoreInput& in,
+    AxisMode from,
+    float w_meas) noexcept
+{
+    if (from == AxisMode::Idle) {
+        state.foc.loop.id.integral = 0.0f;
+        state.foc.loop.iq.integral = 0.0f;
+    }
+
+    switch (in.mode) {
+    case AxisMode::Velocity:
+        pi_plan_preload(state.spd.iq_pi, plan.spd.iq_pi, state.rate.iq_cmd,
+                        in.w_target - w_meas);
+        break;
+
+    case AxisMode::Position: {
+        float w_prev = from == AxisMode::Velocity ? state.rate.w_cmd : w_meas;
+        state.traj.pos = in.theta_meas;
+        state.traj.vel = clamp(w_prev, -plan.traj.max_vel, plan.traj.max_vel);
+        state.traj.acc = 0.0f;
+        pi_plan_preload(state.pos.pos_pi, plan.pos.pos_pi, w_prev, 0.0f);
+        pi_plan_preload(state.spd.iq_pi, plan.spd.iq_pi, state.rate.iq_cmd,
+                        w_prev - w_meas);
+    } break;
+
+    default:
+        break;
+    }
+}
+
+// Anti-windup for limits applied after a loop returned; the loop already
+// handled its own clamp, so Conditional must not retract a second time.
+static void downstream_antiwindup(
+    PIState& state,
+    const PIPlan& plan,
+    float err,
+    float u_unsat,
+    float u_loop,
+    float u_applied) noexcept
+{
+    if (plan.aw == AntiWindup::Conditional && u_loop != u_unsat) {
+        return;
+    }
+    pi_plan_antiwindup(state, plan, err, u_loop, u_applied);
+}
+
+// A restart between multirate slots fires the outer loops from their
+// (preloaded) state without stepping the integrals, so the next slot's
+// full-period step is the only one for that period.
+static void hold_pi(PIPlan& plan) noexcept
+{
+    plan.ki_dt = 0.0f;
+    plan.kb_dt = 0.0f;
+}
+
+static float run_speed_stage(
+    AxisCoreState& state,
+    const AxisCorePlan& plan,
+    const LimitsConfig& lim,
+    const SpeedLoopInput& in,
+    bool hold) noexcept
+{
+    SpeedLoopPlan held;
+    const SpeedLoopPlan* spd = &plan.spd;
+    if (hold) {
+        held = plan.spd;
+        hold_pi(held.iq_pi);
+        spd = &held;
+    }
+
+    SpeedLoopOutput out = run_speed_loop_plan(state.spd, *spd, in);
+    downstream_antiwindup(state.spd.iq_pi, spd->iq_pi, out.err, out.iq_unsat,
+                          out.iq_cmd, clamp(out.iq_cmd, lim.iq_min, lim.iq_max));
+    return out.iq_cmd;
+}
+
+bool compile_axis_config(
+    AxisCorePlan& plan,
+    const AxisCoreConfig& cfg,
     float dt) noexcept
+{
+    plan.dt = dt;
+    plan.dt_spd = dt * multirate_div(cfg.rate.spd_div);
+    plan.dt_pos = dt * multirate_div(cfg.rate.pos_div);
+    plan.lim = cfg.lim;
+    plan.mod = cfg.mod;
+    plan.rate = cfg.rate;
+    plan.bumpless = cfg.bumpless;
+
+    bool ok = dt > 0.0f;
+    ok = traj_plan_build(plan.traj, cfg.traj, plan.dt_pos) && ok;
+    ok = position_loop_plan_build(plan.pos, cfg.pos, plan.dt_pos) && ok;
+    ok = speed_loop_plan_build(plan.spd, cfg.spd, plan.dt_spd) && ok;
+    ok = foc_plan_build(plan.foc, cfg.foc, dt) && ok;
+    ok = speed_estimator_plan_build(plan.est, cfg.est, plan.dt_spd) && ok;
+    ok = deadtime_comp_plan_build(plan.dtc, cfg.dtc) && ok;
+    ok = protection_plan_build(plan.prot, cfg.prot, dt) && ok;
+    ok = thermal_estimator_plan_build(plan.thermal, cfg.thermal, dt) && ok;
+    ok = current_sense_plan_build(plan.sense, cfg.sense) && ok;
+    ok = ok && cfg.lim.iq_min <= cfg.lim.iq_max && cfg.lim.w_min <= cfg.lim.w_max;
+    return ok;
+}
+
+static void run_estimator_stage(
+    AxisCoreState& state,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in,
+    const PhaseCurrents& i_abc) noexcept
+{
+    // The Kalman model is driven by the measured torque current, so a
+    // current loop that lags or saturates does not show up as load. The
+    // transform is only paid for when the Kalman filter runs.
+    float iq_meas = 0.0f;
+    if (plan.est.kind == SpeedEstimatorKind::Kalman) {
+        iq_meas = park(clarke(i_abc), in.theta_elec).q;
+    }
+    SpeedEstimatorInput est_in{in.theta_meas, iq_meas};
+    run_speed_estimator_plan(state.est, plan.est, est_in);
+}
+
+// The gates stay off (pwm_enable is left false); the next running tick
+// re-enters its mode from Idle. The speed estimate keeps running on its
+// grid meanwhile: overspeed is checked against it, so a frozen value could
+// never clear, and a stale theta_prev would turn the first difference
+// after the hold into a speed spike.
+static void hold_idle(
+    AxisCoreState& state,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in,
+    const PhaseCurrents& i_abc) noexcept
+{
+    state.mode_prev = AxisMode::Idle;
+    state.rate.iq_cmd = 0.0f;
+    state.rate.w_cmd = 0.0f;
+    if (multirate_tick(state.rate, plan.rate, false).est) {
+        run_estimator_stage(state, plan, in, i_abc);
+    }
+}
+
+static AxisCoreOutput axis_tick(
+    AxisCoreState& state,
+    AxisGuardState* guard,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in) noexcept
 {
     AxisCoreOutput out{};
     out.status = AxisCoreStatus{false, false};
+    out.status.iq_scale = 1.0f;
+    out.status.t_winding = plan.thermal.t_ambient;
+
+    if (plan.dt <= 0.0f) {
+        return out;
+    }
+
+    LimitsConfig lim = plan.lim;
+
+    PhaseCurrents i_abc;
+    if (guard != nullptr) {
+        // The gates are off for the whole offset window, but the checks
+        // below still run on every tick of it: on the readings with gain
+        // correction only, as the offsets are not known until it closes.
+        bool calibrating = current_sense_calibrating(guard->sense, plan.sense);
+        if (calibrating) {
+            current_sense_calibrate(guard->sense, plan.sense, in.i_abc);
+            i_abc = current_sense_correct(CurrentSenseState{}, plan.sense, in.i_abc);
+        } else {
+            i_abc = current_sense_correct(guard->sense, plan.sense, in.i_abc);
+        }
+        out.status.calibrating = calibrating;
+
+        if (in.fault_reset) {
+            protection_clear(guard->prot);
+        }
+        // The reference is last tick's, so the window is only checked once
+        // the profile has been running from the measurement for a tick.
+        bool tracking = in.mode == AxisMode::Position && state.mode_prev == AxisMode::Position;
+        float follow_err = position64_delta_rad(state.traj.pos, in.theta_meas);
+        ProtectionInput prot_in{i_abc, state.est.lp.y, state.rate.iq_cmd,
+                                tracking ? follow_err : 0.0f};
+        out.status.faults = run_protection_plan(guard->prot, plan.prot, prot_in);
+
+        // Runs while faulted too, so the estimate cools with the winding.
+        ThermalEstimatorOutput th = run_thermal_estimator_plan(guard->thermal, plan.thermal, i_abc);
+        lim.iq_min *= th.iq_scale;
+        lim.iq_max *= th.iq_scale;
+        out.status.iq_scale = th.iq_scale;
+        out.status.t_winding = th.t_winding;
+
+        if (calibrating || out.status.faults != 0) {
+            hold_idle(state, plan, in, i_abc);
+            return out;
+        }
+    } else {
+        i_abc = current_sense_correct(CurrentSenseState{}, plan.sense, in.i_abc);
+    }
 
-    if (in.v_bus <= 0.0f || dt <= 0.0f) {
+    if (in.v_bus <= 0.0f) {
         return out;
     }
 
-    SpeedEstimatorInput est_in{in.theta_meas};
-    SpeedEstimatorOutput est_out =
-        run_speed_estimator(state.est, cfg.est, est_in, dt);
+    bool restart = in.mode != state.mode_prev;
+    AxisMode mode_from = state.mode_prev;
+    state.mode_prev = in.mode;
+
+    MultirateDue due = multirate_tick(state.rate, plan.rate, restart);
+
+    if (due.est) {
+        run_estimator_stage(state, plan, in, i_abc);
+    }
+
+    // Between estimator runs the filter output is the held measurement.
+    float w_meas = state.est.lp.y;
 
-    float w_meas = est_out.w_filtered;
+    if (restart && plan.bumpless) {
+        bumpless_transfer(state, plan, in, mode_from, w_meas);
+    }
 
     state.lim.iq_limited = false;
-    state.lim.w_limited = false;
+    if (due.pos) {
+        state.lim.w_limited = false;
+    }
 
-    float theta_ref = in.theta_target;
+    Position64 theta_ref = in.theta_target;
     float w_cmd = 0.0f;
     float iq_cmd = 0.0f;
 
     switch (in.mode) {
     case AxisMode::Idle:
+        state.rate.iq_cmd = 0.0f;
+        state.rate.w_cmd = 0.0f;
         return out;
 
     case AxisMode::CurrentIq:
         iq_cmd = in.iq_target;
+        state.rate.iq_cmd = iq_cmd;
+        state.rate.w_cmd = w_meas;
         break;
 
     case AxisMode::Velocity: {
-        SpeedLoopInput spd_in{w_meas, in.w_target};
-        SpeedLoopOutput spd_out = run_speed_loop(state.spd, cfg.spd, spd_in, dt);
-        iq_cmd = spd_out.iq_cmd;
+        if (due.spd) {
+            SpeedLoopInput spd_in{w_meas, in.w_target, 0.0f};
+            state.rate.iq_cmd = run_speed_stage(state, plan, lim, spd_in, due.spd_hold);
+        }
+        iq_cmd = state.rate.iq_cmd;
         w_cmd = in.w_target;
+        state.rate.w_cmd = w_cmd;
     } break;
 
     case AxisMode::Position: {
-        TrajInput traj_in{in.theta_target};
-        TrajOutput traj_out = run_traj_step(state.traj, cfg.traj, traj_in, dt);
-        theta_ref = traj_out.pos_ref;
+        if (due.pos) {
+            // A hold evaluates the loop at the profile's current point
+            // instead of advancing it a period early.
+            TrajOutput traj_out{state.traj.pos, state.traj.vel, state.traj.acc};
+            if (!due.pos_hold) {
+                TrajInput traj_in{in.theta_target};
+                traj_out = run_traj_plan(state.traj, plan.traj, traj_in);
+            }
 
-        PositionLoopInput pos_in{in.theta_meas, theta_ref};
-        PositionLoopOutput pos_out = run_position_loop(state.pos, cfg.pos, pos_in, dt);
-        w_cmd = pos_out.w_cmd;
+            PositionLoopPlan pos_held;
+            const PositionLoopPlan* pos_plan = &plan.pos;
+            if (due.pos_hold) {
+                pos_held = plan.pos;
+                hold_pi(pos_held.pos_pi);
+                pos_plan = &pos_held;
+            }
 
-        w_cmd = apply_vel_limit(state.lim, cfg.lim, w_cmd);
+            PositionLoopInput pos_in{in.theta_meas, traj_out.pos_ref, traj_out.vel_ref};
+            PositionLoopOutput pos_out = run_position_loop_plan(state.pos, *pos_plan, pos_in);
+            state.rate.w_cmd = apply_vel_limit(state.lim, lim, pos_out.w_cmd);
+            downstream_antiwindup(state.pos.pos_pi, pos_plan->pos_pi, pos_out.err, pos_out.w_unsat,
+                                  pos_out.w_cmd, state.rate.w_cmd);
+        }
+        theta_ref = state.traj.pos;
+        w_cmd = state.rate.w_cmd;
 
-        SpeedLoopInput spd_in{w_meas, w_cmd};
-        SpeedLoopOutput spd_out = run_speed_loop(state.spd, cfg.spd, spd_in, dt);
-        iq_cmd = spd_out.iq_cmd;
+        if (due.spd) {
+            SpeedLoopInput spd_in{w_meas, w_cmd, state.traj.acc};
+            state.rate.iq_cmd = run_speed_stage(state, plan, lim, spd_in, due.spd_hold);
+        }
+        iq_cmd = state.rate.iq_cmd;
     } break;
 
     default:
         return out;
     }
 
-    iq_cmd = apply_iq_limit(state.lim, cfg.lim, iq_cmd);
+    iq_cmd = apply_iq_limit(state.lim, lim, iq_cmd);
 
     FocInput foc_in{};
-    foc_in.i_abc = in.i_abc;
+    foc_in.i_abc = i_abc;
     foc_in.theta_elec = in.theta_elec;
     foc_in.i_setpoint = {0.0f, iq_cmd};
     foc_in.v_bus = in.v_bus;
 
-    FocOutput foc_out =
-        run_foc(state.foc, cfg.foc, foc_in, dt);
+    FocOutput foc_out = run_foc_plan(state.foc, plan.foc, foc_in);
+
+    // The bus scale is cached on the guard line and only recomputed when
+    // the reading changes; an unguarded tick has nowhere to keep it.
+    ModulatorState mod_local{};
+    ModulatorState& mod = guard != nullptr ? guard->mod : mod_local;
+    modulator_set_vbus(mod, in.v_bus);
+    ModulationOutput mod_out = run_modulator(mod, plan.mod, foc_out.v_ab);
 
-    ModulationInput mod_in{};
-    mod_in.v_ab = foc_out.v_ab;
-    mod_in.v_bus = in.v_bus;
+    DeadtimeCompInput dtc_in{};
+    dtc_in.m_a = mod_out.m_a;
+    dtc_in.m_b = mod_out.m_b;
+    dtc_in.m_c = mod_out.m_c;
+    dtc_in.i_abc = i_abc;
+    dtc_in.v_bus = in.v_bus;
 
-    ModulationOutput mod_out = run_modulation(mod_in);
+    DeadtimeCompOutput dtc_out = run_deadtime_comp_plan(plan.dtc, dtc_in, mod.inv_half_vbus);
 
-    out.m_a = mod_out.m_a;
-    out.m_b = mod_out.m_b;
-    out.m_c = mod_out.m_c;
+    out.pwm_enable = true;
+    out.m_a = dtc_out.m_a;
+    out.m_b = dtc_out.m_b;
+    out.m_c = dtc_out.m_c;
     out.i_dq = foc_out.i_dq;
     out.iq_cmd = iq_cmd;
     out.w_cmd = w_cmd;
@@ -92,3 +333,43 @@ AxisCoreOutput run_axis_core(
 
     return out;
 }
+
+AxisCoreOutput run_axis_plan(
+    AxisCoreState& state,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in) noexcept
+{
+    return axis_tick(state, nullptr, plan, in);
+}
+
+AxisCoreOutput run_axis_plan(
+    AxisCoreState& state,
+    AxisGuardState& guard,
+    const AxisCorePlan& plan,
+    const AxisCoreInput& in) noexcept
+{
+    return axis_tick(state, &guard, plan, in);
+}
+
+AxisCoreOutput run_axis_core(
+    AxisCoreState& state,
+    const AxisCoreConfig& cfg,
+    const AxisCoreInput& in,
+    float dt) noexcept
+{
+    AxisCorePlan plan;
+    compile_axis_config(plan, cfg, dt);
+    return run_axis_plan(state, plan, in);
+}
+
+AxisCoreOutput run_axis_core(
+    AxisCoreState& state,
+    AxisGuardState& guard,
+    const AxisCoreConfig& cfg,
+    const AxisCoreInput& in,
+    float dt) noexcept
+{
+    AxisCorePlan plan;
+    compile_axis_config(plan, cfg, dt);
+    return run_axis_plan(state, guard, plan, in);
+}
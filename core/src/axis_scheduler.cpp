@@ -0,0 +1,119 @@
+#include "axis_scheduler.hpp"
+
+static int gcd_int(int a, int b) noexcept {
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static float outer_ns_at(const SchedAxisLoad& axis, uint16_t phase, int slot) noexcept {
+    int spd_div = multirate_div(axis.spd_div);
+    int pos_div = multirate_div(axis.pos_div);
+
+    float ns = 0.0f;
+    if ((slot - phase % spd_div + spd_div) % spd_div == 0) ns += axis.spd_ns;
+    if ((slot - phase % pos_div + pos_div) % pos_div == 0) ns += axis.pos_ns;
+    return ns;
+}
+
+static float outer_ns(const SchedAxisLoad& axis) noexcept {
+    return axis.spd_ns / multirate_div(axis.spd_div)
+         + axis.pos_ns / multirate_div(axis.pos_div);
+}
+
+// Longest-processing-time first: the axis with the heaviest average
+// outer-loop cost is placed first, at the phase that keeps the worst slot
+// of the hyperperiod lowest (ties go to the lighter total). Every-tick
+// work lands in all slots and only shifts the result. Runs once at
+// configuration time; the cost is O(n^2 + n * div * slots).
+bool plan_axis_schedule(
+    const SchedAxisLoad* axes,
+    int n_axes,
+    const SchedConfig& cfg,
+    uint16_t* phases,
+    SchedReport& report) noexcept
+{
+    report = SchedReport{};
+
+    int hyper = 1;
+    for (int a = 0; a < n_axes; ++a) {
+        int spd_div = multirate_div(axes[a].spd_div);
+        int pos_div = multirate_div(axes[a].pos_div);
+        hyper = hyper / gcd_int(hyper, spd_div) * spd_div;
+        if (hyper > sched_max_slots) break;
+        hyper = hyper / gcd_int(hyper, pos_div) * pos_div;
+        if (hyper > sched_max_slots) break;
+    }
+
+    if (hyper > sched_max_slots) {
+        report.hyperperiod_ok = false;
+        report.deadline_met = false;
+        return false;
+    }
+
+    report.n_slots = hyper;
+    report.hyperperiod_ok = true;
+
+    constexpr uint16_t unassigned = 0xFFFF;
+    float tick_ns = 0.0f;
+    for (int a = 0; a < n_axes; ++a) {
+        phases[a] = unassigned;
+        tick_ns += axes[a].tick_ns;
+    }
+
+    for (int placed = 0; placed < n_axes; ++placed) {
+        int pick = -1;
+        for (int a = 0; a < n_axes; ++a) {
+            if (phases[a] == unassigned
+                && (pick < 0 || outer_ns(axes[a]) > outer_ns(axes[pick]))) {
+                pick = a;
+            }
+        }
+
+        const SchedAxisLoad& axis = axes[pick];
+        int span = multirate_div(axis.spd_div);
+        if (multirate_div(axis.pos_div) > span) span = multirate_div(axis.pos_div);
+
+        uint16_t best_phase = 0;
+        float best_worst = 0.0f;
+        float best_sum = 0.0f;
+        for (int ph = 0; ph < span; ++ph) {
+            float worst = 0.0f;
+            float sum = 0.0f;
+            for (int s = 0; s < hyper; ++s) {
+                float ns = report.slot_ns[s] + outer_ns_at(axis, static_cast<uint16_t>(ph), s);
+                if (ns > worst) worst = ns;
+                sum += ns * ns;
+            }
+            if (ph == 0 || worst < best_worst || (worst == best_worst && sum < best_sum)) {
+                best_phase = static_cast<uint16_t>(ph);
+                best_worst = worst;
+                best_sum = sum;
+            }
+        }
+
+        phases[pick] = best_phase;
+        for (int s = 0; s < hyper; ++s) {
+            report.slot_ns[s] += outer_ns_at(axis, best_phase, s);
+        }
+    }
+
+    float total = 0.0f;
+    for (int s = 0; s < hyper; ++s) {
+        report.slot_ns[s] += tick_ns;
+        total += report.slot_ns[s];
+        if (report.slot_ns[s] > report.worst_ns) {
+            report.worst_ns = report.slot_ns[s];
+            report.worst_slot = s;
+        }
+    }
+    report.mean_ns = total / hyper;
+
+    float budget = cfg.tick_budget_ns * (1.0f - cfg.margin);
+    report.worst_utilization = cfg.tick_budget_ns > 0.0f ? report.worst_ns / cfg.tick_budget_ns : 0.0f;
+    report.deadline_met = budget > 0.0f && report.worst_ns <= budget;
+    return report.deadline_met;
+}
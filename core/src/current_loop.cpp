@@ -5,23 +5,48 @@ CurrentLoopOutput run_current_loop(
     const CurrentLoopConfig& cfg,
     const CurrentLoopInput& in,
     float dt) noexcept
+{
+    CurrentLoopPlan plan;
+    current_loop_plan_build(plan, cfg, dt);
+    return run_current_loop_plan(state, plan, in);
+}
+
+bool current_loop_plan_build(
+    CurrentLoopPlan& plan,
+    const CurrentLoopConfig& cfg,
+    float dt) noexcept
+{
+    plan.mod_radius = cfg.mod_radius;
+    plan.enabled = cfg.mod_radius > 0.0f;
+    bool ok_d = pi_plan_build(plan.id, cfg.id, dt);
+    bool ok_q = pi_plan_build(plan.iq, cfg.iq, dt);
+    return ok_d && ok_q && plan.enabled && std::isfinite(cfg.mod_radius);
+}
+
+CurrentLoopOutput run_current_loop_plan(
+    CurrentLoopState& state,
+    const CurrentLoopPlan& plan,
+    const CurrentLoopInput& in) noexcept
 {
     CurrentLoopOutput out{};
-    if (in.v_bus <= 0.0f || cfg.mod_radius <= 0.0f) {
+    if (in.v_bus <= 0.0f || !plan.enabled) {
         out.v_dq = {0.0f, 0.0f};
         return out;
     }
 
     float err_d = in.i_setpoint.d - in.i_meas.d;
     float err_q = in.i_setpoint.q - in.i_meas.q;
-    
-    float vd = state.id.update(err_d, dt);
-    float vq = state.iq.update(err_q, dt);
+
+    float vd = pi_plan_update_2dof(state.id, plan.id, err_d, err_d);
+    float vq = pi_plan_update_2dof(state.iq, plan.iq, err_q, err_q);
 
     DQ v{vd, vq};
-    float v_limit = cfg.mod_radius * in.v_bus;
+    float v_limit = plan.mod_radius * in.v_bus;
     saturate(v, v_limit);
 
+    pi_plan_antiwindup(state.id, plan.id, err_d, vd, v.d);
+    pi_plan_antiwindup(state.iq, plan.iq, err_q, vq, v.q);
+
     out.v_dq = v;
     return out;
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#include "current_sense.hpp"
+
+static float gain(float x) noexcept
+{
+    return x != 0.0f ? x : 1.0f;
+}
+
+bool current_sense_plan_build(
+    CurrentSensePlan& plan,
+    const CurrentSenseConfig& cfg) noexcept
+{
+    plan.scale = {gain(cfg.scale.a), gain(cfg.scale.b), gain(cfg.scale.c)};
+    plan.calib_ticks = cfg.calib_ticks;
+    plan.inv_calib = cfg.calib_ticks > 0 ? 1.0f / static_cast<float>(cfg.calib_ticks) : 0.0f;
+    plan.two_shunt = cfg.two_shunt;
+
+    return cfg.scale.a >= 0.0f && cfg.scale.b >= 0.0f && cfg.scale.c >= 0.0f;
+}
+
+void current_sense_calibrate(
+    CurrentSenseState& state,
+    const CurrentSensePlan& plan,
+    const PhaseCurrents& raw) noexcept
+{
+    state.acc.a += raw.a;
+    state.acc.b += raw.b;
+    state.acc.c += raw.c;
+    ++state.calib_count;
+    if (state.calib_count == plan.calib_ticks) {
+        state.offset = {state.acc.a * plan.inv_calib,
+                        state.acc.b * plan.inv_calib,
+                        state.acc.c * plan.inv_calib};
+    }
+}
+
+PhaseCurrents current_sense_correct(
+    const CurrentSenseState& state,
+    const CurrentSensePlan& plan,
+    const PhaseCurrents& raw) noexcept
+{
+    PhaseCurrents i;
+    i.a = (raw.a - state.offset.a) * plan.scale.a;
+    i.b = (raw.b - state.offset.b) * plan.scale.b;
+    i.c = (raw.c - state.offset.c) * plan.scale.c;
+    // The unmeasured phase is whatever balances the other two.
+    i.c = plan.two_shunt ? -(i.a + i.b) : i.c;
+    return i;
+}
+
+void current_sense_recalibrate(CurrentSenseState& state) noexcept
+{
+    state = CurrentSenseState{};
+}
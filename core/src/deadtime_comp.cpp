@@ -0,0 +1,68 @@
+#include "deadtime_comp.hpp"
+
+// Ramp through i_band instead of a hard sign so the correction does not
+// chatter while the current crosses zero; a clamped leg does not switch and
+// needs none.
+static float compensate_leg(float m, float i, float dm, float inv_band) noexcept
+{
+    if (m >= 1.0f || m <= -1.0f) {
+        return m;
+    }
+
+    float s = inv_band > 0.0f ? clamp(i * inv_band, -1.0f, 1.0f) : signf(i);
+    return clamp(m + s * dm, -1.0f, 1.0f);
+}
+
+DeadtimeCompOutput run_deadtime_comp(
+    const DeadtimeCompConfig& cfg,
+    const DeadtimeCompInput& in) noexcept
+{
+    DeadtimeCompOutput out{};
+    out.m_a = in.m_a;
+    out.m_b = in.m_b;
+    out.m_c = in.m_c;
+
+    if (in.v_bus <= 0.0f || cfg.v_comp <= 0.0f) {
+        return out;
+    }
+
+    float dm = cfg.v_comp / (0.5f * in.v_bus);
+    float inv_band = cfg.i_band > 0.0f ? 1.0f / cfg.i_band : 0.0f;
+
+    out.m_a = compensate_leg(in.m_a, in.i_abc.a, dm, inv_band);
+    out.m_b = compensate_leg(in.m_b, in.i_abc.b, dm, inv_band);
+    out.m_c = compensate_leg(in.m_c, in.i_abc.c, dm, inv_band);
+    return out;
+}
+
+bool deadtime_comp_plan_build(
+    DeadtimeCompPlan& plan,
+    const DeadtimeCompConfig& cfg) noexcept
+{
+    plan.v_comp = cfg.v_comp;
+    plan.inv_band = cfg.i_band > 0.0f ? 1.0f / cfg.i_band : 0.0f;
+    return std::isfinite(cfg.v_comp) && cfg.v_comp >= 0.0f
+        && std::isfinite(cfg.i_band) && cfg.i_band >= 0.0f;
+}
+
+DeadtimeCompOutput run_deadtime_comp_plan(
+    const DeadtimeCompPlan& plan,
+    const DeadtimeCompInput& in,
+    float inv_half_vbus) noexcept
+{
+    DeadtimeCompOutput out{};
+    out.m_a = in.m_a;
+    out.m_b = in.m_b;
+    out.m_c = in.m_c;
+
+    if (in.v_bus <= 0.0f || plan.v_comp <= 0.0f) {
+        return out;
+    }
+
+    float dm = plan.v_comp * inv_half_vbus;
+
+    out.m_a = compensate_leg(in.m_a, in.i_abc.a, dm, plan.inv_band);
+    out.m_b = compensate_leg(in.m_b, in.i_abc.b, dm, plan.inv_band);
+    out.m_c = compensate_leg(in.m_c, in.i_abc.c, dm, plan.inv_band);
+    return out;
+}
@@ -0,0 +1,123 @@
+#include "encoder.hpp"
+
+bool encoder_build(
+    EncoderConfig& cfg,
+    EncoderType type,
+    uint32_t lines,
+    uint32_t pole_pairs,
+    Angle32 elec_offset,
+    float w_alpha) noexcept
+{
+    cfg = EncoderConfig{};
+    if (lines < 2 || pole_pairs == 0) {
+        return false;
+    }
+
+    const uint64_t turn = uint64_t{1} << 32;
+    cfg.type = type;
+    cfg.lines = lines;
+    cfg.pole_pairs = pole_pairs;
+    cfg.elec_offset = elec_offset;
+    cfg.w_alpha = w_alpha;
+    cfg.index_scale = static_cast<uint32_t>(turn / lines);
+    cfg.index_scale_frac = static_cast<uint32_t>(((turn % lines) << 32) / lines);
+    return true;
+}
+
+namespace {
+
+// index * 2^32 / lines to within one count.
+Angle32 index_to_angle(const EncoderConfig& cfg, uint32_t index) noexcept
+{
+    return index * cfg.index_scale
+         + static_cast<uint32_t>((static_cast<uint64_t>(index) * cfg.index_scale_frac) >> 32);
+}
+
+void advance_index(EncoderState& state, int32_t delta, uint32_t per_turn) noexcept
+{
+    int64_t idx = static_cast<int64_t>(state.index) + delta;
+    while (idx >= per_turn) {
+        idx -= per_turn;
+        ++state.turns;
+    }
+    while (idx < 0) {
+        idx += per_turn;
+        --state.turns;
+    }
+    state.index = static_cast<uint32_t>(idx);
+}
+
+Position64 incremental_position(const EncoderState& state, const EncoderConfig& cfg) noexcept
+{
+    return state.turns * position64_one_turn + index_to_angle(cfg, state.index);
+}
+
+// state.index counts quarter periods. The quadrature count fixes the period
+// and the interpolated phase the position inside it: the period is the one
+// whose quarter best agrees with the phase, so a count edge that lands a
+// little early or late against the analog signals costs nothing.
+Position64 sincos_position(const EncoderState& state, const EncoderConfig& cfg, Angle32 phase) noexcept
+{
+    int64_t quarters = static_cast<int64_t>(state.index) << 30;
+    int64_t period = (quarters - phase + (int64_t{1} << 31)) >> 32;
+    int64_t turns = state.turns;
+    if (period < 0) {
+        period += cfg.lines;
+        --turns;
+    } else if (period >= cfg.lines) {
+        period -= cfg.lines;
+        ++turns;
+    }
+
+    Angle32 fine = static_cast<Angle32>((static_cast<uint64_t>(phase) * cfg.index_scale) >> 32);
+    return turns * position64_one_turn + index_to_angle(cfg, static_cast<uint32_t>(period)) + fine;
+}
+
+} // namespace
+
+EncoderOutput run_encoder(
+    EncoderState& state,
+    const EncoderConfig& cfg,
+    const EncoderInput& in) noexcept
+{
+    EncoderOutput out{};
+    if (cfg.lines < 2) {
+        return out;
+    }
+
+    bool sincos = cfg.type == EncoderType::SinCos;
+    uint32_t per_turn = sincos ? 4 * cfg.lines : cfg.lines;
+
+    Angle32 phase = sincos ? angle32_atan2(in.sin, in.cos) : 0;
+    bool first = !state.initialized;
+    if (first) {
+        // Align the quarter count with the analog phase; an incremental
+        // encoder simply starts at zero.
+        state.count_prev = in.count;
+        state.index = phase >> 30;
+        state.initialized = true;
+    }
+
+    int16_t delta = static_cast<int16_t>(in.count - state.count_prev);
+    state.count_prev = in.count;
+    advance_index(state, delta, per_turn);
+
+    Position64 theta = sincos ? sincos_position(state, cfg, phase)
+                              : incremental_position(state, cfg);
+
+    if (!first) {
+        float dt = static_cast<float>(in.t_sample_ns - state.t_prev_ns) * 1e-9f;
+        if (dt > 0.0f) {
+            float w_raw = position64_delta_rad(theta, state.theta_prev) / dt;
+            state.w = cfg.w_alpha > 0.0f ? state.w + cfg.w_alpha * (w_raw - state.w) : w_raw;
+        }
+    }
+    state.theta_prev = theta;
+    state.t_prev_ns = in.t_sample_ns;
+
+    float lead = static_cast<float>(in.t_apply_ns - in.t_sample_ns) * 1e-9f;
+    out.theta_mech = theta + position64_from_rad(state.w * lead);
+    out.theta_elec = angle32_to_rad(position64_angle(out.theta_mech) * cfg.pole_pairs + cfg.elec_offset);
+    out.w = state.w;
+    return out;
+}
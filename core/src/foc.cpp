@@ -6,6 +6,24 @@ FocOutput run_foc(
     const FocInput& in,
     float dt
 ) noexcept 
+{
+    FocPlan plan;
+    foc_plan_build(plan, cfg, dt);
+    return run_foc_plan(state, plan, in);
+}
+
+bool foc_plan_build(
+    FocPlan& plan,
+    const FocConfig& cfg,
+    float dt) noexcept
+{
+    return current_loop_plan_build(plan.loop, cfg.loop, dt);
+}
+
+FocOutput run_foc_plan(
+    FocState& state,
+    const FocPlan& plan,
+    const FocInput& in) noexcept
 {
     FocOutput out{};
 
@@ -17,12 +35,12 @@ FocOutput run_foc(
     loop_in.i_setpoint = in.i_setpoint;
     loop_in.v_bus = in.v_bus;
 
-    CurrentLoopOutput loop_out = 
-        run_current_loop(state.loop, cfg.loop, loop_in, dt);
-    
+    CurrentLoopOutput loop_out =
+        run_current_loop_plan(state.loop, plan.loop, loop_in);
+
     AlphaBeta v_ab = inv_park(loop_out.v_dq, in.theta_elec);
 
     out.v_ab = v_ab;
     out.i_dq = i_dq;
     return out;
-}
\ No newline at end of file
+}
@@ -6,14 +6,28 @@ float lowpass_update(
     const LowPassConfig& cfg,
     float x) noexcept
 {
-    float a = clamp(cfg.alpha, 0.0f, 1.0f);
+    return lowpass_plan_update(state, LowPassPlan{clamp(cfg.alpha, 0.0f, 1.0f)}, x);
+}
 
+bool lowpass_plan_build(
+    LowPassPlan& plan,
+    const LowPassConfig& cfg) noexcept
+{
+    plan.alpha = clamp(cfg.alpha, 0.0f, 1.0f);
+    return cfg.alpha >= 0.0f && cfg.alpha <= 1.0f;
+}
+
+float lowpass_plan_update(
+    LowPassState& state,
+    const LowPassPlan& plan,
+    float x) noexcept
+{
     if (!state.initialized) {
         state.y = x;
         state.initialized = true;
         return state.y;
     }
 
-    state.y += a * (x - state.y);
+    state.y += plan.alpha * (x - state.y);
     return state.y;
-}
\ No newline at end of file
+}
@@ -1,6 +1,15 @@
 #include "modulation.hpp"
 
+#include <cstdint>
+
 ModulationOutput run_modulation(const ModulationInput& in) noexcept
+{
+    return run_modulation(ModulationConfig{ModulationMode::Svpwm}, in);
+}
+
+ModulationOutput run_modulation(
+    const ModulationConfig& cfg,
+    const ModulationInput& in) noexcept
 {
     ModulationOutput out{};
     out.m_a = 0.0f;
@@ -34,27 +43,146 @@ ModulationOutput run_modulation(const ModulationInput& in) noexcept
     if (x_b < min_x) min_x = x_b;
     if (x_c < min_x) min_x = x_c;
 
-    float z = -0.5f * (max_x + min_x);
+    // Line-to-line span above 2 lies outside the hexagon. Overmod keeps the
+    // demand and lets the per-leg clamp below trade phase error for
+    // fundamental, reaching six-step as the demand grows; every other mode
+    // shrinks the vector radially onto the hexagon boundary.
+    float span = max_x - min_x;
+    if (span > 2.0f) {
+        out.saturated = true;
+        if (cfg.mode != ModulationMode::Overmod) {
+            float s = 2.0f / span;
+            x_a *= s;
+            x_b *= s;
+            x_c *= s;
+            max_x *= s;
+            min_x *= s;
+        }
+    }
+
+    float z = 0.0f;
+    switch (cfg.mode) {
+    case ModulationMode::Dpwm60:
+        // Clamp the leg with the largest magnitude, 60 deg around each peak.
+        z = (max_x + min_x >= 0.0f) ? (1.0f - max_x) : (-1.0f - min_x);
+        break;
+
+    case ModulationMode::Dpwm120High:
+        z = 1.0f - max_x;
+        break;
+
+    case ModulationMode::Dpwm120Low:
+        z = -1.0f - min_x;
+        break;
+
+    case ModulationMode::Svpwm:
+    case ModulationMode::Overmod:
+    default:
+        z = -0.5f * (max_x + min_x);
+        break;
+    }
 
     float m_a = x_a + z;
     float m_b = x_b + z;
     float m_c = x_c + z;
 
-    float max_abs = std::fabs(m_a);
-    if (std::fabs(m_b) > max_abs) max_abs = std::fabs(m_b);
-    if (std::fabs(m_c) > max_abs) max_abs = std::fabs(m_c);
+    out.m_a = clamp(m_a, -1.0f, 1.0f);
+    out.m_b = clamp(m_b, -1.0f, 1.0f);
+    out.m_c = clamp(m_c, -1.0f, 1.0f);
+
+    return out;
+}
+
+void modulator_set_vbus(ModulatorState& state, float v_bus) noexcept
+{
+    if (v_bus == state.v_bus) {
+        return;
+    }
+    state.v_bus = v_bus;
+    state.inv_half_vbus = v_bus > 0.0f ? 2.0f / v_bus : 0.0f;
+}
+
+namespace {
 
-    if (max_abs > 1.0f && max_abs > 0.0f) {
-        float s = 1.0f / max_abs;
-        m_a *= s;
-        m_b *= s;
-        m_c *= s;
+struct SectorPhases {
+    uint8_t hi;
+    uint8_t lo;
+};
+
+// Indexed by (a >= b) | (b >= c) << 1 | (c >= a) << 2. Codes 0 and 7 only
+// occur for a zero vector, where any phase is both max and min.
+constexpr SectorPhases sector_phases[8] = {
+    {0, 0}, // impossible
+    {0, 1}, // a > c > b
+    {1, 2}, // b > a > c
+    {0, 2}, // a >= b >= c
+    {2, 0}, // c > b > a
+    {2, 1}, // c >= a >= b
+    {1, 0}, // b >= c >= a
+    {0, 0}, // all equal
+};
+
+} // namespace
+
+ModulationOutput run_modulator(
+    const ModulatorState& state,
+    const ModulationConfig& cfg,
+    const AlphaBeta& v_ab) noexcept
+{
+    ModulationOutput out{};
+
+    float k = state.inv_half_vbus;
+    if (k <= 0.0f) {
+        return out;
+    }
+
+    float a = v_ab.alpha * k;
+    float sb = sqrt3_v * v_ab.beta;
+    float kh = 0.5f * k;
+    float x[3] = {a, (-v_ab.alpha + sb) * kh, (-v_ab.alpha - sb) * kh};
+
+    unsigned sector = (x[0] >= x[1] ? 1u : 0u)
+                    | (x[1] >= x[2] ? 2u : 0u)
+                    | (x[2] >= x[0] ? 4u : 0u);
+    float max_x = x[sector_phases[sector].hi];
+    float min_x = x[sector_phases[sector].lo];
+
+    float span = max_x - min_x;
+    if (span > 2.0f) {
         out.saturated = true;
+        if (cfg.mode != ModulationMode::Overmod) {
+            float s = 2.0f / span;
+            x[0] *= s;
+            x[1] *= s;
+            x[2] *= s;
+            max_x *= s;
+            min_x *= s;
+        }
     }
 
-    out.m_a = clamp(m_a, -1.0f, 1.0f);
-    out.m_b = clamp(m_b, -1.0f, 1.0f);
-    out.m_c = clamp(m_c, -1.0f, 1.0f);
+    float z = 0.0f;
+    switch (cfg.mode) {
+    case ModulationMode::Dpwm60:
+        z = (max_x + min_x >= 0.0f) ? (1.0f - max_x) : (-1.0f - min_x);
+        break;
+
+    case ModulationMode::Dpwm120High:
+        z = 1.0f - max_x;
+        break;
+
+    case ModulationMode::Dpwm120Low:
+        z = -1.0f - min_x;
+        break;
+
+    case ModulationMode::Svpwm:
+    case ModulationMode::Overmod:
+    default:
+        z = -0.5f * (max_x + min_x);
+        break;
+    }
 
+    out.m_a = clamp(x[0] + z, -1.0f, 1.0f);
+    out.m_b = clamp(x[1] + z, -1.0f, 1.0f);
+    out.m_c = clamp(x[2] + z, -1.0f, 1.0f);
     return out;
-}
\ No newline at end of file
+}
@@ -0,0 +1,36 @@
+#include "multirate.hpp"
+
+// Down-counters instead of tick % div keep the per-tick cost to a
+// decrement and a compare. The phase offsets the first firing so axes
+// sharing a core can spread their outer loops over different ticks. A
+// restart (mode change) fires both loops immediately without moving the
+// schedule, so staggering survives mode switches; such an off-grid firing
+// is flagged as a hold so it does not integrate. The estimator stays on
+// the grid so its finite difference always spans one speed-loop period.
+MultirateDue multirate_tick(
+    MultirateState& state,
+    const MultirateConfig& cfg,
+    bool restart) noexcept
+{
+    uint16_t spd_div = multirate_div(cfg.spd_div);
+    uint16_t pos_div = multirate_div(cfg.pos_div);
+
+    if (state.spd_count == 0 || state.pos_count == 0) {
+        state.spd_count = static_cast<uint16_t>(cfg.phase % spd_div + 1);
+        state.pos_count = static_cast<uint16_t>(cfg.phase % pos_div + 1);
+    }
+
+    bool spd_slot = state.spd_count == 1;
+    bool pos_slot = state.pos_count == 1;
+
+    state.spd_count = spd_slot ? spd_div : static_cast<uint16_t>(state.spd_count - 1);
+    state.pos_count = pos_slot ? pos_div : static_cast<uint16_t>(state.pos_count - 1);
+
+    MultirateDue due{};
+    due.est = spd_slot;
+    due.spd = spd_slot || restart;
+    due.pos = pos_slot || restart;
+    due.spd_hold = restart && !spd_slot;
+    due.pos_hold = restart && !pos_slot;
+    return due;
+}
@@ -1,17 +1,194 @@
 #include "pi.hpp"
 
-float PI::update(float error, float dt) noexcept {
-    float i = integral + ki * error * dt;
+#include <cmath>
+
+namespace {
+
+// Shared by the PIConfig and PIPlan entry points; ki_dt and kb_dt are the
+// gains already multiplied by the step length.
+float pi_step(
+    PIState& state,
+    float kp,
+    float ki_dt,
+    float out_min,
+    float out_max,
+    float err_p,
+    float err_i) noexcept
+{
+    float i = state.integral + ki_dt * err_i;
     if (i > out_max) i = out_max;
     if (i < out_min) i = out_min;
-    integral = i;
+    state.integral = i;
 
-    float u = kp * error + integral;
+    float u = kp * err_p + state.integral;
     if (u > out_max) u = out_max;
     if (u < out_min) u = out_min;
     return u;
 }
 
+void antiwindup_step(
+    PIState& state,
+    AntiWindup aw,
+    float ki_dt,
+    float kb_dt,
+    float out_min,
+    float out_max,
+    float error,
+    float u,
+    float u_applied) noexcept
+{
+    float i = state.integral;
+    switch (aw) {
+    case AntiWindup::Clamp:
+        return;
+
+    case AntiWindup::BackCalculation:
+        i += kb_dt * (u_applied - u);
+        break;
+
+    case AntiWindup::Conditional:
+        if (error * (u - u_applied) > 0.0f) {
+            i -= ki_dt * error;
+        }
+        break;
+    }
+
+    if (i > out_max) i = out_max;
+    if (i < out_min) i = out_min;
+    state.integral = i;
+}
+
+void preload_step(
+    PIState& state,
+    float kp,
+    float ki_dt,
+    float out_min,
+    float out_max,
+    float u,
+    float error) noexcept
+{
+    float i = u - kp * error - ki_dt * error;
+    if (i > out_max) i = out_max;
+    if (i < out_min) i = out_min;
+    state.integral = i;
+}
+
+// kb * dt, with kb defaulting to ki / kp (or 1 / dt without a P term).
+float kb_times_dt(const PIConfig& cfg, float dt) noexcept
+{
+    if (cfg.kb > 0.0f) {
+        return cfg.kb * dt;
+    }
+    return cfg.kp > 0.0f ? cfg.ki / cfg.kp * dt : 1.0f;
+}
+
+} // namespace
+
+float pi_update(
+    PIState& state,
+    const PIConfig& cfg,
+    float error,
+    float dt) noexcept
+{
+    return pi_update_2dof(state, cfg, error, error, dt);
+}
+
+float pi_update_2dof(
+    PIState& state,
+    const PIConfig& cfg,
+    float err_p,
+    float err_i,
+    float dt) noexcept
+{
+    return pi_step(state, cfg.kp, cfg.ki * dt, cfg.out_min, cfg.out_max, err_p, err_i);
+}
+
+void pi_antiwindup(
+    PIState& state,
+    const PIConfig& cfg,
+    float error,
+    float u,
+    float u_applied,
+    float dt) noexcept
+{
+    if (u_applied == u) {
+        return;
+    }
+
+    float kb_dt = cfg.aw == AntiWindup::BackCalculation ? kb_times_dt(cfg, dt) : 0.0f;
+    antiwindup_step(state, cfg.aw, cfg.ki * dt, kb_dt, cfg.out_min, cfg.out_max,
+                    error, u, u_applied);
+}
+
+void pi_preload(
+    PIState& state,
+    const PIConfig& cfg,
+    float u,
+    float error,
+    float dt) noexcept
+{
+    preload_step(state, cfg.kp, cfg.ki * dt, cfg.out_min, cfg.out_max, u, error);
+}
+
+bool pi_plan_build(
+    PIPlan& plan,
+    const PIConfig& cfg,
+    float dt) noexcept
+{
+    plan.kp = cfg.kp;
+    plan.ki_dt = cfg.ki * dt;
+    plan.out_min = cfg.out_min;
+    plan.out_max = cfg.out_max;
+    plan.aw = cfg.aw;
+    plan.kb_dt = cfg.aw == AntiWindup::BackCalculation ? kb_times_dt(cfg, dt) : 0.0f;
+
+    return dt > 0.0f
+        && std::isfinite(cfg.kp) && cfg.kp >= 0.0f
+        && std::isfinite(cfg.ki) && cfg.ki >= 0.0f
+        && std::isfinite(cfg.kb) && cfg.kb >= 0.0f
+        && !(cfg.out_min > cfg.out_max)
+        && !std::isnan(cfg.out_min) && !std::isnan(cfg.out_max);
+}
+
+float pi_plan_update_2dof(
+    PIState& state,
+    const PIPlan& plan,
+    float err_p,
+    float err_i) noexcept
+{
+    return pi_step(state, plan.kp, plan.ki_dt, plan.out_min, plan.out_max, err_p, err_i);
+}
+
+void pi_plan_antiwindup(
+    PIState& state,
+    const PIPlan& plan,
+    float error,
+    float u,
+    float u_applied) noexcept
+{
+    if (u_applied == u) {
+        return;
+    }
+    antiwindup_step(state, plan.aw, plan.ki_dt, plan.kb_dt, plan.out_min, plan.out_max,
+                    error, u, u_applied);
+}
+
+void pi_plan_preload(
+    PIState& state,
+    const PIPlan& plan,
+    float u,
+    float error) noexcept
+{
+    preload_step(state, plan.kp, plan.ki_dt, plan.out_min, plan.out_max, u, error);
+}
+
+float PI::update(float error, float dt) noexcept {
+    PIState st{integral};
+    float u = pi_update(st, PIConfig{kp, ki, out_min, out_max}, error, dt);
+    integral = st.integral;
+    return u;
+}
+
 void PI::reset(float integral_init) noexcept {
     integral = integral_init;
 }
@@ -7,13 +7,38 @@ PositionLoopOutput run_position_loop(
     const PositionLoopInput& in,
     float dt
 ) noexcept
+{
+    PositionLoopPlan plan;
+    position_loop_plan_build(plan, cfg, dt);
+    return run_position_loop_plan(state, plan, in);
+}
+
+bool position_loop_plan_build(
+    PositionLoopPlan& plan,
+    const PositionLoopConfig& cfg,
+    float dt) noexcept
+{
+    plan.w_min = cfg.w_min;
+    plan.w_max = cfg.w_max;
+    plan.kff_vel = cfg.kff_vel;
+    bool ok = pi_plan_build(plan.pos_pi, cfg.pos_pi, dt);
+    return ok && cfg.w_min <= cfg.w_max && std::isfinite(cfg.kff_vel);
+}
+
+PositionLoopOutput run_position_loop_plan(
+    PositionLoopState& state,
+    const PositionLoopPlan& plan,
+    const PositionLoopInput& in) noexcept
 {
     PositionLoopOutput out{};
 
-    float err = wrap_pi(in.theta_setpoint - in.theta_meas);
-    float w = state.pos_pi.update(err, dt);
-    w = clamp(w, cfg.w_min, cfg.w_max);
+    float err = position64_delta_rad(in.theta_setpoint, in.theta_meas);
+    float w_unsat = pi_plan_update_2dof(state.pos_pi, plan.pos_pi, err, err) + plan.kff_vel * in.w_ff;
+    float w = clamp(w_unsat, plan.w_min, plan.w_max);
+    pi_plan_antiwindup(state.pos_pi, plan.pos_pi, err, w_unsat, w);
 
     out.w_cmd = w;
+    out.w_unsat = w_unsat;
+    out.err = err;
     return out;
-}
\ No newline at end of file
+}
@@ -0,0 +1,71 @@
+#include "protection.hpp"
+
+#include <limits>
+
+namespace {
+
+constexpr float off = std::numeric_limits<float>::infinity();
+
+float threshold(float x) noexcept
+{
+    return x > 0.0f ? x : off;
+}
+
+} // namespace
+
+bool protection_plan_build(
+    ProtectionPlan& plan,
+    const ProtectionConfig& cfg,
+    float dt) noexcept
+{
+    plan.i_phase_max = threshold(cfg.i_phase_max);
+    plan.i_rated_sq = cfg.i_rated * cfg.i_rated;
+    plan.i2t_limit = cfg.i_rated > 0.0f ? threshold(cfg.i2t_limit) : off;
+    plan.follow_err_max = threshold(cfg.follow_err_max);
+    plan.stall_iq = threshold(cfg.stall_iq);
+    plan.stall_w = cfg.stall_w;
+    plan.stall_ticks = 1;
+    if (cfg.stall_iq > 0.0f && cfg.stall_time > 0.0f && dt > 0.0f) {
+        plan.stall_ticks = static_cast<uint32_t>(cfg.stall_time / dt + 0.5f);
+        plan.stall_ticks = plan.stall_ticks > 0 ? plan.stall_ticks : 1;
+    }
+    plan.w_max = threshold(cfg.w_max);
+    plan.dt = dt;
+
+    return cfg.i_phase_max >= 0.0f && cfg.i_rated >= 0.0f && cfg.i2t_limit >= 0.0f
+        && cfg.follow_err_max >= 0.0f && cfg.stall_iq >= 0.0f && cfg.stall_w >= 0.0f
+        && cfg.stall_time >= 0.0f && cfg.w_max >= 0.0f
+        && !(cfg.i_rated > 0.0f && !(cfg.i2t_limit > 0.0f));
+}
+
+uint8_t run_protection_plan(
+    ProtectionState& state,
+    const ProtectionPlan& plan,
+    const ProtectionInput& in) noexcept
+{
+    float i_peak = std::fmax(std::fabs(in.i_abc.a),
+                             std::fmax(std::fabs(in.i_abc.b), std::fabs(in.i_abc.c)));
+
+    // Amplitude-invariant Clarke: |i_ab|^2 is the squared peak phase current.
+    AlphaBeta i_ab = clarke(in.i_abc);
+    float i_sq = i_ab.alpha * i_ab.alpha + i_ab.beta * i_ab.beta;
+    state.i2t = std::fmax(0.0f, state.i2t + (i_sq - plan.i_rated_sq) * plan.dt);
+
+    bool stalled = std::fabs(in.iq_cmd) >= plan.stall_iq && std::fabs(in.w_meas) < plan.stall_w;
+    state.stall_ticks = (state.stall_ticks + 1) * static_cast<uint32_t>(stalled);
+
+    uint32_t trip = static_cast<uint32_t>(i_peak > plan.i_phase_max)
+                  | static_cast<uint32_t>(state.i2t > plan.i2t_limit) << 1
+                  | static_cast<uint32_t>(std::fabs(in.follow_err) > plan.follow_err_max) << 2
+                  | static_cast<uint32_t>(state.stall_ticks >= plan.stall_ticks) << 3
+                  | static_cast<uint32_t>(std::fabs(in.w_meas) > plan.w_max) << 4;
+
+    state.faults = static_cast<uint8_t>(state.faults | trip);
+    return state.faults;
+}
+
+void protection_clear(ProtectionState& state) noexcept
+{
+    state.faults = 0;
+    state.stall_ticks = 0;
+}
@@ -1,40 +1,185 @@
 #include "speed_estimator.hpp"
 #include "foc_math.hpp"
 
+#include <cmath>
+
+bool kalman_build(
+    KalmanConfig& cfg,
+    const KalmanModel& model,
+    float dt) noexcept
+{
+    cfg = KalmanConfig{};
+    if (!(model.J > 0.0f) || !(dt > 0.0f) || !(model.r_theta > 0.0f)
+        || model.B < 0.0f || model.q_w < 0.0f || model.q_tau < 0.0f) {
+        return false;
+    }
+
+    const double h = dt;
+    const double a_ww = 1.0 - static_cast<double>(model.B) * h / model.J;
+    const double a_wtau = -h / model.J;
+    const double A[3][3] = {
+        {1.0, h, 0.0},
+        {0.0, a_ww, a_wtau},
+        {0.0, 0.0, 1.0},
+    };
+    const double q[3] = {
+        0.0,
+        static_cast<double>(model.q_w) * model.q_w,
+        static_cast<double>(model.q_tau) * model.q_tau,
+    };
+    const double r = static_cast<double>(model.r_theta) * model.r_theta;
+
+    // Iterate the Riccati recursion until the gain settles. Only the first
+    // state is measured, so H = [1 0 0] and the update needs no inverse.
+    double P[3][3] = {{r, 0.0, 0.0}, {0.0, r, 0.0}, {0.0, 0.0, r}};
+    double K[3] = {0.0, 0.0, 0.0};
+    bool converged = false;
+    for (int it = 0; it < 200000 && !converged; ++it) {
+        double AP[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                AP[i][j] = A[i][0] * P[0][j] + A[i][1] * P[1][j] + A[i][2] * P[2][j];
+            }
+        }
+        double Pp[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                Pp[i][j] = AP[i][0] * A[j][0] + AP[i][1] * A[j][1] + AP[i][2] * A[j][2];
+            }
+            Pp[i][i] += q[i];
+        }
+
+        double s = Pp[0][0] + r;
+        double K_new[3] = {Pp[0][0] / s, Pp[1][0] / s, Pp[2][0] / s};
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                P[i][j] = Pp[i][j] - K_new[i] * Pp[0][j];
+            }
+        }
+
+        converged = it > 0;
+        for (int i = 0; i < 3; ++i) {
+            if (std::fabs(K_new[i] - K[i]) > 1e-9 * (std::fabs(K_new[i]) + 1e-12)) {
+                converged = false;
+            }
+            K[i] = K_new[i];
+        }
+    }
+    if (!converged || !std::isfinite(K[0]) || !std::isfinite(K[1]) || !std::isfinite(K[2])) {
+        return false;
+    }
+
+    cfg.dt = dt;
+    cfg.a_ww = static_cast<float>(a_ww);
+    cfg.a_wtau = static_cast<float>(a_wtau);
+    cfg.b_iq = static_cast<float>(static_cast<double>(model.kt) * h / model.J);
+    cfg.l_theta = static_cast<float>(K[0]);
+    cfg.l_w = static_cast<float>(K[1]);
+    cfg.l_tau = static_cast<float>(K[2]);
+    return true;
+}
+
+namespace {
+
+SpeedEstimatorOutput run_kalman(
+    SpeedEstimatorState& state,
+    const KalmanConfig& kf,
+    const SpeedEstimatorInput& in) noexcept
+{
+    SpeedEstimatorOutput out{};
+    Angle32 theta = position64_angle(in.theta_meas);
+
+    if (!state.lp.initialized) {
+        state.theta_prev = theta;
+        state.lp.y = 0.0f;
+        state.lp.initialized = true;
+        state.tau_load = 0.0f;
+        return out;
+    }
+
+    // Predict, then correct with the position innovation.
+    float w = state.lp.y;
+    float step = w * kf.dt;
+    w = kf.a_ww * w + kf.b_iq * in.iq + kf.a_wtau * state.tau_load;
+
+    Angle32 theta_pred = state.theta_prev + angle32_from_rad(step);
+    float e = angle32_delta(theta, theta_pred) * angle32_rad_per_count;
+
+    state.theta_prev = theta_pred + angle32_from_rad(kf.l_theta * e);
+    state.lp.y = w + kf.l_w * e;
+    state.tau_load += kf.l_tau * e;
+
+    out.w_raw = state.lp.y;
+    out.w_filtered = state.lp.y;
+    out.tau_load = state.tau_load;
+    return out;
+}
+
+} // namespace
+
 SpeedEstimatorOutput run_speed_estimator(
     SpeedEstimatorState& state,
     const SpeedEstimatorConfig& cfg,
     const SpeedEstimatorInput& in,
     float dt) noexcept
+{
+    SpeedEstimatorPlan plan;
+    speed_estimator_plan_build(plan, cfg, dt);
+    return run_speed_estimator_plan(state, plan, in);
+}
+
+bool speed_estimator_plan_build(
+    SpeedEstimatorPlan& plan,
+    const SpeedEstimatorConfig& cfg,
+    float dt) noexcept
+{
+    bool ok = lowpass_plan_build(plan.lp, cfg.lp);
+    plan.kind = cfg.kind;
+    plan.kf = cfg.kf;
+    plan.dt = dt;
+    if (cfg.kind == SpeedEstimatorKind::Kalman) {
+        ok = ok && std::fabs(cfg.kf.dt - dt) <= 1e-6f * dt;
+    }
+    return ok && dt > 0.0f;
+}
+
+SpeedEstimatorOutput run_speed_estimator_plan(
+    SpeedEstimatorState& state,
+    const SpeedEstimatorPlan& plan,
+    const SpeedEstimatorInput& in) noexcept
 {
     SpeedEstimatorOutput out{};
 
-    if (dt <= 0.0f) {
-        out.w_raw = state.w_raw;
+    if (plan.dt <= 0.0f) {
+        out.w_raw = state.lp.y;
         out.w_filtered = state.lp.y;
+        out.tau_load = state.tau_load;
         return out;
     }
 
-    if (!state.initialized) {
-        state.theta_prev = in.theta_meas;
-        state.w_raw = 0.0f;
+    if (plan.kind == SpeedEstimatorKind::Kalman) {
+        return run_kalman(state, plan.kf, in);
+    }
+
+    Angle32 theta = position64_angle(in.theta_meas);
+
+    if (!state.lp.initialized) {
+        state.theta_prev = theta;
         state.lp.y = 0.0f;
         state.lp.initialized = true;
-        state.initialized = true;
         out.w_raw = 0.0f;
         out.w_filtered = 0.0f;
         return out;
     }
 
-    float dtheta = wrap_pi(in.theta_meas - state.theta_prev);
-    float w = dtheta / dt;
+    float dtheta = angle32_delta(theta, state.theta_prev) * angle32_rad_per_count;
+    float w = dtheta / plan.dt;
 
-    state.theta_prev = in.theta_meas;
-    state.w_raw = w;
+    state.theta_prev = theta;
 
-    float w_f = lowpass_update(state.lp, cfg.lp, w);
+    float w_f = lowpass_plan_update(state.lp, plan.lp, w);
 
     out.w_raw = w;
     out.w_filtered = w_f;
     return out;
-}
\ No newline at end of file
+}
@@ -6,13 +6,42 @@ SpeedLoopOutput run_speed_loop(
     const SpeedLoopConfig& cfg,
     const SpeedLoopInput& in,
     float dt) noexcept
+{
+    SpeedLoopPlan plan;
+    speed_loop_plan_build(plan, cfg, dt);
+    return run_speed_loop_plan(state, plan, in);
+}
+
+bool speed_loop_plan_build(
+    SpeedLoopPlan& plan,
+    const SpeedLoopConfig& cfg,
+    float dt) noexcept
+{
+    plan.iq_min = cfg.iq_min;
+    plan.iq_max = cfg.iq_max;
+    plan.kff_acc = cfg.kff_acc;
+    plan.b_cut = cfg.b_cut;
+    bool ok = pi_plan_build(plan.iq_pi, cfg.iq_pi, dt);
+    return ok && cfg.iq_min <= cfg.iq_max
+        && std::isfinite(cfg.kff_acc) && cfg.b_cut >= 0.0f && cfg.b_cut <= 1.0f;
+}
+
+SpeedLoopOutput run_speed_loop_plan(
+    SpeedLoopState& state,
+    const SpeedLoopPlan& plan,
+    const SpeedLoopInput& in) noexcept
 {
     SpeedLoopOutput out{};
 
     float err = in.w_setpoint - in.w_meas;
-    float iq = state.iq_pi.update(err, dt);
-    iq = clamp(iq, cfg.iq_min, cfg.iq_max);
+    float err_p = err - plan.b_cut * in.w_setpoint;
+    float iq_unsat = pi_plan_update_2dof(state.iq_pi, plan.iq_pi, err_p, err)
+                   + plan.kff_acc * in.acc_ff;
+    float iq = clamp(iq_unsat, plan.iq_min, plan.iq_max);
+    pi_plan_antiwindup(state.iq_pi, plan.iq_pi, err, iq_unsat, iq);
 
     out.iq_cmd = iq;
+    out.iq_unsat = iq_unsat;
+    out.err = err;
     return out;
-}
\ No newline at end of file
+}
@@ -0,0 +1,41 @@
+#include "thermal_estimator.hpp"
+
+bool thermal_estimator_plan_build(
+    ThermalEstimatorPlan& plan,
+    const ThermalEstimatorConfig& cfg,
+    float dt) noexcept
+{
+    bool model = cfg.rs > 0.0f && cfg.r_th > 0.0f && cfg.tau > 0.0f && dt > 0.0f;
+    bool derate = cfg.t_derate > 0.0f;
+
+    plan.k = model ? clamp(dt / cfg.tau, 0.0f, 1.0f) : 0.0f;
+    plan.rs = model ? cfg.rs : 0.0f;
+    plan.alpha_cu = cfg.alpha_cu;
+    plan.r_th = model ? cfg.r_th : 0.0f;
+    plan.t_ambient = cfg.t_ambient;
+    plan.rise_derate = cfg.t_derate - cfg.t_ambient;
+    plan.inv_span = derate && cfg.t_max > cfg.t_derate ? 1.0f / (cfg.t_max - cfg.t_derate) : 0.0f;
+
+    bool ok = cfg.rs >= 0.0f && cfg.alpha_cu >= 0.0f && cfg.r_th >= 0.0f && cfg.tau >= 0.0f;
+    ok = ok && (cfg.rs == 0.0f || (cfg.r_th > 0.0f && cfg.tau > 0.0f));
+    ok = ok && !(derate && !(cfg.t_max > cfg.t_derate));
+    return ok;
+}
+
+ThermalEstimatorOutput run_thermal_estimator_plan(
+    ThermalEstimatorState& state,
+    const ThermalEstimatorPlan& plan,
+    const PhaseCurrents& i_abc) noexcept
+{
+    // Amplitude-invariant Clarke: the copper loss is 1.5 * Rs * |i_ab|^2.
+    AlphaBeta i_ab = clarke(i_abc);
+    float i_sq = i_ab.alpha * i_ab.alpha + i_ab.beta * i_ab.beta;
+    float rs = plan.rs * (1.0f + plan.alpha_cu * state.rise);
+    float rise_ss = 1.5f * rs * i_sq * plan.r_th;
+    state.rise += plan.k * (rise_ss - state.rise);
+
+    ThermalEstimatorOutput out;
+    out.t_winding = plan.t_ambient + state.rise;
+    out.iq_scale = clamp(1.0f - (state.rise - plan.rise_derate) * plan.inv_span, 0.0f, 1.0f);
+    return out;
+}
@@ -6,16 +6,46 @@ TrajOutput run_traj_step(
     const TrajConfig& cfg,
     const TrajInput& in,
     float dt) noexcept
+{
+    TrajPlan plan;
+    traj_plan_build(plan, cfg, dt);
+    return run_traj_plan(state, plan, in);
+}
+
+bool traj_plan_build(
+    TrajPlan& plan,
+    const TrajConfig& cfg,
+    float dt) noexcept
+{
+    plan = TrajPlan{};
+    plan.max_vel = cfg.max_vel;
+    plan.max_acc = cfg.max_acc;
+    plan.enabled = dt > 0.0f && cfg.max_acc > 0.0f && cfg.max_vel > 0.0f;
+    if (plan.enabled) {
+        plan.half_inv_acc = 0.5f / cfg.max_acc;
+        plan.dt = dt;
+        plan.inv_dt = 1.0f / dt;
+    }
+    return dt > 0.0f
+        && std::isfinite(cfg.max_vel) && cfg.max_vel >= 0.0f
+        && std::isfinite(cfg.max_acc) && cfg.max_acc >= 0.0f;
+}
+
+TrajOutput run_traj_plan(
+    TrajState& state,
+    const TrajPlan& plan,
+    const TrajInput& in) noexcept
 {
     TrajOutput out{};
 
-    if (dt <= 0.0f || cfg.max_acc <= 0.0f || cfg.max_vel <= 0.0f) {
+    if (!plan.enabled) {
         out.pos_ref = state.pos;
         out.vel_ref = state.vel;
+        state.acc = 0.0f;
         return out;
     }
 
-    float err = in.target_pos - state.pos;
+    float err = position64_delta_rad(in.target_pos, state.pos);
     float s = signf(err);
 
     float v = state.vel;
@@ -26,29 +56,32 @@ TrajOutput run_traj_step(
         a = 0.0f;
     } else {
         float v_abs = std::fabs(v);
-        float d_stop = 0.5f * v_abs * v_abs / cfg.max_acc;
+        float d_stop = v_abs * v_abs * plan.half_inv_acc;
 
         if (std::fabs(err) <= d_stop) {
-            a = -signf(v) * cfg.max_acc;
+            a = -signf(v) * plan.max_acc;
         } else {
-            a = s * cfg.max_acc;
+            a = s * plan.max_acc;
         }
     }
 
-    v += a * dt;
-    v = clamp(v, -cfg.max_vel, cfg.max_vel);
+    v += a * plan.dt;
+    v = clamp(v, -plan.max_vel, plan.max_vel);
 
-    float p = state.pos + v * dt;
+    Position64 p = state.pos + position64_from_rad(v * plan.dt);
 
-    if (std::fabs(in.target_pos - p) < 1e-6f && std::fabs(v) < 1e-4f) {
+    if (std::fabs(position64_delta_rad(in.target_pos, p)) < 1e-6f && std::fabs(v) < 1e-4f) {
         p = in.target_pos;
         v = 0.0f;
     }
 
+    out.acc_ref = (v - state.vel) * plan.inv_dt;
+
     state.pos = p;
     state.vel = v;
+    state.acc = out.acc_ref;
 
     out.pos_ref = p;
     out.vel_ref = v;
     return out;
-}
\ No newline at end of file
+}
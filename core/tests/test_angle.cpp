@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "angle.hpp"
+#include "foc_math.hpp"
+
+TEST(Angle32, RoundTripsRadians) {
+    for (float r : {0.0f, 0.5f, 1.0f, 3.0f, 6.0f}) {
+        EXPECT_NEAR(angle32_to_rad(angle32_from_rad(r)), r, 1e-6f);
+    }
+    EXPECT_NEAR(angle32_to_signed_rad(angle32_from_rad(-1.0f)), -1.0f, 1e-6f);
+    EXPECT_NEAR(angle32_to_rad(angle32_from_rad(-1.0f)), two_pi_v - 1.0f, 1e-6f);
+}
+
+TEST(Angle32, ConversionsStayInRange) {
+    EXPECT_LT(angle32_to_rad(0xFFFFFFFFu), two_pi_v);
+    EXPECT_GE(angle32_to_rad(0xFFFFFFFFu), 0.0f);
+    EXPECT_LT(angle32_to_signed_rad(0x7FFFFFFFu), pi_v);
+    EXPECT_FLOAT_EQ(angle32_to_signed_rad(0x80000000u), -pi_v);
+}
+
+TEST(Angle32, DeltaTakesShortestPathAcrossWrap) {
+    Angle32 a = angle32_from_rad(0.1f);
+    Angle32 b = angle32_from_rad(two_pi_v - 0.1f);
+    EXPECT_NEAR(angle32_delta(a, b) * angle32_rad_per_count, 0.2f, 1e-6f);
+    EXPECT_NEAR(angle32_delta(b, a) * angle32_rad_per_count, -0.2f, 1e-6f);
+}
+
+TEST(Angle32, AccumulationDoesNotDrift) {
+    // One million steps of ~1/1000 turn stay exact in counts, and the
+    // result reads back to the same float angle as a single conversion.
+    const Angle32 step = 4294967u;  // floor(2^32 / 1000)
+    Angle32 q = 0;
+    for (int k = 0; k < 1000000; ++k) {
+        q += step;
+    }
+    Angle32 expect = static_cast<Angle32>(1000000ull * step);
+    EXPECT_EQ(q, expect);
+    EXPECT_FLOAT_EQ(angle32_to_rad(q), angle32_to_rad(expect));
+}
+
+TEST(Angle32, Atan2MatchesLibm) {
+    float worst = 0.0f;
+    for (int k = 0; k < 3600; ++k) {
+        float th = two_pi_v * k / 3600.0f;
+        float r = 0.5f + 0.25f * (k % 7);
+        Angle32 a = angle32_atan2(r * std::sin(th), r * std::cos(th));
+        float err = std::fabs(wrap_pi(angle32_to_rad(a) - th));
+        worst = std::fmax(worst, err);
+    }
+    EXPECT_LT(worst, 2e-5f);
+    EXPECT_EQ(angle32_atan2(0.0f, 0.0f), 0u);
+}
+
+TEST(Angle32, FromRadIsDefinedForEveryFloat) {
+    // Past 2^55 counts every float is a whole number of turns, on either side
+    // of the int64 range; non-finite input reads as angle 0 as well.
+    for (float r : {5e8f, 1e9f, -1e9f, 1e10f, -1e12f, 3.0e38f, -3.0e38f,
+                    INFINITY, -INFINITY, NAN}) {
+        EXPECT_EQ(angle32_from_rad(r), 0u) << r;
+        EXPECT_EQ(wrap_2pi(r), 0.0f) << r;
+        EXPECT_EQ(wrap_pi(r), 0.0f) << r;
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cmath>
 #include "axis_core.hpp"
 
 static AxisCoreConfig make_default_axis_cfg() {
@@ -19,15 +20,16 @@ TEST(AxisCore, IdleModeProducesZeroModulation) {
 
     AxisCoreInput in{};
     in.mode = AxisMode::Idle;
-    in.theta_meas = 0.0f;
+    in.theta_meas = position64_from_rad(0.0f);
     in.i_abc = {0.0f, 0.0f, 0.0f};
-    in.theta_target = 0.0f;
+    in.theta_target = position64_from_rad(0.0f);
     in.w_target = 0.0f;
     in.iq_target = 0.0f;
     in.v_bus = 24.0f;
     in.theta_elec = 0.0f;
 
     AxisCoreOutput out = run_axis_core(st, cfg, in, 0.001f);
+    EXPECT_FALSE(out.pwm_enable);
     EXPECT_FLOAT_EQ(out.m_a, 0.0f);
     EXPECT_FLOAT_EQ(out.m_b, 0.0f);
     EXPECT_FLOAT_EQ(out.m_c, 0.0f);
@@ -36,14 +38,14 @@ TEST(AxisCore, IdleModeProducesZeroModulation) {
 TEST(AxisCore, CurrentIqModeUsesIqTarget) {
     AxisCoreConfig cfg = make_default_axis_cfg();
     AxisCoreState st{};
-    st.foc.loop.id = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     AxisCoreInput in{};
     in.mode = AxisMode::CurrentIq;
-    in.theta_meas = 0.0f;
+    in.theta_meas = position64_from_rad(0.0f);
     in.i_abc = {0.0f, 0.0f, 0.0f};
-    in.theta_target = 0.0f;
+    in.theta_target = position64_from_rad(0.0f);
     in.w_target = 0.0f;
     in.iq_target = 3.0f;
     in.v_bus = 24.0f;
@@ -56,15 +58,15 @@ TEST(AxisCore, CurrentIqModeUsesIqTarget) {
 TEST(AxisCore, VelocityModeProducesPositiveIqForPositiveSpeed) {
     AxisCoreConfig cfg = make_default_axis_cfg();
     AxisCoreState st{};
-    st.spd.iq_pi = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.id = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.spd.iq_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     AxisCoreInput in{};
     in.mode = AxisMode::Velocity;
-    in.theta_meas = 0.0f;
+    in.theta_meas = position64_from_rad(0.0f);
     in.i_abc = {0.0f, 0.0f, 0.0f};
-    in.theta_target = 0.0f;
+    in.theta_target = position64_from_rad(0.0f);
     in.w_target = 5.0f;
     in.iq_target = 0.0f;
     in.v_bus = 24.0f;
@@ -77,26 +79,26 @@ TEST(AxisCore, VelocityModeProducesPositiveIqForPositiveSpeed) {
 TEST(AxisCore, PositionModeMovesThetaRefTowardTarget) {
     AxisCoreConfig cfg = make_default_axis_cfg();
     AxisCoreState st{};
-    st.pos.pos_pi = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.spd.iq_pi = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.id = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+    cfg.spd.iq_pi = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     AxisCoreInput in{};
     in.mode = AxisMode::Position;
-    in.theta_meas = 0.0f;
+    in.theta_meas = position64_from_rad(0.0f);
     in.i_abc = {0.0f, 0.0f, 0.0f};
-    in.theta_target = 1.0f;
+    in.theta_target = position64_from_rad(1.0f);
     in.w_target = 0.0f;
     in.iq_target = 0.0f;
     in.v_bus = 24.0f;
     in.theta_elec = 0.0f;
 
     float dt = 0.001f;
-    float last_theta_ref = 0.0f;
+    Position64 last_theta_ref = 0;
     for (int k = 0; k < 100; ++k) {
         AxisCoreOutput out = run_axis_core(st, cfg, in, dt);
-        EXPECT_GE(out.theta_ref, last_theta_ref - 1e-6f);
+        EXPECT_GE(out.theta_ref, last_theta_ref);
         last_theta_ref = out.theta_ref;
     }
 }
@@ -107,15 +109,15 @@ TEST(AxisCore, IqLimitFlagIsSetWhenClamped) {
     cfg.lim.iq_min = -1.0f;
 
     AxisCoreState st{};
-    st.spd.iq_pi = PI{10.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.id = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.foc.loop.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.spd.iq_pi = PIConfig{10.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     AxisCoreInput in{};
     in.mode = AxisMode::Velocity;
-    in.theta_meas = 0.0f;
+    in.theta_meas = position64_from_rad(0.0f);
     in.i_abc = {0.0f, 0.0f, 0.0f};
-    in.theta_target = 0.0f;
+    in.theta_target = position64_from_rad(0.0f);
     in.w_target = 10.0f;
     in.iq_target = 0.0f;
     in.v_bus = 24.0f;
@@ -125,3 +127,479 @@ TEST(AxisCore, IqLimitFlagIsSetWhenClamped) {
     EXPECT_LE(out.iq_cmd, 1.0f + 1e-6f);
     EXPECT_TRUE(out.status.iq_limited);
 }
+
+TEST(AxisCore, DecimatedSpeedLoopHoldsIqBetweenRuns) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.rate = MultirateConfig{4, 4, 0};
+
+    AxisCoreState st{};
+    cfg.spd.iq_pi = PIConfig{0.0f, 100.0f, -100.0f, 100.0f};
+    cfg.foc.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::Velocity;
+    in.w_target = 5.0f;
+    in.v_bus = 24.0f;
+
+    float dt = 0.001f;
+    float prev = 0.0f;
+    for (int k = 0; k < 12; ++k) {
+        AxisCoreOutput out = run_axis_core(st, cfg, in, dt);
+        if (k % 4 == 0) {
+            // Integral step uses the decimated period: ki * err * 4 * dt.
+            EXPECT_NEAR(out.iq_cmd - prev, 100.0f * 5.0f * 4.0f * dt, 1e-4f);
+        } else {
+            EXPECT_FLOAT_EQ(out.iq_cmd, prev);
+        }
+        prev = out.iq_cmd;
+    }
+}
+
+TEST(AxisCore, OffGridRestartDoesNotDoubleStepIntegral) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.rate = MultirateConfig{4, 4, 0};
+    cfg.spd.iq_pi = PIConfig{0.0f, 100.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    AxisCoreState st{};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::Idle;
+    in.v_bus = 24.0f;
+    const float dt = 0.001f;
+    run_axis_core(st, cfg, in, dt);
+    run_axis_core(st, cfg, in, dt);
+
+    // Tick 2 is between slots: the loop fires but does not integrate.
+    in.mode = AxisMode::Velocity;
+    in.w_target = 5.0f;
+    EXPECT_FLOAT_EQ(run_axis_core(st, cfg, in, dt).iq_cmd, 0.0f);
+    EXPECT_FLOAT_EQ(run_axis_core(st, cfg, in, dt).iq_cmd, 0.0f);
+
+    // Tick 4 is the slot: one period's worth, not two.
+    EXPECT_NEAR(run_axis_core(st, cfg, in, dt).iq_cmd, 100.0f * 5.0f * 4.0f * dt, 1e-4f);
+}
+
+TEST(AxisCore, ModeChangeRunsOuterLoopsImmediately) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.rate = MultirateConfig{10, 10, 5};
+
+    AxisCoreState st{};
+    cfg.spd.iq_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::Idle;
+    in.v_bus = 24.0f;
+    run_axis_core(st, cfg, in, 0.001f);
+
+    in.mode = AxisMode::Velocity;
+    in.w_target = 5.0f;
+    AxisCoreOutput out = run_axis_core(st, cfg, in, 0.001f);
+    EXPECT_NEAR(out.iq_cmd, 10.0f, 1e-4f);
+}
+
+TEST(AxisCore, BackCalculationLimitsSpeedIntegralUnderIqLimit) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.lim.iq_max = 1.0f;
+    cfg.lim.iq_min = -1.0f;
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::Velocity;
+    in.w_target = 100.0f;
+    in.v_bus = 24.0f;
+
+    float integral[2] = {};
+    for (int v = 0; v < 2; ++v) {
+        cfg.spd.iq_pi = PIConfig{0.1f, 10.0f, -100.0f, 100.0f,
+                                 v == 0 ? AntiWindup::Clamp : AntiWindup::BackCalculation, 0.0f};
+        AxisCoreState st{};
+        for (int k = 0; k < 200; ++k) {
+            run_axis_core(st, cfg, in, 0.001f);
+        }
+        integral[v] = st.spd.iq_pi.integral;
+    }
+
+    EXPECT_GT(integral[0], 10.0f);
+    EXPECT_LT(integral[1], 1.5f);
+}
+
+TEST(AxisCore, BumplessTransferFromCurrentToVelocity) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.spd.iq_pi = PIConfig{0.5f, 20.0f, -100.0f, 100.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+
+    AxisCoreInput in{};
+    in.v_bus = 24.0f;
+    in.iq_target = 2.0f;
+    in.w_target = 3.0f;
+
+    float iq_after[2] = {};
+    for (int v = 0; v < 2; ++v) {
+        cfg.bumpless = v == 1;
+        AxisCoreState st{};
+        in.mode = AxisMode::CurrentIq;
+        for (int k = 0; k < 10; ++k) {
+            run_axis_core(st, cfg, in, 0.001f);
+        }
+        in.mode = AxisMode::Velocity;
+        iq_after[v] = run_axis_core(st, cfg, in, 0.001f).iq_cmd;
+    }
+
+    EXPECT_LT(iq_after[0], 2.0f);
+    EXPECT_NEAR(iq_after[1], 2.0f, 1e-5f);
+}
+
+TEST(AxisCore, BumplessPositionEntryStartsTrajectoryAtMeasurement) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.bumpless = true;
+    cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+
+    AxisCoreState st{};
+    AxisCoreInput in{};
+    in.mode = AxisMode::Position;
+    in.theta_meas = position64_from_rad(0.7f);
+    in.theta_target = position64_from_rad(0.7f);
+    in.v_bus = 24.0f;
+
+    AxisCoreOutput out = run_axis_core(st, cfg, in, 0.001f);
+    EXPECT_EQ(out.theta_ref, in.theta_meas);
+    EXPECT_NEAR(out.w_cmd, 0.0f, 1e-6f);
+}
+
+TEST(AxisCore, CompileResolvesConstantsPerLoopRate) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.spd.iq_pi = PIConfig{0.5f, 10.0f, -10.0f, 10.0f, AntiWindup::BackCalculation};
+    cfg.rate = MultirateConfig{4, 8, 0};
+    const float dt = 5e-5f;
+
+    AxisCorePlan plan;
+    ASSERT_TRUE(compile_axis_config(plan, cfg, dt));
+    EXPECT_FLOAT_EQ(plan.dt_spd, 4.0f * dt);
+    EXPECT_FLOAT_EQ(plan.dt_pos, 8.0f * dt);
+    EXPECT_FLOAT_EQ(plan.spd.iq_pi.ki_dt, 10.0f * 4.0f * dt);
+    EXPECT_FLOAT_EQ(plan.spd.iq_pi.kb_dt, 10.0f / 0.5f * 4.0f * dt);
+    EXPECT_FLOAT_EQ(plan.traj.half_inv_acc, 0.25f);
+    EXPECT_FLOAT_EQ(plan.est.lp.alpha, 0.2f);
+}
+
+TEST(AxisCore, CompileRejectsInvalidConfigButStillFillsPlan) {
+    const float dt = 5e-5f;
+    AxisCorePlan plan;
+
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.est.lp.alpha = 1.5f;
+    EXPECT_FALSE(compile_axis_config(plan, cfg, dt));
+    EXPECT_FLOAT_EQ(plan.est.lp.alpha, 1.0f);
+
+    cfg = make_default_axis_cfg();
+    cfg.lim.iq_min = 1.0f;
+    cfg.lim.iq_max = -1.0f;
+    EXPECT_FALSE(compile_axis_config(plan, cfg, dt));
+
+    cfg = make_default_axis_cfg();
+    cfg.spd.iq_pi.ki = -1.0f;
+    EXPECT_FALSE(compile_axis_config(plan, cfg, dt));
+
+    // The Kalman gain must be built for the speed loop's period.
+    cfg = make_default_axis_cfg();
+    cfg.rate = MultirateConfig{2, 2, 0};
+    cfg.est.kind = SpeedEstimatorKind::Kalman;
+    ASSERT_TRUE(kalman_build(cfg.est.kf, KalmanModel{1e-4f, 1e-3f, 0.3f, 0.05f, 5e-3f, 3e-3f}, dt));
+    EXPECT_FALSE(compile_axis_config(plan, cfg, dt));
+    ASSERT_TRUE(kalman_build(cfg.est.kf, KalmanModel{1e-4f, 1e-3f, 0.3f, 0.05f, 5e-3f, 3e-3f}, 2.0f * dt));
+    EXPECT_TRUE(compile_axis_config(plan, cfg, dt));
+
+    EXPECT_FALSE(compile_axis_config(plan, make_default_axis_cfg(), 0.0f));
+}
+
+TEST(AxisCore, LatchedFaultHoldsAxisIdleUntilReset) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.spd.iq_pi = PIConfig{0.5f, 10.0f, -10.0f, 10.0f};
+    cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    cfg.prot.i_phase_max = 5.0f;
+    cfg.bumpless = true;
+    AxisCoreState st{};
+    AxisGuardState guard{};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::Velocity;
+    in.w_target = 10.0f;
+    in.v_bus = 24.0f;
+    AxisCoreOutput out{};
+    for (int k = 0; k < 3; ++k) {
+        out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    }
+    EXPECT_EQ(out.status.faults, 0u);
+    EXPECT_GT(out.iq_cmd, 0.0f);
+    EXPECT_TRUE(out.pwm_enable);
+
+    in.i_abc = {6.0f, -3.0f, -3.0f};
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_EQ(out.status.faults, axis_fault_overcurrent);
+    EXPECT_FALSE(out.pwm_enable);
+    EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, 0.0f);
+
+    in.i_abc = {0.0f, 0.0f, 0.0f};
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_EQ(out.status.faults, axis_fault_overcurrent);
+    EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+
+    // The reset tick re-enters the loop from Idle, bumplessly from zero.
+    in.fault_reset = true;
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_EQ(out.status.faults, 0u);
+    EXPECT_FLOAT_EQ(out.iq_cmd, 0.0f);
+    EXPECT_EQ(st.mode_prev, AxisMode::Velocity);
+    in.fault_reset = false;
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_GT(out.iq_cmd, 0.0f);
+
+    // Without a guard the same current is not supervised.
+    AxisCoreState bare{};
+    in.i_abc = {6.0f, -3.0f, -3.0f};
+    EXPECT_EQ(run_axis_core(bare, cfg, in, 1e-4f).status.faults, 0u);
+}
+
+TEST(AxisCore, FollowingErrorOnlyCheckedWhileTrackingInPosition) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.prot.follow_err_max = 0.5f;
+    cfg.bumpless = true;
+    AxisCoreState st{};
+    AxisGuardState guard{};
+
+    // Entering Position far from the old reference is not a fault: the
+    // profile restarts from the measurement.
+    AxisCoreInput in{};
+    in.mode = AxisMode::Position;
+    in.theta_meas = position64_from_rad(3.0f);
+    in.theta_target = in.theta_meas;
+    in.v_bus = 24.0f;
+    EXPECT_EQ(run_axis_core(st, guard, cfg, in, 1e-4f).status.faults, 0u);
+    EXPECT_EQ(run_axis_core(st, guard, cfg, in, 1e-4f).status.faults, 0u);
+
+    in.theta_meas = position64_from_rad(2.0f);
+    EXPECT_EQ(run_axis_core(st, guard, cfg, in, 1e-4f).status.faults, axis_fault_following);
+}
+
+TEST(AxisCore, HotWindingDeratesIqLimits) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.lim = LimitsConfig{-10.0f, 10.0f, -100.0f, 100.0f};
+    cfg.thermal = ThermalEstimatorConfig{0.5f, 0.0039f, 2.0f, 60.0f, 40.0f, 100.0f, 140.0f};
+    AxisCoreState st{};
+    AxisGuardState guard{};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::CurrentIq;
+    in.iq_target = -50.0f;
+    in.v_bus = 24.0f;
+
+    AxisCoreOutput out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_FLOAT_EQ(out.status.iq_scale, 1.0f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, -10.0f);
+
+    // Half way from t_derate to t_max: both limits at half.
+    guard.thermal.rise = 80.0f;
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_NEAR(out.status.t_winding, 120.0f, 1e-3f);
+    EXPECT_NEAR(out.status.iq_scale, 0.5f, 1e-4f);
+    EXPECT_NEAR(out.iq_cmd, -5.0f, 1e-3f);
+    EXPECT_TRUE(out.status.iq_limited);
+
+    // Without a guard nothing is estimated or derated.
+    AxisCoreState bare{};
+    out = run_axis_core(bare, cfg, in, 1e-4f);
+    EXPECT_FLOAT_EQ(out.status.iq_scale, 1.0f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, -10.0f);
+}
+
+TEST(AxisCore, CompileRejectsThermalDerateWithoutSpan) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.thermal = ThermalEstimatorConfig{0.5f, 0.0039f, 2.0f, 60.0f, 40.0f, 100.0f, 100.0f};
+    AxisCorePlan plan;
+    EXPECT_FALSE(compile_axis_config(plan, cfg, 1e-4f));
+}
+
+TEST(AxisCore, CurrentOffsetCalibrationHoldsAxisIdleFirst) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.sense.two_shunt = true;
+    cfg.sense.calib_ticks = 8;
+    cfg.bumpless = true;
+    AxisCoreState st{};
+    AxisGuardState guard{};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::CurrentIq;
+    in.iq_target = 2.0f;
+    in.v_bus = 24.0f;
+    in.i_abc = {0.25f, -0.5f, 3.0f};  // bridge off: offsets only, c unwired
+
+    for (int k = 0; k < 8; ++k) {
+        AxisCoreOutput out = run_axis_core(st, guard, cfg, in, 1e-4f);
+        EXPECT_TRUE(out.status.calibrating);
+        EXPECT_FALSE(out.pwm_enable);
+        EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+        EXPECT_FLOAT_EQ(out.iq_cmd, 0.0f);
+    }
+
+    AxisCoreOutput out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_FALSE(out.status.calibrating);
+    EXPECT_TRUE(out.pwm_enable);
+    EXPECT_FLOAT_EQ(out.iq_cmd, 2.0f);
+    // The offsets read back as zero current.
+    EXPECT_NEAR(out.i_dq.d, 0.0f, 1e-6f);
+    EXPECT_NEAR(out.i_dq.q, 0.0f, 1e-6f);
+}
+
+TEST(AxisCore, ProtectionAndThermalRunDuringCalibration) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.sense.calib_ticks = 100;
+    cfg.prot.i_phase_max = 5.0f;
+    cfg.thermal = ThermalEstimatorConfig{0.5f, 0.0039f, 2.0f, 0.01f, 40.0f, 100.0f, 140.0f};
+    AxisCoreState st{};
+    AxisGuardState guard{};
+    guard.thermal.rise = 80.0f;
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::CurrentIq;
+    in.iq_target = 2.0f;
+    in.v_bus = 24.0f;
+    AxisCoreOutput out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_TRUE(out.status.calibrating);
+    EXPECT_EQ(out.status.faults, 0u);
+    // The estimate keeps cooling while the window is open.
+    EXPECT_LT(out.status.t_winding, 120.0f);
+    EXPECT_GT(out.status.iq_scale, 0.5f);
+
+    // A current with the gates off is a fault, not an offset to average.
+    in.i_abc = {8.0f, -4.0f, -4.0f};
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_TRUE(out.status.calibrating);
+    EXPECT_EQ(out.status.faults, axis_fault_overcurrent);
+    EXPECT_FALSE(out.pwm_enable);
+
+    in.i_abc = {0.0f, 0.0f, 0.0f};
+    for (int k = 2; k < 100; ++k) {
+        run_axis_core(st, guard, cfg, in, 1e-4f);
+    }
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_FALSE(out.status.calibrating);
+    EXPECT_EQ(out.status.faults, axis_fault_overcurrent);
+    EXPECT_FALSE(out.pwm_enable);
+}
+
+TEST(AxisCore, SpeedEstimateStaysLiveWhileFaulted) {
+    const float dt = 1e-4f;
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.prot.w_max = 50.0f;
+    cfg.prot.i_phase_max = 5.0f;
+    AxisCoreState st{};
+    AxisGuardState guard{};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::Velocity;
+    in.w_target = 5.0f;
+    in.v_bus = 24.0f;
+    float theta = 0.0f;
+    AxisCoreOutput out{};
+
+    // Spun to 100 rad/s from outside: overspeed latches.
+    for (int k = 0; k < 200; ++k) {
+        theta += 100.0f * dt;
+        in.theta_meas = position64_from_rad(theta);
+        out = run_axis_core(st, guard, cfg, in, dt);
+    }
+    EXPECT_EQ(out.status.faults, axis_fault_overspeed);
+
+    // Once the axis has stopped the fault resets and stays reset.
+    for (int k = 0; k < 200; ++k) {
+        out = run_axis_core(st, guard, cfg, in, dt);
+    }
+    in.fault_reset = true;
+    out = run_axis_core(st, guard, cfg, in, dt);
+    EXPECT_EQ(out.status.faults, 0u);
+    in.fault_reset = false;
+    out = run_axis_core(st, guard, cfg, in, dt);
+    EXPECT_EQ(out.status.faults, 0u);
+    EXPECT_TRUE(out.pwm_enable);
+
+    // An overcurrent trip on an axis coasting at 10 rad/s, reset much later:
+    // the estimate has followed the rotor, so the reset does not see the
+    // whole gap as one step.
+    for (int k = 0; k < 100; ++k) {
+        theta += 10.0f * dt;
+        in.theta_meas = position64_from_rad(theta);
+        out = run_axis_core(st, guard, cfg, in, dt);
+    }
+    in.i_abc = {6.0f, -3.0f, -3.0f};
+    out = run_axis_core(st, guard, cfg, in, dt);
+    EXPECT_EQ(out.status.faults, axis_fault_overcurrent);
+    in.i_abc = {0.0f, 0.0f, 0.0f};
+    for (int k = 0; k < 1400; ++k) {
+        theta += 10.0f * dt;
+        in.theta_meas = position64_from_rad(theta);
+        run_axis_core(st, guard, cfg, in, dt);
+    }
+    in.fault_reset = true;
+    for (int k = 0; k < 5; ++k) {
+        theta += 10.0f * dt;
+        in.theta_meas = position64_from_rad(theta);
+        out = run_axis_core(st, guard, cfg, in, dt);
+        in.fault_reset = false;
+        EXPECT_EQ(out.status.faults, 0u) << "tick " << k;
+    }
+    EXPECT_NEAR(st.est.lp.y, 10.0f, 0.1f);
+}
+
+TEST(AxisCore, GuardCachesBusScaleAcrossTicks) {
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    AxisCoreState st{};
+    AxisCoreState bare{};
+    AxisGuardState guard{};
+
+    AxisCoreInput in{};
+    in.mode = AxisMode::CurrentIq;
+    in.iq_target = 2.0f;
+    in.v_bus = 24.0f;
+    AxisCoreOutput out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_FLOAT_EQ(guard.mod.v_bus, 24.0f);
+    EXPECT_FLOAT_EQ(guard.mod.inv_half_vbus, 2.0f / 24.0f);
+    EXPECT_FLOAT_EQ(out.m_a, run_axis_core(bare, cfg, in, 1e-4f).m_a);
+
+    in.v_bus = 12.0f;
+    out = run_axis_core(st, guard, cfg, in, 1e-4f);
+    EXPECT_FLOAT_EQ(guard.mod.inv_half_vbus, 2.0f / 12.0f);
+    EXPECT_FLOAT_EQ(out.m_a, run_axis_core(bare, cfg, in, 1e-4f).m_a);
+}
+
+TEST(AxisCore, KalmanEstimatorSeesMeasuredTorqueCurrent) {
+    const float dt = 1e-3f;
+    AxisCoreConfig cfg = make_default_axis_cfg();
+    cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.est.kind = SpeedEstimatorKind::Kalman;
+    ASSERT_TRUE(kalman_build(cfg.est.kf, KalmanModel{1e-4f, 1e-3f, 0.3f, 0.05f, 5e-3f, 3e-3f}, dt));
+    AxisCoreState st{};
+
+    // 5 A is commanded but only 2 A of q current flows (theta_elec = 0, so
+    // q lies along beta) and the rotor stays put.
+    AxisCoreInput in{};
+    in.mode = AxisMode::CurrentIq;
+    in.iq_target = 5.0f;
+    in.v_bus = 24.0f;
+    in.i_abc = {0.0f, std::sqrt(3.0f), -std::sqrt(3.0f)};
+
+    SpeedEstimatorPlan est_plan;
+    ASSERT_TRUE(speed_estimator_plan_build(est_plan, cfg.est, dt));
+    SpeedEstimatorState est{};
+    SpeedEstimatorOutput est_out{};
+    for (int k = 0; k < 200; ++k) {
+        run_axis_core(st, cfg, in, dt);
+        est_out = run_speed_estimator_plan(est, est_plan, SpeedEstimatorInput{in.theta_meas, 2.0f});
+    }
+    EXPECT_NEAR(st.est.tau_load, est_out.tau_load, 1e-4f);
+    EXPECT_NEAR(st.est.lp.y, est_out.w_filtered, 1e-4f);
+}
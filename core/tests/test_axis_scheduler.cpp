@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "axis_scheduler.hpp"
+
+TEST(AxisScheduler, IdenticalAxesSpreadOneOuterLoopPerSlot) {
+    const int n = 8;
+    SchedAxisLoad axes[n];
+    for (int a = 0; a < n; ++a) {
+        axes[a] = SchedAxisLoad{8, 8, 100.0f, 300.0f, 200.0f};
+    }
+
+    uint16_t phases[n];
+    SchedReport rep{};
+    bool ok = plan_axis_schedule(axes, n, SchedConfig{5000.0f, 0.1f}, phases, rep);
+
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(rep.hyperperiod_ok);
+    EXPECT_EQ(rep.n_slots, 8);
+    for (int s = 0; s < rep.n_slots; ++s) {
+        EXPECT_FLOAT_EQ(rep.slot_ns[s], n * 100.0f + 500.0f);
+    }
+    EXPECT_FLOAT_EQ(rep.worst_ns, 1300.0f);
+    EXPECT_NEAR(rep.worst_utilization, 1300.0f / 5000.0f, 1e-6f);
+
+    bool used[n] = {};
+    for (int a = 0; a < n; ++a) {
+        ASSERT_LT(phases[a], 8);
+        EXPECT_FALSE(used[phases[a]]);
+        used[phases[a]] = true;
+    }
+}
+
+TEST(AxisScheduler, SplitsSpeedAndPositionSlots) {
+    // One axis: speed every 2 ticks, position every 4. Phases keep the
+    // schedule aligned so the position slot coincides with a speed slot.
+    SchedAxisLoad axis{2, 4, 0.0f, 100.0f, 100.0f};
+    uint16_t phase = 0;
+    SchedReport rep{};
+    plan_axis_schedule(&axis, 1, SchedConfig{1000.0f, 0.0f}, &phase, rep);
+
+    EXPECT_EQ(rep.n_slots, 4);
+    float sum = 0.0f;
+    for (int s = 0; s < rep.n_slots; ++s) sum += rep.slot_ns[s];
+    EXPECT_FLOAT_EQ(sum, 2 * 100.0f + 100.0f);
+    EXPECT_FLOAT_EQ(rep.worst_ns, 200.0f);
+}
+
+TEST(AxisScheduler, HeavyAxesGoToDifferentSlots) {
+    SchedAxisLoad axes[4] = {
+        {4, 4, 50.0f, 1000.0f, 0.0f},
+        {4, 4, 50.0f, 1000.0f, 0.0f},
+        {4, 4, 50.0f, 100.0f, 0.0f},
+        {4, 4, 50.0f, 100.0f, 0.0f},
+    };
+    uint16_t phases[4];
+    SchedReport rep{};
+    plan_axis_schedule(axes, 4, SchedConfig{2000.0f, 0.0f}, phases, rep);
+
+    EXPECT_NE(phases[0], phases[1]);
+    EXPECT_FLOAT_EQ(rep.worst_ns, 200.0f + 1000.0f);
+}
+
+TEST(AxisScheduler, FlagsMissedDeadline) {
+    SchedAxisLoad axes[2] = {
+        {1, 1, 500.0f, 400.0f, 400.0f},
+        {1, 1, 500.0f, 400.0f, 400.0f},
+    };
+    uint16_t phases[2];
+    SchedReport rep{};
+    bool ok = plan_axis_schedule(axes, 2, SchedConfig{2500.0f, 0.1f}, phases, rep);
+
+    EXPECT_FALSE(ok);
+    EXPECT_TRUE(rep.hyperperiod_ok);
+    EXPECT_FALSE(rep.deadline_met);
+    EXPECT_GT(rep.worst_utilization, 0.9f);
+}
+
+TEST(AxisScheduler, RejectsOversizedHyperperiod) {
+    SchedAxisLoad axes[2] = {
+        {7, 7, 0.0f, 1.0f, 1.0f},
+        {11, 11, 0.0f, 1.0f, 1.0f},
+    };
+    uint16_t phases[2];
+    SchedReport rep{};
+    EXPECT_FALSE(plan_axis_schedule(axes, 2, SchedConfig{1000.0f, 0.0f}, phases, rep));
+    EXPECT_FALSE(rep.hyperperiod_ok);
+}
+
+TEST(AxisScheduler, PlannedPhasesMatchMultirateFiring) {
+    const int n = 6;
+    SchedAxisLoad axes[n];
+    for (int a = 0; a < n; ++a) {
+        axes[a] = SchedAxisLoad{3, 6, 10.0f, 100.0f, 50.0f};
+    }
+    uint16_t phases[n];
+    SchedReport rep{};
+    plan_axis_schedule(axes, n, SchedConfig{10000.0f, 0.0f}, phases, rep);
+
+    MultirateState st[n]{};
+    for (int k = 0; k < rep.n_slots * 3; ++k) {
+        float ns = 0.0f;
+        for (int a = 0; a < n; ++a) {
+            MultirateDue due = multirate_tick(st[a], sched_multirate_config(axes[a], phases[a]), false);
+            ns += axes[a].tick_ns;
+            if (due.spd) ns += axes[a].spd_ns;
+            if (due.pos) ns += axes[a].pos_ns;
+        }
+        EXPECT_FLOAT_EQ(ns, rep.slot_ns[k % rep.n_slots]);
+    }
+}
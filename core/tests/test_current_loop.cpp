@@ -5,8 +5,8 @@
 TEST(CurrentLoop, ZeroBusGivesZeroOutput) {
     CurrentLoopConfig cfg{0.8f};
     CurrentLoopState st{};
-    st.id = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.id = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     CurrentLoopInput in{};
     in.i_meas = {0.0f, 0.0f};
@@ -21,8 +21,8 @@ TEST(CurrentLoop, ZeroBusGivesZeroOutput) {
 TEST(CurrentLoop, ZeroModRadiusGivesZeroOutput) {
     CurrentLoopConfig cfg{0.0f};
     CurrentLoopState st{};
-    st.id = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.id = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     CurrentLoopInput in{};
     in.i_meas = {0.0f, 0.0f};
@@ -37,8 +37,8 @@ TEST(CurrentLoop, ZeroModRadiusGivesZeroOutput) {
 TEST(CurrentLoop, ZeroErrorGivesZeroOutput) {
     CurrentLoopConfig cfg{0.8f};
     CurrentLoopState st{};
-    st.id = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.id = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     CurrentLoopInput in{};
     in.i_meas = {1.0f, -2.0f};
@@ -53,8 +53,8 @@ TEST(CurrentLoop, ZeroErrorGivesZeroOutput) {
 TEST(CurrentLoop, SimpleProportionalIqResponse) {
     CurrentLoopConfig cfg{1.0f};
     CurrentLoopState st{};
-    st.id = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.iq = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
 
     CurrentLoopInput in{};
     in.i_meas = {0.0f, 0.0f};
@@ -69,8 +69,8 @@ TEST(CurrentLoop, SimpleProportionalIqResponse) {
 TEST(CurrentLoop, SaturatesToModRadiusTimesBus) {
     CurrentLoopConfig cfg{0.5f};
     CurrentLoopState st{};
-    st.id = PI{0.0f, 0.0f, 0.0f, -1000.0f, 1000.0f};
-    st.iq = PI{20.0f, 0.0f, 0.0f, -1000.0f, 1000.0f};
+    cfg.id = PIConfig{0.0f, 0.0f, -1000.0f, 1000.0f};
+    cfg.iq = PIConfig{20.0f, 0.0f, -1000.0f, 1000.0f};
 
     CurrentLoopInput in{};
     in.i_meas = {0.0f, 0.0f};
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "current_sense.hpp"
+
+static CurrentSensePlan make_plan(const CurrentSenseConfig& cfg) {
+    CurrentSensePlan plan;
+    EXPECT_TRUE(current_sense_plan_build(plan, cfg));
+    return plan;
+}
+
+TEST(CurrentSense, ZeroConfigPassesReadingsThrough) {
+    CurrentSensePlan plan = make_plan(CurrentSenseConfig{});
+    CurrentSenseState st{};
+    EXPECT_FALSE(current_sense_calibrating(st, plan));
+
+    PhaseCurrents i = current_sense_correct(st, plan, PhaseCurrents{1.0f, -0.25f, -0.5f});
+    EXPECT_FLOAT_EQ(i.a, 1.0f);
+    EXPECT_FLOAT_EQ(i.b, -0.25f);
+    EXPECT_FLOAT_EQ(i.c, -0.5f);
+}
+
+TEST(CurrentSense, TwoShuntRebuildsPhaseC) {
+    CurrentSenseConfig cfg{};
+    cfg.two_shunt = true;
+    cfg.scale = {1.0f, 2.0f, 0.0f};
+    CurrentSensePlan plan = make_plan(cfg);
+    CurrentSenseState st{};
+
+    // Whatever channel c reads, it is ignored.
+    PhaseCurrents i = current_sense_correct(st, plan, PhaseCurrents{1.0f, 0.5f, 7.0f});
+    EXPECT_FLOAT_EQ(i.a, 1.0f);
+    EXPECT_FLOAT_EQ(i.b, 1.0f);
+    EXPECT_FLOAT_EQ(i.c, -2.0f);
+}
+
+TEST(CurrentSense, CalibrationAveragesOffsetsOverWindow) {
+    CurrentSenseConfig cfg{};
+    cfg.scale = {1.1f, 0.0f, 0.0f};
+    cfg.calib_ticks = 4;
+    CurrentSensePlan plan = make_plan(cfg);
+    CurrentSenseState st{};
+
+    const PhaseCurrents zero_reading[4] = {
+        {0.30f, -0.10f, 0.05f}, {0.10f, -0.10f, 0.05f},
+        {0.20f, -0.20f, 0.05f}, {0.20f, -0.20f, 0.05f},
+    };
+    for (const PhaseCurrents& raw : zero_reading) {
+        ASSERT_TRUE(current_sense_calibrating(st, plan));
+        current_sense_calibrate(st, plan, raw);
+    }
+    EXPECT_FALSE(current_sense_calibrating(st, plan));
+    EXPECT_NEAR(st.offset.a, 0.20f, 1e-6f);
+    EXPECT_NEAR(st.offset.b, -0.15f, 1e-6f);
+    EXPECT_NEAR(st.offset.c, 0.05f, 1e-6f);
+
+    PhaseCurrents i = current_sense_correct(st, plan, PhaseCurrents{2.2f, -1.15f, -0.95f});
+    EXPECT_NEAR(i.a, 2.2f, 1e-5f);
+    EXPECT_NEAR(i.b, -1.0f, 1e-5f);
+    EXPECT_NEAR(i.c, -1.0f, 1e-5f);
+
+    current_sense_recalibrate(st);
+    EXPECT_TRUE(current_sense_calibrating(st, plan));
+    EXPECT_FLOAT_EQ(st.offset.a, 0.0f);
+}
+
+TEST(CurrentSense, BuildRejectsNegativeGainButStillFillsPlan) {
+    CurrentSenseConfig cfg{};
+    cfg.scale = {1.0f, -1.0f, 1.0f};
+    cfg.calib_ticks = 10;
+    CurrentSensePlan plan;
+    EXPECT_FALSE(current_sense_plan_build(plan, cfg));
+    EXPECT_EQ(plan.calib_ticks, 10u);
+    EXPECT_FLOAT_EQ(plan.inv_calib, 0.1f);
+}
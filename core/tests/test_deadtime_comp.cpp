@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "deadtime_comp.hpp"
+
+static DeadtimeCompInput make_input(float m, PhaseCurrents i) {
+    DeadtimeCompInput in{};
+    in.m_a = m;
+    in.m_b = m;
+    in.m_c = m;
+    in.i_abc = i;
+    in.v_bus = 24.0f;
+    return in;
+}
+
+TEST(DeadtimeComp, ZeroCompensationPassesThrough) {
+    DeadtimeCompConfig cfg{0.0f, 0.5f};
+    DeadtimeCompOutput out = run_deadtime_comp(cfg, make_input(0.3f, {2.0f, -1.0f, -1.0f}));
+    EXPECT_FLOAT_EQ(out.m_a, 0.3f);
+    EXPECT_FLOAT_EQ(out.m_b, 0.3f);
+    EXPECT_FLOAT_EQ(out.m_c, 0.3f);
+}
+
+TEST(DeadtimeComp, ShiftsDutyWithCurrentSign) {
+    DeadtimeCompConfig cfg{0.12f, 0.0f};
+    DeadtimeCompOutput out = run_deadtime_comp(cfg, make_input(0.0f, {2.0f, -2.0f, 0.0f}));
+    EXPECT_NEAR(out.m_a,  0.01f, 1e-6f);
+    EXPECT_NEAR(out.m_b, -0.01f, 1e-6f);
+    EXPECT_FLOAT_EQ(out.m_c, 0.0f);
+}
+
+TEST(DeadtimeComp, RampsInsideCurrentBand) {
+    DeadtimeCompConfig cfg{0.12f, 1.0f};
+    DeadtimeCompOutput out = run_deadtime_comp(cfg, make_input(0.0f, {0.5f, -0.25f, 3.0f}));
+    EXPECT_NEAR(out.m_a,  0.005f, 1e-6f);
+    EXPECT_NEAR(out.m_b, -0.0025f, 1e-6f);
+    EXPECT_NEAR(out.m_c,  0.01f, 1e-6f);
+}
+
+TEST(DeadtimeComp, ClampedLegIsLeftAlone) {
+    DeadtimeCompConfig cfg{0.5f, 0.0f};
+    DeadtimeCompInput in = make_input(0.0f, {-2.0f, 2.0f, 2.0f});
+    in.m_a = 1.0f;
+    in.m_b = -1.0f;
+    in.m_c = 0.99f;
+
+    DeadtimeCompOutput out = run_deadtime_comp(cfg, in);
+    EXPECT_FLOAT_EQ(out.m_a, 1.0f);
+    EXPECT_FLOAT_EQ(out.m_b, -1.0f);
+    EXPECT_FLOAT_EQ(out.m_c, 1.0f);
+}
+
+TEST(DeadtimeComp, ZeroBusPassesThrough) {
+    DeadtimeCompConfig cfg{0.5f, 0.0f};
+    DeadtimeCompInput in = make_input(0.2f, {1.0f, 1.0f, 1.0f});
+    in.v_bus = 0.0f;
+
+    DeadtimeCompOutput out = run_deadtime_comp(cfg, in);
+    EXPECT_FLOAT_EQ(out.m_a, 0.2f);
+}
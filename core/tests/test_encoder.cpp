@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "encoder.hpp"
+#include "foc_math.hpp"
+
+TEST(Encoder, BuildRejectsDegenerateConfig) {
+    EncoderConfig cfg{};
+    EXPECT_FALSE(encoder_build(cfg, EncoderType::Incremental, 1, 4, 0, 0.0f));
+    EXPECT_FALSE(encoder_build(cfg, EncoderType::Incremental, 1000, 0, 0, 0.0f));
+    EXPECT_TRUE(encoder_build(cfg, EncoderType::Incremental, 1000, 4, 0, 0.0f));
+
+    EncoderState st{};
+    EncoderOutput out = run_encoder(st, EncoderConfig{}, EncoderInput{});
+    EXPECT_EQ(out.theta_mech, 0);
+}
+
+TEST(Encoder, IncrementalCountsAcrossCounterWrapAndTurns) {
+    EncoderConfig cfg{};
+    ASSERT_TRUE(encoder_build(cfg, EncoderType::Incremental, 4000, 4, 0, 0.0f));
+
+    EncoderState st{};
+    uint16_t count = 65000;
+    EncoderInput in{};
+    in.count = count;
+    run_encoder(st, cfg, in);
+
+    // 25 turns forward in steps of 300 counts, wrapping the 16-bit counter.
+    for (int k = 0; k < 25 * 4000 / 300; ++k) {
+        count = static_cast<uint16_t>(count + 300);
+        in.count = count;
+        run_encoder(st, cfg, in);
+    }
+    count = static_cast<uint16_t>(count + (25 * 4000) % 300 + 1000);
+    in.count = count;
+    EncoderOutput out = run_encoder(st, cfg, in);
+    EXPECT_NEAR(position64_to_rad(out.theta_mech), 25.25f * two_pi_v, 1e-4f);
+
+    // And back past zero.
+    for (int k = 0; k < 26 * 4000 / 500; ++k) {
+        count = static_cast<uint16_t>(count - 500);
+        in.count = count;
+        out = run_encoder(st, cfg, in);
+    }
+    EXPECT_NEAR(position64_to_rad(out.theta_mech), -0.75f * two_pi_v, 1e-4f);
+}
+
+static EncoderInput sincos_sample(uint32_t lines, Position64 theta) {
+    // Quadrature edges at every quarter period, counted from zero.
+    int64_t quarters = (theta >> 32) * 4 * lines
+                     + static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(theta)) * 4 * lines) >> 32);
+    Angle32 phase = static_cast<Angle32>(static_cast<uint64_t>(static_cast<uint32_t>(theta)) * lines);
+    float ph = angle32_to_rad(phase);
+    EncoderInput in{};
+    in.count = static_cast<uint16_t>(quarters);
+    in.sin = std::sin(ph);
+    in.cos = std::cos(ph);
+    return in;
+}
+
+TEST(Encoder, SinCosInterpolatesWithinAPeriod) {
+    const uint32_t lines = 512;
+    EncoderConfig cfg{};
+    ASSERT_TRUE(encoder_build(cfg, EncoderType::SinCos, lines, 4, 0, 0.0f));
+
+    // Counting starts inside the period the encoder powers up in, so the
+    // position is relative to that period's start.
+    EncoderState st{};
+    Position64 theta = position64_from_rad(0.3f);
+    Position64 origin = theta - run_encoder(st, cfg, sincos_sample(lines, theta)).theta_mech;
+
+    // Steps of ~0.37 periods, over several turns, forward then back.
+    const Position64 step = position64_one_turn / lines * 37 / 100;
+    float worst = 0.0f;
+    for (int k = 0; k < 20000; ++k) {
+        theta += k < 12000 ? step : -step;
+        EncoderOutput out = run_encoder(st, cfg, sincos_sample(lines, theta));
+        worst = std::fmax(worst, std::fabs(position64_delta_rad(out.theta_mech + origin, theta)));
+    }
+    // One period is 12 mrad; interpolation gets well below that.
+    EXPECT_LT(worst, 1e-6f);
+}
+
+TEST(Encoder, SinCosToleratesCountEdgeSkew) {
+    const uint32_t lines = 256;
+    EncoderConfig cfg{};
+    ASSERT_TRUE(encoder_build(cfg, EncoderType::SinCos, lines, 4, 0, 0.0f));
+
+    EncoderState st{};
+    Position64 theta = 0;
+    run_encoder(st, cfg, sincos_sample(lines, theta));
+    const Position64 step = position64_one_turn / lines / 10;
+    for (int k = 0; k < 5000; ++k) {
+        theta += step;
+        // Comparator edges late by 1/16 period against the analog phase.
+        EncoderInput in = sincos_sample(lines, theta - position64_one_turn / lines / 16);
+        EncoderInput ideal = sincos_sample(lines, theta);
+        in.sin = ideal.sin;
+        in.cos = ideal.cos;
+        EncoderOutput out = run_encoder(st, cfg, in);
+        ASSERT_LT(std::fabs(position64_delta_rad(out.theta_mech, theta)), 1e-5f) << k;
+    }
+}
+
+TEST(Encoder, ExtrapolatesToPwmCentre) {
+    EncoderConfig cfg{};
+    ASSERT_TRUE(encoder_build(cfg, EncoderType::SinCos, 1024, 4, 0, 0.0f));
+
+    const float w = 400.0f;
+    const int64_t period_ns = 50000;
+    EncoderState st{};
+    EncoderOutput out{};
+    Position64 theta = 0;
+    for (int k = 0; k < 100; ++k) {
+        theta = position64_from_rad(w * k * period_ns * 1e-9f);
+        EncoderInput in = sincos_sample(1024, theta);
+        in.t_sample_ns = k * period_ns;
+        in.t_apply_ns = in.t_sample_ns + period_ns / 2;
+        out = run_encoder(st, cfg, in);
+    }
+    EXPECT_NEAR(out.w, w, 0.1f);
+
+    Position64 at_apply = theta + position64_from_rad(w * 25e-6f);
+    EXPECT_NEAR(position64_delta_rad(out.theta_mech, at_apply), 0.0f, 1e-4f);
+    float elec_true = angle32_to_rad(position64_angle(at_apply) * 4u);
+    EXPECT_NEAR(wrap_pi(out.theta_elec - elec_true), 0.0f, 1e-3f);
+}
+
+TEST(Encoder, ElectricalOffsetIsApplied) {
+    EncoderConfig cfg{};
+    ASSERT_TRUE(encoder_build(cfg, EncoderType::Incremental, 4000, 2, angle32_from_rad(0.5f), 0.0f));
+
+    EncoderState st{};
+    EncoderInput in{};
+    run_encoder(st, cfg, in);
+    in.count = 100;  // 1/40 turn mechanical, 1/20 electrical
+    EncoderOutput out = run_encoder(st, cfg, in);
+    EXPECT_NEAR(out.theta_elec, 0.5f + two_pi_v / 20.0f, 1e-5f);
+}
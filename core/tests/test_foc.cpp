@@ -6,8 +6,8 @@ TEST(Foc, ZeroCurrentsAndZeroSetpointGivesZeroOutput) {
     cfg.loop.mod_radius = 0.8f;
 
     FocState st{};
-    st.loop.id = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.loop.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.loop.id = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     FocInput in{};
     in.i_abc = {0.0f, 0.0f, 0.0f};
@@ -28,8 +28,8 @@ TEST(Foc, PureIqSetpointAtZeroAngleProducesBetaVoltageOnly) {
     cfg.loop.mod_radius = 1.0f;
 
     FocState st{};
-    st.loop.id = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.loop.iq = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.loop.id = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.loop.iq = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
 
     FocInput in{};
     in.i_abc = {0.0f, 0.0f, 0.0f};
@@ -48,8 +48,8 @@ TEST(Foc, SaturatesToModRadiusTimesBusInQAxis) {
     cfg.loop.mod_radius = 0.5f;
 
     FocState st{};
-    st.loop.id = PI{0.0f, 0.0f, 0.0f, -1000.0f, 1000.0f};
-    st.loop.iq = PI{20.0f, 0.0f, 0.0f, -1000.0f, 1000.0f};
+    cfg.loop.id = PIConfig{0.0f, 0.0f, -1000.0f, 1000.0f};
+    cfg.loop.iq = PIConfig{20.0f, 0.0f, -1000.0f, 1000.0f};
 
     FocInput in{};
     in.i_abc = {0.0f, 0.0f, 0.0f};
@@ -70,8 +70,8 @@ TEST(Foc, ZeroBusVoltageYieldsZeroVoltageButValidCurrents) {
     cfg.loop.mod_radius = 0.8f;
 
     FocState st{};
-    st.loop.id = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
-    st.loop.iq = PI{1.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.loop.id = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
+    cfg.loop.iq = PIConfig{1.0f, 0.0f, -100.0f, 100.0f};
 
     FocInput in{};
     in.i_abc = {1.0f, -0.5f, -0.5f};
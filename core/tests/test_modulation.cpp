@@ -57,4 +57,149 @@ TEST(Modulation, LargeVectorTriggersSaturationAndClamp) {
 
     EXPECT_NEAR(max_abs, 1.0f, 1e-5f);
     EXPECT_TRUE(out.saturated);
-}
\ No newline at end of file
+}
+
+static float line_ab(const ModulationOutput& m) { return m.m_a - m.m_b; }
+static float line_bc(const ModulationOutput& m) { return m.m_b - m.m_c; }
+
+static int clamped_legs(const ModulationOutput& m) {
+    int n = 0;
+    if (std::fabs(m.m_a) >= 1.0f - 1e-6f) ++n;
+    if (std::fabs(m.m_b) >= 1.0f - 1e-6f) ++n;
+    if (std::fabs(m.m_c) >= 1.0f - 1e-6f) ++n;
+    return n;
+}
+
+TEST(Modulation, DpwmModesClampOneLegAndKeepLineVoltages) {
+    const ModulationMode modes[] = {
+        ModulationMode::Dpwm60,
+        ModulationMode::Dpwm120High,
+        ModulationMode::Dpwm120Low,
+    };
+
+    float v_bus = 24.0f;
+    for (ModulationMode mode : modes) {
+        for (int k = 0; k < 36; ++k) {
+            float th = two_pi_v * k / 36.0f;
+            ModulationInput in{};
+            in.v_ab = {0.4f * v_bus * std::cos(th), 0.4f * v_bus * std::sin(th)};
+            in.v_bus = v_bus;
+
+            ModulationOutput ref = run_modulation(in);
+            ModulationOutput out = run_modulation(ModulationConfig{mode}, in);
+
+            EXPECT_NEAR(line_ab(out), line_ab(ref), 1e-5f);
+            EXPECT_NEAR(line_bc(out), line_bc(ref), 1e-5f);
+            EXPECT_GE(clamped_legs(out), 1);
+            EXPECT_FALSE(out.saturated);
+        }
+    }
+}
+
+TEST(Modulation, Dpwm120ClampsToSelectedRail) {
+    ModulationInput in{};
+    in.v_ab = {3.0f, 2.0f};
+    in.v_bus = 24.0f;
+
+    ModulationOutput hi = run_modulation(ModulationConfig{ModulationMode::Dpwm120High}, in);
+    ModulationOutput lo = run_modulation(ModulationConfig{ModulationMode::Dpwm120Low}, in);
+
+    float hi_max = std::fmax(hi.m_a, std::fmax(hi.m_b, hi.m_c));
+    float lo_min = std::fmin(lo.m_a, std::fmin(lo.m_b, lo.m_c));
+    EXPECT_FLOAT_EQ(hi_max, 1.0f);
+    EXPECT_FLOAT_EQ(lo_min, -1.0f);
+}
+
+static float line_ab_fundamental(ModulationMode mode, float v_mag, float v_bus) {
+    const int n = 360;
+    float re = 0.0f;
+    float im = 0.0f;
+    for (int k = 0; k < n; ++k) {
+        float th = two_pi_v * k / n;
+        ModulationInput in{};
+        in.v_ab = {v_mag * std::cos(th), v_mag * std::sin(th)};
+        in.v_bus = v_bus;
+        ModulationOutput out = run_modulation(ModulationConfig{mode}, in);
+        float v = line_ab(out) * 0.5f * v_bus;
+        re += v * std::cos(th);
+        im += v * std::sin(th);
+    }
+    return 2.0f * std::sqrt(re * re + im * im) / n;
+}
+
+TEST(Modulation, OvermodExceedsLinearLineVoltage) {
+    float v_bus = 10.0f;
+    float lin = line_ab_fundamental(ModulationMode::Svpwm, 2.0f * v_bus, v_bus);
+    float ovm = line_ab_fundamental(ModulationMode::Overmod, 2.0f * v_bus, v_bus);
+
+    // Radial clipping traces the hexagon, a little above the v_bus inscribed
+    // circle; six-step is 2*sqrt(3)/pi * v_bus.
+    EXPECT_GE(lin, v_bus);
+    EXPECT_GT(ovm, 1.03f * lin);
+    EXPECT_LE(ovm, 2.0f * sqrt3_v / pi_v * v_bus + 1e-3f);
+}
+
+TEST(Modulation, OvermodMatchesSvpwmInsideHexagon) {
+    ModulationInput in{};
+    in.v_ab = {4.0f, -3.0f};
+    in.v_bus = 24.0f;
+
+    ModulationOutput ref = run_modulation(in);
+    ModulationOutput ovm = run_modulation(ModulationConfig{ModulationMode::Overmod}, in);
+    EXPECT_FLOAT_EQ(ovm.m_a, ref.m_a);
+    EXPECT_FLOAT_EQ(ovm.m_b, ref.m_b);
+    EXPECT_FLOAT_EQ(ovm.m_c, ref.m_c);
+    EXPECT_FALSE(ovm.saturated);
+}
+
+TEST(Modulation, ModulatorMatchesReferenceDuties) {
+    const ModulationMode modes[] = {
+        ModulationMode::Svpwm,
+        ModulationMode::Dpwm60,
+        ModulationMode::Dpwm120High,
+        ModulationMode::Dpwm120Low,
+        ModulationMode::Overmod,
+    };
+    const float mags[] = {0.0f, 0.1f, 0.5f, 0.577f, 0.7f, 1.5f};
+
+    for (float v_bus : {12.0f, 24.0f, 48.0f}) {
+        ModulatorState mod{};
+        modulator_set_vbus(mod, v_bus);
+        for (ModulationMode mode : modes) {
+            for (float mag : mags) {
+                for (int k = 0; k < 72; ++k) {
+                    float th = two_pi_v * k / 72.0f;
+                    ModulationInput in{};
+                    in.v_ab = {mag * v_bus * std::cos(th), mag * v_bus * std::sin(th)};
+                    in.v_bus = v_bus;
+
+                    ModulationOutput ref = run_modulation(ModulationConfig{mode}, in);
+                    ModulationOutput out = run_modulator(mod, ModulationConfig{mode}, in.v_ab);
+                    // A reciprocal multiply may differ from the division by an ulp.
+                    EXPECT_NEAR(out.m_a, ref.m_a, 2e-6f);
+                    EXPECT_NEAR(out.m_b, ref.m_b, 2e-6f);
+                    EXPECT_NEAR(out.m_c, ref.m_c, 2e-6f);
+                    EXPECT_EQ(out.saturated, ref.saturated);
+                }
+            }
+        }
+    }
+}
+
+TEST(Modulation, ModulatorRefreshesScaleOnlyOnBusChange) {
+    ModulatorState mod{};
+    ModulationOutput out = run_modulator(mod, ModulationConfig{}, AlphaBeta{1.0f, 0.0f});
+    EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+
+    modulator_set_vbus(mod, 20.0f);
+    EXPECT_FLOAT_EQ(mod.inv_half_vbus, 0.1f);
+
+    mod.inv_half_vbus = 0.5f;
+    modulator_set_vbus(mod, 20.0f);
+    EXPECT_FLOAT_EQ(mod.inv_half_vbus, 0.5f);
+
+    modulator_set_vbus(mod, -1.0f);
+    out = run_modulator(mod, ModulationConfig{}, AlphaBeta{1.0f, 0.0f});
+    EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+    EXPECT_FALSE(out.saturated);
+}
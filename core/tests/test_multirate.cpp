@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "multirate.hpp"
+
+TEST(Multirate, DefaultConfigFiresEveryTick) {
+    MultirateConfig cfg{};
+    MultirateState st{};
+    for (int k = 0; k < 10; ++k) {
+        MultirateDue due = multirate_tick(st, cfg, false);
+        EXPECT_TRUE(due.est);
+        EXPECT_TRUE(due.spd);
+        EXPECT_TRUE(due.pos);
+    }
+}
+
+TEST(Multirate, DecimatesByRatio) {
+    MultirateConfig cfg{4, 8, 0};
+    MultirateState st{};
+    for (int k = 0; k < 32; ++k) {
+        MultirateDue due = multirate_tick(st, cfg, false);
+        EXPECT_EQ(due.spd, k % 4 == 0);
+        EXPECT_EQ(due.est, k % 4 == 0);
+        EXPECT_EQ(due.pos, k % 8 == 0);
+    }
+}
+
+TEST(Multirate, PhaseDelaysFirstFiring) {
+    MultirateConfig cfg{4, 8, 3};
+    MultirateState st{};
+    for (int k = 0; k < 32; ++k) {
+        MultirateDue due = multirate_tick(st, cfg, false);
+        EXPECT_EQ(due.spd, k % 4 == 3);
+        EXPECT_EQ(due.pos, k % 8 == 3);
+    }
+}
+
+TEST(Multirate, RestartFiresWithoutMovingSchedule) {
+    MultirateConfig cfg{4, 4, 0};
+    MultirateState st{};
+    for (int k = 0; k < 12; ++k) {
+        MultirateDue due = multirate_tick(st, cfg, k == 6);
+        EXPECT_EQ(due.spd, k % 4 == 0 || k == 6);
+        EXPECT_EQ(due.pos, k % 4 == 0 || k == 6);
+        EXPECT_EQ(due.est, k % 4 == 0);
+        EXPECT_EQ(due.spd_hold, k == 6);
+        EXPECT_EQ(due.pos_hold, k == 6);
+    }
+}
+
+TEST(Multirate, RestartOnSlotIsNotAHold) {
+    MultirateConfig cfg{4, 8, 0};
+    MultirateState st{};
+    for (int k = 0; k < 9; ++k) {
+        MultirateDue due = multirate_tick(st, cfg, k == 4);
+        EXPECT_FALSE(due.spd_hold) << k;
+        EXPECT_EQ(due.pos_hold, k == 4) << k;
+    }
+}
+
+TEST(Multirate, StaggeredAxesFlattenOuterLoopLoad) {
+    const int n_axes = 16;
+    const uint16_t div = 8;
+
+    MultirateState st[n_axes]{};
+    MultirateConfig cfg[n_axes]{};
+    for (int a = 0; a < n_axes; ++a) {
+        cfg[a] = MultirateConfig{div, div, multirate_stagger_phase(a, n_axes, div)};
+    }
+
+    for (int k = 0; k < 64; ++k) {
+        int fired = 0;
+        for (int a = 0; a < n_axes; ++a) {
+            fired += multirate_tick(st[a], cfg[a], false).spd ? 1 : 0;
+        }
+        EXPECT_EQ(fired, n_axes / div);
+    }
+}
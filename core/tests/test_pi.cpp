@@ -80,3 +80,55 @@ TEST(PiController, ResetSetsIntegral) {
     float u = pi.update(0.0f, 0.1f);
     EXPECT_FLOAT_EQ(u, 3.0f);
 }
+
+TEST(PiController, SplitStateMatchesCombinedController) {
+    PI pi{1.5f, 20.0f, 0.0f, -4.0f, 4.0f};
+    PIConfig cfg{1.5f, 20.0f, -4.0f, 4.0f};
+    PIState st{};
+    for (int k = 0; k < 200; ++k) {
+        float err = (k % 50 < 25) ? 1.0f : -0.5f;
+        EXPECT_FLOAT_EQ(pi_update(st, cfg, err, 0.01f), pi.update(err, 0.01f));
+        EXPECT_FLOAT_EQ(st.integral, pi.integral);
+    }
+}
+
+TEST(PiController, ClampModeIgnoresDownstreamLimit) {
+    PIConfig cfg{1.0f, 10.0f, -10.0f, 10.0f};
+    PIState st{5.0f};
+    pi_antiwindup(st, cfg, 1.0f, 8.0f, 3.0f, 0.01f);
+    EXPECT_FLOAT_EQ(st.integral, 5.0f);
+}
+
+TEST(PiController, BackCalculationBleedsIntegralTowardAppliedOutput) {
+    PIConfig cfg{1.0f, 10.0f, -10.0f, 10.0f, AntiWindup::BackCalculation, 20.0f};
+    PIState st{5.0f};
+    pi_antiwindup(st, cfg, 1.0f, 8.0f, 3.0f, 0.01f);
+    EXPECT_FLOAT_EQ(st.integral, 5.0f + 20.0f * (3.0f - 8.0f) * 0.01f);
+
+    // kb = 0 falls back to ki / kp.
+    cfg.kb = 0.0f;
+    st.integral = 5.0f;
+    pi_antiwindup(st, cfg, 1.0f, 8.0f, 3.0f, 0.01f);
+    EXPECT_FLOAT_EQ(st.integral, 5.0f + 10.0f * (3.0f - 8.0f) * 0.01f);
+}
+
+TEST(PiController, ConditionalIntegrationStopsOnlyWhenPushingIntoLimit) {
+    PIConfig cfg{1.0f, 10.0f, -10.0f, 10.0f, AntiWindup::Conditional, 0.0f};
+    PIState st{};
+    float u = pi_update(st, cfg, 2.0f, 0.01f);
+    pi_antiwindup(st, cfg, 2.0f, u, 1.0f, 0.01f);
+    EXPECT_FLOAT_EQ(st.integral, 0.0f);
+
+    // Error of opposite sign to the clipped excess keeps integrating.
+    st.integral = 3.0f;
+    u = pi_update(st, cfg, -2.0f, 0.01f);
+    pi_antiwindup(st, cfg, -2.0f, u, -0.5f, 0.01f);
+    EXPECT_FLOAT_EQ(st.integral, 3.0f - 10.0f * 2.0f * 0.01f);
+}
+
+TEST(PiController, PreloadMakesNextOutputMatch) {
+    PIConfig cfg{2.0f, 50.0f, -10.0f, 10.0f};
+    PIState st{};
+    pi_preload(st, cfg, 4.0f, 0.3f, 0.001f);
+    EXPECT_NEAR(pi_update(st, cfg, 0.3f, 0.001f), 4.0f, 1e-6f);
+}
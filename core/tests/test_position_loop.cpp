@@ -5,11 +5,11 @@
 TEST(PositionLoop, ZeroGainsAlwaysZeroSpeed) {
     PositionLoopConfig cfg{-100.0f, 100.0f};
     PositionLoopState st{};
-    st.pos_pi = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos_pi = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
 
     PositionLoopInput in{};
-    in.theta_meas = 1.0f;
-    in.theta_setpoint = 3.0f;
+    in.theta_meas = position64_from_rad(1.0f);
+    in.theta_setpoint = position64_from_rad(3.0f);
 
     for (int k = 0; k < 10; ++k) {
         PositionLoopOutput out = run_position_loop(st, cfg, in, 0.001f);
@@ -21,14 +21,14 @@ TEST(PositionLoop, ZeroGainsAlwaysZeroSpeed) {
 TEST(PositionLoop, PureProportionalResponse) {
     PositionLoopConfig cfg{-100.0f, 100.0f};
     PositionLoopState st{};
-    st.pos_pi = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
 
     PositionLoopInput in{};
-    in.theta_meas = 1.0f;
-    in.theta_setpoint = 3.0f;
+    in.theta_meas = position64_from_rad(1.0f);
+    in.theta_setpoint = position64_from_rad(3.0f);
 
     PositionLoopOutput out = run_position_loop(st, cfg, in, 0.001f);
-    float err = wrap_pi(in.theta_setpoint - in.theta_meas);
+    float err = position64_delta_rad(in.theta_setpoint, in.theta_meas);
     EXPECT_FLOAT_EQ(out.w_cmd, 2.0f * err);
     EXPECT_FLOAT_EQ(st.pos_pi.integral, 0.0f);
 }
@@ -36,11 +36,11 @@ TEST(PositionLoop, PureProportionalResponse) {
 TEST(PositionLoop, IntegralAccumulation) {
     PositionLoopConfig cfg{-100.0f, 100.0f};
     PositionLoopState st{};
-    st.pos_pi = PI{0.0f, 10.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos_pi = PIConfig{0.0f, 10.0f, -100.0f, 100.0f};
 
     PositionLoopInput in{};
-    in.theta_meas = 0.0f;
-    in.theta_setpoint = 1.0f;
+    in.theta_meas = position64_from_rad(0.0f);
+    in.theta_setpoint = position64_from_rad(1.0f);
 
     float dt = 0.001f;
     int steps = 1000;
@@ -48,7 +48,7 @@ TEST(PositionLoop, IntegralAccumulation) {
         run_position_loop(st, cfg, in, dt);
     }
 
-    float err = wrap_pi(in.theta_setpoint - in.theta_meas);
+    float err = position64_delta_rad(in.theta_setpoint, in.theta_meas);
     float expected = 10.0f * err * dt * steps;
     EXPECT_NEAR(st.pos_pi.integral, expected, 5e-3f);
 }
@@ -56,11 +56,11 @@ TEST(PositionLoop, IntegralAccumulation) {
 TEST(PositionLoop, OutputClampedToMax) {
     PositionLoopConfig cfg{-5.0f, 5.0f};
     PositionLoopState st{};
-    st.pos_pi = PI{50.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos_pi = PIConfig{50.0f, 0.0f, -100.0f, 100.0f};
 
     PositionLoopInput in{};
-    in.theta_meas = 0.0f;
-    in.theta_setpoint = 1.0f;
+    in.theta_meas = position64_from_rad(0.0f);
+    in.theta_setpoint = position64_from_rad(1.0f);
 
     PositionLoopOutput out = run_position_loop(st, cfg, in, 0.001f);
     EXPECT_FLOAT_EQ(out.w_cmd, 5.0f);
@@ -69,27 +69,46 @@ TEST(PositionLoop, OutputClampedToMax) {
 TEST(PositionLoop, OutputClampedToMin) {
     PositionLoopConfig cfg{-5.0f, 5.0f};
     PositionLoopState st{};
-    st.pos_pi = PI{50.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos_pi = PIConfig{50.0f, 0.0f, -100.0f, 100.0f};
 
     PositionLoopInput in{};
-    in.theta_meas = 1.0f;
-    in.theta_setpoint = 0.0f;
+    in.theta_meas = position64_from_rad(1.0f);
+    in.theta_setpoint = position64_from_rad(0.0f);
 
     PositionLoopOutput out = run_position_loop(st, cfg, in, 0.001f);
     EXPECT_FLOAT_EQ(out.w_cmd, -5.0f);
 }
 
-TEST(PositionLoop, UsesShortestWrappedError) {
+TEST(PositionLoop, ErrorSpansWholeTurns) {
     PositionLoopConfig cfg{-100.0f, 100.0f};
     PositionLoopState st{};
-    st.pos_pi = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.pos_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
 
+    // Same angle within the turn, three turns apart: no wrap to zero error.
     PositionLoopInput in{};
-    in.theta_meas = two_pi_v - 0.1f;
-    in.theta_setpoint = 0.0f;
+    in.theta_meas = 1000 * position64_one_turn + position64_from_rad(0.1f);
+    in.theta_setpoint = in.theta_meas + 3 * position64_one_turn;
 
     PositionLoopOutput out = run_position_loop(st, cfg, in, 0.001f);
-    float err = wrap_pi(in.theta_setpoint - in.theta_meas);
-    EXPECT_NEAR(err, 0.1f, 1e-4f);
-    EXPECT_NEAR(out.w_cmd, 2.0f * 0.1f, 1e-3f);
+    EXPECT_NEAR(out.err, 3.0f * two_pi_v, 1e-4f);
+    EXPECT_NEAR(out.w_cmd, 2.0f * 3.0f * two_pi_v, 1e-3f);
+}
+
+TEST(PositionLoop, VelocityFeedforwardAddsToPI) {
+    PositionLoopConfig cfg{-100.0f, 100.0f};
+    PositionLoopState st{};
+    cfg.pos_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+    cfg.kff_vel = 1.0f;
+
+    PositionLoopInput in{};
+    in.theta_meas = position64_from_rad(0.0f);
+    in.theta_setpoint = position64_from_rad(0.5f);
+    in.w_ff = 3.0f;
+
+    PositionLoopOutput out = run_position_loop(st, cfg, in, 0.001f);
+    EXPECT_FLOAT_EQ(out.w_cmd, 2.0f * 0.5f + 3.0f);
+
+    cfg.kff_vel = 0.0f;
+    out = run_position_loop(st, cfg, in, 0.001f);
+    EXPECT_FLOAT_EQ(out.w_cmd, 2.0f * 0.5f);
 }
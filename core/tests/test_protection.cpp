@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "protection.hpp"
+
+static ProtectionPlan make_plan(const ProtectionConfig& cfg, float dt = 1e-3f) {
+    ProtectionPlan plan;
+    EXPECT_TRUE(protection_plan_build(plan, cfg, dt));
+    return plan;
+}
+
+TEST(Protection, ZeroConfigChecksNothing) {
+    ProtectionPlan plan = make_plan(ProtectionConfig{});
+    ProtectionState st{};
+    ProtectionInput in{{1e3f, -5e2f, -5e2f}, 1e4f, 1e3f, 1e3f};
+    for (int k = 0; k < 100; ++k) {
+        EXPECT_EQ(run_protection_plan(st, plan, in), 0u);
+    }
+}
+
+TEST(Protection, OvercurrentTripsOnAnySinglePhase) {
+    ProtectionConfig cfg{};
+    cfg.i_phase_max = 10.0f;
+    ProtectionPlan plan = make_plan(cfg);
+
+    ProtectionState st{};
+    EXPECT_EQ(run_protection_plan(st, plan, ProtectionInput{{9.9f, -5.0f, -4.9f}}), 0u);
+    EXPECT_EQ(run_protection_plan(st, plan, ProtectionInput{{5.0f, 5.1f, -10.1f}}),
+              axis_fault_overcurrent);
+
+    // Latched until cleared, even once the current is back in range.
+    EXPECT_EQ(run_protection_plan(st, plan, ProtectionInput{}), axis_fault_overcurrent);
+    protection_clear(st);
+    EXPECT_EQ(run_protection_plan(st, plan, ProtectionInput{}), 0u);
+}
+
+TEST(Protection, I2tTripsAfterBudgetAndNotAtRatedCurrent) {
+    ProtectionConfig cfg{};
+    cfg.i_rated = 5.0f;
+    cfg.i2t_limit = 75.0f;  // 2x rated (100 - 25 A^2) for 1 s
+    const float dt = 1e-3f;
+    ProtectionPlan plan = make_plan(cfg, dt);
+
+    // Rated current forever: no trip.
+    ProtectionState st{};
+    ProtectionInput rated{{5.0f, -2.5f, -2.5f}};
+    for (int k = 0; k < 5000; ++k) {
+        ASSERT_EQ(run_protection_plan(st, plan, rated), 0u);
+    }
+
+    ProtectionInput twice{{10.0f, -5.0f, -5.0f}};
+    int trip_tick = -1;
+    for (int k = 0; k < 2000 && trip_tick < 0; ++k) {
+        if (run_protection_plan(st, plan, twice) & axis_fault_i2t) {
+            trip_tick = k;
+        }
+    }
+    EXPECT_NEAR(trip_tick * dt, 1.0f, 0.01f);
+
+    // Clearing keeps the heat: the next overload trips at once.
+    protection_clear(st);
+    EXPECT_EQ(run_protection_plan(st, plan, twice), axis_fault_i2t);
+}
+
+TEST(Protection, FollowingErrorWindow) {
+    ProtectionConfig cfg{};
+    cfg.follow_err_max = 0.1f;
+    ProtectionPlan plan = make_plan(cfg);
+
+    ProtectionState st{};
+    ProtectionInput in{};
+    in.follow_err = -0.09f;
+    EXPECT_EQ(run_protection_plan(st, plan, in), 0u);
+    in.follow_err = -0.11f;
+    EXPECT_EQ(run_protection_plan(st, plan, in), axis_fault_following);
+}
+
+TEST(Protection, StallNeedsSustainedTorqueWithoutMotion) {
+    ProtectionConfig cfg{};
+    cfg.stall_iq = 2.0f;
+    cfg.stall_w = 0.5f;
+    cfg.stall_time = 0.1f;
+    ProtectionPlan plan = make_plan(cfg, 1e-3f);
+    EXPECT_EQ(plan.stall_ticks, 100u);
+
+    ProtectionState st{};
+    ProtectionInput stuck{};
+    stuck.iq_cmd = -3.0f;
+    stuck.w_meas = 0.1f;
+    ProtectionInput moving = stuck;
+    moving.w_meas = 1.0f;
+
+    // Motion in between restarts the timer.
+    for (int k = 0; k < 99; ++k) {
+        ASSERT_EQ(run_protection_plan(st, plan, stuck), 0u);
+    }
+    EXPECT_EQ(run_protection_plan(st, plan, moving), 0u);
+    for (int k = 0; k < 99; ++k) {
+        ASSERT_EQ(run_protection_plan(st, plan, stuck), 0u);
+    }
+    EXPECT_EQ(run_protection_plan(st, plan, stuck), axis_fault_stall);
+}
+
+TEST(Protection, OverspeedAndCombinedFaults) {
+    ProtectionConfig cfg{};
+    cfg.w_max = 100.0f;
+    cfg.i_phase_max = 10.0f;
+    ProtectionPlan plan = make_plan(cfg);
+
+    ProtectionState st{};
+    ProtectionInput in{};
+    in.w_meas = -101.0f;
+    EXPECT_EQ(run_protection_plan(st, plan, in), axis_fault_overspeed);
+    in.i_abc = {20.0f, -10.0f, -10.0f};
+    EXPECT_EQ(run_protection_plan(st, plan, in), axis_fault_overspeed | axis_fault_overcurrent);
+}
+
+TEST(Protection, RejectsNegativeThresholdsAndI2tWithoutBudget) {
+    ProtectionPlan plan;
+    ProtectionConfig cfg{};
+    cfg.i_phase_max = -1.0f;
+    EXPECT_FALSE(protection_plan_build(plan, cfg, 1e-3f));
+
+    cfg = ProtectionConfig{};
+    cfg.i_rated = 5.0f;
+    EXPECT_FALSE(protection_plan_build(plan, cfg, 1e-3f));
+}
@@ -5,11 +5,10 @@
 TEST(SpeedEstimator, InitializesToZero) {
     SpeedEstimatorConfig cfg{{0.5f}};
     SpeedEstimatorState st{};
-    st.initialized = false;
     st.lp.initialized = false;
 
     SpeedEstimatorInput in{};
-    in.theta_meas = 1.0f;
+    in.theta_meas = position64_from_rad(1.0f);
 
     SpeedEstimatorOutput out = run_speed_estimator(st, cfg, in, 0.001f);
     EXPECT_FLOAT_EQ(out.w_raw, 0.0f);
@@ -19,38 +18,85 @@ TEST(SpeedEstimator, InitializesToZero) {
 TEST(SpeedEstimator, ZeroDtReturnsPreviousValues) {
     SpeedEstimatorConfig cfg{{0.5f}};
     SpeedEstimatorState st{};
-    st.initialized = true;
-    st.theta_prev = 0.0f;
-    st.w_raw = 3.0f;
+    st.theta_prev = 0;
     st.lp.y = 2.0f;
     st.lp.initialized = true;
 
     SpeedEstimatorInput in{};
-    in.theta_meas = 0.5f;
+    in.theta_meas = position64_from_rad(0.5f);
 
+    // The raw difference is not held, so both outputs report the filter.
     SpeedEstimatorOutput out = run_speed_estimator(st, cfg, in, 0.0f);
-    EXPECT_FLOAT_EQ(out.w_raw, 3.0f);
+    EXPECT_FLOAT_EQ(out.w_raw, 2.0f);
     EXPECT_FLOAT_EQ(out.w_filtered, 2.0f);
+    EXPECT_EQ(st.theta_prev, 0u);
 }
 
 TEST(SpeedEstimator, TracksConstantVelocity) {
     SpeedEstimatorConfig cfg{{0.2f}};
     SpeedEstimatorState st{};
-    st.initialized = false;
     st.lp.initialized = false;
 
     float dt = 0.001f;
     float w_true = 50.0f;
-    float theta = 0.0f;
+    Position64 theta = 0;
+    float w_raw = 0.0f;
 
     for (int i = 0; i < 5000; ++i) {
-        theta = wrap_2pi(theta + w_true * dt);
+        theta += position64_from_rad(w_true * dt);
         SpeedEstimatorInput in{theta};
         SpeedEstimatorOutput out = run_speed_estimator(st, cfg, in, dt);
         if (i > 1000) {
             EXPECT_NEAR(out.w_filtered, w_true, 5.0f);
         }
+        w_raw = out.w_raw;
     }
 
-    EXPECT_NEAR(st.w_raw, w_true, 1.0f);
+    EXPECT_NEAR(w_raw, w_true, 1.0f);
+}
+
+TEST(SpeedEstimator, KalmanBuildRejectsBadModel) {
+    KalmanConfig kf{};
+    EXPECT_FALSE(kalman_build(kf, KalmanModel{0.0f, 0.0f, 0.3f, 1.0f, 0.01f, 1e-3f}, 1e-3f));
+    EXPECT_FALSE(kalman_build(kf, KalmanModel{1e-4f, 0.0f, 0.3f, 1.0f, 0.01f, 0.0f}, 1e-3f));
+    EXPECT_FALSE(kalman_build(kf, KalmanModel{1e-4f, 0.0f, 0.3f, 1.0f, 0.01f, 1e-3f}, 0.0f));
+    EXPECT_FLOAT_EQ(kf.l_theta, 0.0f);
+
+    ASSERT_TRUE(kalman_build(kf, KalmanModel{1e-4f, 1e-3f, 0.3f, 1.0f, 0.01f, 1e-3f}, 1e-3f));
+    EXPECT_GT(kf.l_theta, 0.0f);
+    EXPECT_LT(kf.l_theta, 1.0f);
+    EXPECT_GT(kf.l_w, 0.0f);
+    // A positive innovation means the rotor is ahead of the model, so less
+    // load torque than assumed.
+    EXPECT_LT(kf.l_tau, 0.0f);
+}
+
+TEST(SpeedEstimator, KalmanTracksSpeedAndLoadTorque) {
+    const float J = 1e-4f;
+    const float B = 1e-3f;
+    const float kt = 0.3f;
+    const float dt = 1e-3f;
+    SpeedEstimatorConfig cfg{};
+    cfg.kind = SpeedEstimatorKind::Kalman;
+    ASSERT_TRUE(kalman_build(cfg.kf, KalmanModel{J, B, kt, 1.0f, 0.01f, 1e-3f}, dt));
+
+    SpeedEstimatorState st{};
+    const float iq = 0.5f;
+    const float tau_load = 0.05f;
+    double w = 0.0;
+    double theta = 0.0;
+    SpeedEstimatorOutput out{};
+
+    // The rotor spins up over many turns against a constant load.
+    for (int i = 0; i < 3000; ++i) {
+        theta += w * dt;
+        w += (kt * iq - B * w - tau_load) / J * dt;
+        SpeedEstimatorInput in{position64_from_rad(static_cast<float>(theta)), iq};
+        out = run_speed_estimator(st, cfg, in, dt);
+    }
+
+    EXPECT_GT(theta, 10.0 * two_pi_v);
+    EXPECT_NEAR(out.w_filtered, w, 0.01 * w);
+    EXPECT_NEAR(out.tau_load, tau_load, 0.005f);
+    EXPECT_FLOAT_EQ(st.lp.y, out.w_filtered);
 }
@@ -4,7 +4,7 @@
 TEST(SpeedLoop, ZeroGainsAlwaysZeroIq) {
     SpeedLoopConfig cfg{-100.0f, 100.0f};
     SpeedLoopState st{};
-    st.iq_pi = PI{0.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq_pi = PIConfig{0.0f, 0.0f, -100.0f, 100.0f};
 
     SpeedLoopInput in{};
     in.w_meas = 0.0f;
@@ -20,7 +20,7 @@ TEST(SpeedLoop, ZeroGainsAlwaysZeroIq) {
 TEST(SpeedLoop, PureProportionalResponse) {
     SpeedLoopConfig cfg{-100.0f, 100.0f};
     SpeedLoopState st{};
-    st.iq_pi = PI{2.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
 
     SpeedLoopInput in{};
     in.w_meas = 5.0f;
@@ -34,7 +34,7 @@ TEST(SpeedLoop, PureProportionalResponse) {
 TEST(SpeedLoop, PureIntegralAccumulation) {
     SpeedLoopConfig cfg{-100.0f, 100.0f};
     SpeedLoopState st{};
-    st.iq_pi = PI{0.0f, 10.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq_pi = PIConfig{0.0f, 10.0f, -100.0f, 100.0f};
 
     SpeedLoopInput in{};
     in.w_meas = 0.0f;
@@ -58,7 +58,7 @@ TEST(SpeedLoop, PureIntegralAccumulation) {
 TEST(SpeedLoop, OutputClampedToMax) {
     SpeedLoopConfig cfg{-5.0f, 5.0f};
     SpeedLoopState st{};
-    st.iq_pi = PI{50.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq_pi = PIConfig{50.0f, 0.0f, -100.0f, 100.0f};
 
     SpeedLoopInput in{};
     in.w_meas = 0.0f;
@@ -71,7 +71,7 @@ TEST(SpeedLoop, OutputClampedToMax) {
 TEST(SpeedLoop, OutputClampedToMin) {
     SpeedLoopConfig cfg{-5.0f, 5.0f};
     SpeedLoopState st{};
-    st.iq_pi = PI{50.0f, 0.0f, 0.0f, -100.0f, 100.0f};
+    cfg.iq_pi = PIConfig{50.0f, 0.0f, -100.0f, 100.0f};
 
     SpeedLoopInput in{};
     in.w_meas = 1.0f;
@@ -80,3 +80,35 @@ TEST(SpeedLoop, OutputClampedToMin) {
     SpeedLoopOutput out = run_speed_loop(st, cfg, in, 0.001f);
     EXPECT_FLOAT_EQ(out.iq_cmd, -5.0f);
 }
+
+TEST(SpeedLoop, AccelerationFeedforwardAddsToPI) {
+    SpeedLoopConfig cfg{-100.0f, 100.0f};
+    SpeedLoopState st{};
+    cfg.iq_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+    cfg.kff_acc = 0.01f;
+
+    SpeedLoopInput in{};
+    in.w_meas = 5.0f;
+    in.w_setpoint = 8.0f;
+    in.acc_ff = 100.0f;
+
+    SpeedLoopOutput out = run_speed_loop(st, cfg, in, 0.001f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, 6.0f + 1.0f);
+}
+
+TEST(SpeedLoop, SetpointWeightOnlyScalesProportionalPath) {
+    SpeedLoopConfig cfg{-100.0f, 100.0f};
+    SpeedLoopState st{};
+    cfg.iq_pi = PIConfig{2.0f, 10.0f, -100.0f, 100.0f};
+    cfg.b_cut = 1.0f;
+
+    SpeedLoopInput in{};
+    in.w_meas = 5.0f;
+    in.w_setpoint = 8.0f;
+
+    // I-P form: P acts on -w_meas only, the integral still sees the full error.
+    SpeedLoopOutput out = run_speed_loop(st, cfg, in, 0.001f);
+    EXPECT_FLOAT_EQ(st.iq_pi.integral, 10.0f * 3.0f * 0.001f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, -2.0f * 5.0f + st.iq_pi.integral);
+    EXPECT_FLOAT_EQ(out.err, 3.0f);
+}
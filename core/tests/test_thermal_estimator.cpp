@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "thermal_estimator.hpp"
+
+#include <cmath>
+
+static ThermalEstimatorPlan make_plan(const ThermalEstimatorConfig& cfg, float dt = 1e-3f) {
+    ThermalEstimatorPlan plan;
+    EXPECT_TRUE(thermal_estimator_plan_build(plan, cfg, dt));
+    return plan;
+}
+
+TEST(ThermalEstimator, ZeroConfigEstimatesAndDeratesNothing) {
+    ThermalEstimatorPlan plan = make_plan(ThermalEstimatorConfig{});
+    ThermalEstimatorState st{};
+    ThermalEstimatorOutput out{};
+    for (int k = 0; k < 1000; ++k) {
+        out = run_thermal_estimator_plan(st, plan, PhaseCurrents{100.0f, -50.0f, -50.0f});
+    }
+    EXPECT_FLOAT_EQ(out.t_winding, 0.0f);
+    EXPECT_FLOAT_EQ(out.iq_scale, 1.0f);
+}
+
+TEST(ThermalEstimator, SettlesWhereCopperLossMeetsConduction) {
+    // 1.5 * 0.5 ohm * 4^2 A^2 = 12 W through 2 K/W: 24 K at the cold
+    // resistance, more once Rs has risen with it.
+    ThermalEstimatorConfig cfg{0.5f, 0.004f, 2.0f, 1.0f, 25.0f};
+    ThermalEstimatorPlan plan = make_plan(cfg, 1e-3f);
+    ThermalEstimatorState st{};
+
+    PhaseCurrents i{4.0f, -2.0f, -2.0f};
+    ThermalEstimatorOutput out = run_thermal_estimator_plan(st, plan, i);
+    EXPECT_GT(out.t_winding, 25.0f);
+    EXPECT_LT(out.t_winding, 25.1f);
+
+    // Rs rising with the winding stretches the time constant by
+    // 1 / (1 - alpha * 24 K) and the final rise with it.
+    for (int k = 1; k < 1000; ++k) {
+        out = run_thermal_estimator_plan(st, plan, i);
+    }
+    const float slow = 1.0f - 0.004f * 24.0f;
+    const float rise_ss = 24.0f / slow;
+    EXPECT_NEAR(out.t_winding - 25.0f, (1.0f - std::exp(-slow)) * rise_ss, 0.01f * rise_ss);
+
+    for (int k = 0; k < 20000; ++k) {
+        out = run_thermal_estimator_plan(st, plan, i);
+    }
+    EXPECT_NEAR(out.t_winding - 25.0f, rise_ss, 0.01f);
+
+    // Without current it cools back to ambient.
+    for (int k = 0; k < 20000; ++k) {
+        out = run_thermal_estimator_plan(st, plan, PhaseCurrents{});
+    }
+    EXPECT_NEAR(out.t_winding, 25.0f, 0.01f);
+}
+
+TEST(ThermalEstimator, DeratesLinearlyFromDerateToMax) {
+    // Slow enough that the winding does not cool within the tick.
+    ThermalEstimatorConfig cfg{0.5f, 0.0f, 2.0f, 1e6f, 40.0f, 100.0f, 140.0f};
+    ThermalEstimatorPlan plan = make_plan(cfg);
+
+    const float t[] = {40.0f, 100.0f, 110.0f, 130.0f, 140.0f, 200.0f};
+    const float scale[] = {1.0f, 1.0f, 0.75f, 0.25f, 0.0f, 0.0f};
+    for (int n = 0; n < 6; ++n) {
+        ThermalEstimatorState st{t[n] - 40.0f};
+        ThermalEstimatorOutput out = run_thermal_estimator_plan(st, plan, PhaseCurrents{});
+        EXPECT_NEAR(out.iq_scale, scale[n], 1e-3f) << t[n];
+    }
+}
+
+TEST(ThermalEstimator, BuildRejectsBadConfigButStillFillsPlan) {
+    ThermalEstimatorPlan plan;
+    EXPECT_FALSE(thermal_estimator_plan_build(
+        plan, ThermalEstimatorConfig{0.5f, 0.004f, 0.0f, 1.0f}, 1e-3f));
+    EXPECT_FALSE(thermal_estimator_plan_build(
+        plan, ThermalEstimatorConfig{0.5f, -0.004f, 2.0f, 1.0f}, 1e-3f));
+    EXPECT_FALSE(thermal_estimator_plan_build(
+        plan, ThermalEstimatorConfig{0.5f, 0.004f, 2.0f, 1.0f, 25.0f, 100.0f, 90.0f}, 1e-3f));
+
+    // The plan is still safe to run: a derate line without a span is off.
+    ThermalEstimatorState st{};
+    ThermalEstimatorOutput out{};
+    for (int k = 0; k < 100; ++k) {
+        out = run_thermal_estimator_plan(st, plan, PhaseCurrents{10.0f, -5.0f, -5.0f});
+    }
+    EXPECT_FLOAT_EQ(out.iq_scale, 1.0f);
+    EXPECT_TRUE(std::isfinite(out.t_winding));
+}
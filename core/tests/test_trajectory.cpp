@@ -3,32 +3,33 @@
 
 TEST(Trajectory, ZeroConfigKeepsStateConstant) {
     TrajConfig cfg{0.0f, 0.0f};
-    TrajState st{1.0f, 0.5f};
-    TrajInput in{2.0f};
+    TrajState st{position64_from_rad(1.0f), 0.5f};
+    TrajInput in{position64_from_rad(2.0f)};
 
     auto out = run_traj_step(st, cfg, in, 0.001f);
-    EXPECT_FLOAT_EQ(out.pos_ref, 1.0f);
+    EXPECT_EQ(out.pos_ref, st.pos);
+    EXPECT_NEAR(position64_to_rad(out.pos_ref), 1.0f, 1e-6f);
     EXPECT_FLOAT_EQ(out.vel_ref, 0.5f);
 }
 
 TEST(Trajectory, MovesTowardTarget) {
     TrajConfig cfg{1.0f, 2.0f};
-    TrajState st{0.0f, 0.0f};
-    TrajInput in{1.0f};
+    TrajState st{position64_from_rad(0.0f), 0.0f};
+    TrajInput in{position64_from_rad(1.0f)};
 
     float dt = 0.001f;
     for (int k = 0; k < 2000; ++k) {
         auto out = run_traj_step(st, cfg, in, dt);
-        EXPECT_GE(out.pos_ref, 0.0f);
-        EXPECT_LE(out.pos_ref, in.target_pos + 1e-3f);
+        EXPECT_GE(out.pos_ref, 0);
+        EXPECT_LE(position64_delta_rad(out.pos_ref, in.target_pos), 1e-3f);
     }
-    EXPECT_NEAR(st.pos, in.target_pos, 5e-2f);
+    EXPECT_NEAR(position64_delta_rad(st.pos, in.target_pos), 0.0f, 5e-2f);
 }
 
 TEST(Trajectory, RespectsVelocityLimit) {
     TrajConfig cfg{0.5f, 10.0f};
-    TrajState st{0.0f, 0.0f};
-    TrajInput in{10.0f};
+    TrajState st{position64_from_rad(0.0f), 0.0f};
+    TrajInput in{position64_from_rad(10.0f)};
 
     float dt = 0.001f;
     for (int k = 0; k < 5000; ++k) {
@@ -40,13 +41,42 @@ TEST(Trajectory, RespectsVelocityLimit) {
 
 TEST(Trajectory, EventuallyStopsNearTarget) {
     TrajConfig cfg{1.0f, 2.0f};
-    TrajState st{0.0f, 0.0f};
-    TrajInput in{2.0f};
+    TrajState st{position64_from_rad(0.0f), 0.0f};
+    TrajInput in{position64_from_rad(2.0f)};
 
     float dt = 0.001f;
     for (int k = 0; k < 10000; ++k) {
         run_traj_step(st, cfg, in, dt);
     }
-    EXPECT_NEAR(st.pos, in.target_pos, 5e-2f);
+    EXPECT_NEAR(position64_delta_rad(st.pos, in.target_pos), 0.0f, 5e-2f);
     EXPECT_NEAR(st.vel, 0.0f, 1e-2f);
 }
+
+TEST(Trajectory, ReportsReferenceAcceleration) {
+    TrajConfig cfg{10.0f, 2.0f};
+    TrajState st{position64_from_rad(0.0f), 0.0f};
+    TrajInput in{position64_from_rad(5.0f)};
+
+    auto out = run_traj_step(st, cfg, in, 0.001f);
+    EXPECT_NEAR(out.acc_ref, 2.0f, 1e-3f);
+    EXPECT_NEAR(out.vel_ref, st.vel, 1e-6f);
+}
+
+TEST(Trajectory, ProfileIsIndependentOfAbsoluteTurn) {
+    // The same move far out on the shaft must produce the same profile,
+    // count for count, as near zero.
+    TrajConfig cfg{100.0f, 500.0f};
+    const Position64 move = 3 * position64_one_turn + position64_from_rad(0.25f);
+    const Position64 far = 100000 * position64_one_turn;
+    TrajState near_st{0, 0.0f};
+    TrajState far_st{far, 0.0f};
+
+    float dt = 0.001f;
+    for (int k = 0; k < 2000; ++k) {
+        auto a = run_traj_step(near_st, cfg, TrajInput{move}, dt);
+        auto b = run_traj_step(far_st, cfg, TrajInput{far + move}, dt);
+        ASSERT_EQ(b.pos_ref - far, a.pos_ref);
+        ASSERT_FLOAT_EQ(b.vel_ref, a.vel_ref);
+    }
+    EXPECT_NEAR(position64_delta_rad(far_st.pos, far + move), 0.0f, 5e-2f);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "axis_core.hpp"
+#include "plan_exchange.hpp"
+#include "spin_barrier.hpp"
+#include "spsc_mailbox.hpp"
+
+// Cross-axis coupling: each tick the destination axis receives
+// theta_target = ratio * theta_ref(src) + offset, one tick late (gantry
+// pairs, electronic gearing). Links within a partition write the
+// destination's input directly; links crossing partitions go through an
+// SPSC mailbox of the (src, dst) partition pair, double-buffered by tick
+// so a remote link lags by exactly one tick too, and where several links
+// feed one axis the cross-partition ones are applied last.
+struct AxisLink {
+    uint16_t src_axis;
+    uint16_t dst_axis;
+    float ratio;
+    float offset;  // rad
+};
+
+// The ratio is applied in double so whole turns of the source survive it.
+[[nodiscard]] inline Position64 axis_link_target(const AxisLink& link, Position64 src_ref) noexcept
+{
+    return static_cast<Position64>(static_cast<double>(src_ref) * link.ratio)
+         + position64_from_rad(link.offset);
+}
+
+using AxisSenseFn = void (*)(void* user, int axis, uint64_t tick, AxisCoreInput& in);
+using AxisActuateFn = void (*)(void* user, int axis, uint64_t tick, const AxisCoreOutput& out);
+
+struct PartitionedConfig {
+    int n_workers;
+    int first_cpu;
+    uint32_t period_ns;
+    uint64_t n_ticks;
+    float dt;
+};
+
+// One worker's shared-nothing batch: parallel arrays indexed by local axis,
+// touched only by the owning thread while running.
+struct alignas(64) AxisPartition {
+    std::vector<uint16_t>       axis_ids;
+    std::unique_ptr<PlanExchange[]> plans;
+    std::vector<AxisCoreState>  states;
+    std::vector<AxisGuardState> guards;
+    std::vector<AxisCoreInput>  inputs;
+    std::vector<AxisCoreOutput> outputs;
+    std::vector<AxisLink>       links;
+    uint64_t mailbox_drops;
+    int64_t  busy_ns;
+};
+
+struct PartitionedExecutor {
+    PartitionedConfig cfg;
+    int n_axes;
+    std::vector<AxisPartition> parts;
+    std::vector<uint16_t> owner;
+    std::vector<uint16_t> local_index;
+    std::unique_ptr<SpscMailbox[]> mailboxes;   // [tick & 1][src][dst]
+    SpinBarrier barrier;
+    AxisSenseFn sense;
+    AxisActuateFn actuate;
+    void* user;
+    uint64_t ticks_done;
+    int sleep_error;                // clock_nanosleep error that halted the last run; 0 = none
+    std::atomic<bool> halt;
+};
+
+// Axes are split into contiguous blocks, one per worker. Each config is
+// compiled for cfg.dt here; setup fails if any does not compile, or if
+// more than mailbox_capacity links cross from one partition to another
+// (a mailbox is drained once per tick and holds that many). Allocates
+// all buffers; nothing is allocated once partitioned_run starts.
+bool partitioned_setup(
+    PartitionedExecutor& ex,
+    const PartitionedConfig& cfg,
+    const AxisCoreConfig* cfgs,
+    int n_axes,
+    const AxisLink* links,
+    int n_links,
+    AxisSenseFn sense,
+    AxisActuateFn actuate,
+    void* user);
+
+// Compiles cfg and hands it to the axis's worker, which switches to it at
+// its next tick boundary. Safe to call while partitioned_run is running, as
+// long as only one thread publishes to a given axis. Returns false, and
+// the axis keeps its current plan, if cfg does not compile.
+bool partitioned_publish_config(
+    PartitionedExecutor& ex,
+    int axis,
+    const AxisCoreConfig& cfg) noexcept;
+
+void partitioned_set_command(
+    PartitionedExecutor& ex,
+    int axis,
+    const AxisCoreInput& in) noexcept;
+
+// Runs cfg.n_ticks lock-step ticks; the caller's thread is worker 0. If
+// the period sleep fails with anything but EINTR the run stops after that
+// tick with sleep_error set, rather than free-running unpaced.
+void partitioned_run(PartitionedExecutor& ex);
+
+const AxisCoreState& partitioned_state(const PartitionedExecutor& ex, int axis) noexcept;
+const AxisCoreOutput& partitioned_output(const PartitionedExecutor& ex, int axis) noexcept;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "axis_core.hpp"
+
+// Hands compiled plans from one non-RT writer to one RT reader. Triple
+// buffer: the writer compiles into its back slot, then swaps it with the
+// middle slot and marks it fresh; the reader, at a tick boundary, swaps its
+// front slot with the middle one if it is fresh. Each slot belongs to one
+// side between swaps, so the reader never sees a half-written plan and
+// neither side ever waits for, locks against or allocates because of the
+// other. A plan published twice between reader ticks replaces the first.
+struct PlanExchange {
+    AxisCorePlan slots[3];
+    alignas(64) std::atomic<uint32_t> middle;  // slot index | plan_fresh
+    alignas(64) uint32_t back;                 // writer-owned
+    uint64_t published;
+    alignas(64) uint32_t front;                // reader-owned
+    uint64_t picked_up;
+};
+
+constexpr uint32_t plan_fresh = 4;
+
+inline void plan_exchange_init(PlanExchange& ex, const AxisCorePlan& plan) noexcept
+{
+    ex.slots[0] = plan;
+    ex.slots[1] = plan;
+    ex.slots[2] = plan;
+    ex.front = 0;
+    ex.middle.store(1, std::memory_order_relaxed);
+    ex.back = 2;
+    ex.published = 0;
+    ex.picked_up = 0;
+}
+
+// Writer side. Compiles cfg for dt into the back slot and publishes it;
+// a config that does not compile is dropped and false returned, leaving
+// the reader on its current plan.
+inline bool plan_exchange_publish(PlanExchange& ex, const AxisCoreConfig& cfg, float dt) noexcept
+{
+    if (!compile_axis_config(ex.slots[ex.back], cfg, dt)) {
+        return false;
+    }
+    uint32_t prev = ex.middle.exchange(ex.back | plan_fresh, std::memory_order_acq_rel);
+    ex.back = prev & ~plan_fresh;
+    ++ex.published;
+    return true;
+}
+
+// Reader side, once per tick: the newest published plan, or the one the
+// previous tick used. The reference stays valid until the next call.
+inline const AxisCorePlan& plan_exchange_acquire(PlanExchange& ex) noexcept
+{
+    if (ex.middle.load(std::memory_order_relaxed) & plan_fresh) {
+        uint32_t prev = ex.middle.exchange(ex.front, std::memory_order_acq_rel);
+        ex.front = prev & ~plan_fresh;
+        ++ex.picked_up;
+    }
+    return ex.slots[ex.front];
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <pthread.h>
+
+constexpr int rt_hist_bins = 32;
+
+struct RtExecutorConfig {
+    int cpu;
+    int priority;
+    bool lock_memory;
+    uint32_t period_ns;
+    uint64_t n_ticks;
+};
+
+using RtTickFn = void (*)(void* user, uint64_t tick);
+
+struct RtMetrics {
+    std::atomic<uint64_t> ticks;
+    std::atomic<uint64_t> overruns;
+    std::atomic<uint64_t> missed_periods;
+    std::atomic<int64_t>  latency_min_ns;
+    std::atomic<int64_t>  latency_max_ns;
+    std::atomic<int64_t>  latency_sum_ns;
+    std::atomic<int64_t>  exec_max_ns;
+    std::atomic<int64_t>  exec_sum_ns;
+    std::atomic<uint64_t> latency_hist[rt_hist_bins];
+    std::atomic<bool>     rt_sched_ok;
+    std::atomic<bool>     affinity_ok;
+    std::atomic<bool>     mlock_ok;
+    std::atomic<int>      sleep_error;  // clock_nanosleep error that ended the loop; 0 = none
+};
+
+struct RtMetricsSnapshot {
+    uint64_t ticks;
+    uint64_t overruns;
+    uint64_t missed_periods;
+    int64_t  latency_min_ns;
+    int64_t  latency_max_ns;
+    double   latency_mean_ns;
+    int64_t  exec_max_ns;
+    double   exec_mean_ns;
+    uint64_t latency_hist[rt_hist_bins];
+    bool     rt_sched_ok;
+    bool     affinity_ok;
+    bool     mlock_ok;
+    int      sleep_error;
+};
+
+struct RtExecutor {
+    RtExecutorConfig cfg;
+    RtTickFn fn;
+    void* user;
+    pthread_t thread;
+    bool started;
+    std::atomic<bool> stop;
+    RtMetrics metrics;
+};
+
+bool rt_executor_start(
+    RtExecutor& ex,
+    const RtExecutorConfig& cfg,
+    RtTickFn fn,
+    void* user) noexcept;
+
+void rt_executor_request_stop(RtExecutor& ex) noexcept;
+
+void rt_executor_join(RtExecutor& ex) noexcept;
+
+RtMetricsSnapshot rt_executor_metrics(const RtExecutor& ex) noexcept;
+
+[[nodiscard]] inline int rt_hist_bin(int64_t ns) noexcept {
+    int bin = 0;
+    uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+    while (v > 1 && bin < rt_hist_bins - 1) {
+        v >>= 1;
+        ++bin;
+    }
+    return bin;
+}
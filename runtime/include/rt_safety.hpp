@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Allocation and lock counts come from hooks in rt_alloc_hooks.cpp, which
+// replace global new/delete, malloc and pthread_mutex_lock for the whole
+// program. Link that file only into dedicated test executables.
+using RtSafetyFn = void (*)(void* user, uint64_t tick);
+
+struct RtSafetyReport {
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t locks;
+    bool hooks_installed;
+    bool syscalls_checked;
+    bool syscall_free;
+    bool ok;
+};
+
+// Called by the hooks; count only while the calling thread is armed.
+void rt_safety_note_alloc() noexcept;
+void rt_safety_note_free() noexcept;
+void rt_safety_note_lock() noexcept;
+void rt_safety_mark_hooks_installed() noexcept;
+
+// Tick 0 runs unarmed as a warm-up so lazy one-time initialisation is not
+// reported. Ticks 1..n_ticks run with the hooks armed, then n_ticks more
+// run in a forked child under SECCOMP_MODE_STRICT, where any syscall other
+// than read/write/exit kills the child. ok requires all three checks; if
+// the child could not be run or reaped, syscalls_checked is false and so
+// is ok.
+RtSafetyReport rt_safety_check(RtSafetyFn fn, void* user, uint64_t n_ticks) noexcept;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include "sim_axis_runner.hpp"
+
+struct RtAxisCommand {
+    AxisMode mode;
+    float theta_target;
+    float w_target;
+    float iq_target;
+};
+
+struct RtSimAxes {
+    SimAxisState* states;
+    const SimAxisConfig* cfgs;
+    const RtAxisCommand* cmds;
+    int n_axes;
+    float dt;
+};
+
+void rt_sim_tick(void* user, uint64_t tick);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <sched.h>
+
+// Sense-reversing barrier: one fetch_sub per arrival, waiters spin on a
+// single flag that the last arrival flips. Each thread keeps its own
+// local_sense, initially false. After a bounded spin the waiter yields so
+// oversubscribed test machines still make progress; on a partitioned RT
+// box with one worker per core the yield is never reached.
+struct alignas(64) SpinBarrier {
+    std::atomic<int>  remaining;
+    std::atomic<bool> sense;
+    int n;
+};
+
+inline void spin_barrier_init(SpinBarrier& b, int n) noexcept
+{
+    b.n = n;
+    b.remaining.store(n, std::memory_order_relaxed);
+    b.sense.store(false, std::memory_order_relaxed);
+}
+
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+inline void spin_barrier_wait(SpinBarrier& b, bool& local_sense) noexcept
+{
+    local_sense = !local_sense;
+    if (b.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        b.remaining.store(b.n, std::memory_order_relaxed);
+        b.sense.store(local_sense, std::memory_order_release);
+        return;
+    }
+    int spins = 0;
+    while (b.sense.load(std::memory_order_acquire) != local_sense) {
+        if (++spins < 4096) {
+            cpu_relax();
+        } else {
+            sched_yield();
+        }
+    }
+}
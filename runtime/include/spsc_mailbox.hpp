@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "angle.hpp"
+
+constexpr uint32_t mailbox_capacity = 64;
+
+// A position setpoint for another core's axis; dst_axis is global.
+struct AxisSetpoint {
+    uint16_t dst_axis;
+    Position64 theta_target;
+};
+
+// Single-producer single-consumer ring. head and tail sit on separate lines
+// so the producer and consumer never write the same cache line.
+struct SpscMailbox {
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+    alignas(64) AxisSetpoint slots[mailbox_capacity];
+};
+
+static_assert((mailbox_capacity & (mailbox_capacity - 1)) == 0,
+              "mailbox_capacity must be a power of two");
+
+inline bool mailbox_push(SpscMailbox& mb, const AxisSetpoint& msg) noexcept
+{
+    uint32_t tail = mb.tail.load(std::memory_order_relaxed);
+    if (tail - mb.head.load(std::memory_order_acquire) == mailbox_capacity) {
+        return false;
+    }
+    mb.slots[tail & (mailbox_capacity - 1)] = msg;
+    mb.tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+inline bool mailbox_pop(SpscMailbox& mb, AxisSetpoint& msg) noexcept
+{
+    uint32_t head = mb.head.load(std::memory_order_relaxed);
+    if (head == mb.tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    msg = mb.slots[head & (mailbox_capacity - 1)];
+    mb.head.store(head + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,246 @@
+#include "partitioned_executor.hpp"
+
+#include <cerrno>
+#include <ctime>
+#include <pthread.h>
+#include <thread>
+
+namespace {
+
+int64_t mono_ns() noexcept
+{
+    timespec t{};
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<int64_t>(t.tv_sec) * 1000000000 + t.tv_nsec;
+}
+
+// Only a signal is retried; see rt_executor.cpp.
+int sleep_until(const timespec& wake) noexcept
+{
+    int err = 0;
+    do {
+        err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);
+    } while (err == EINTR);
+    return err;
+}
+
+void pin_to_cpu(pthread_t thread, int cpu) noexcept
+{
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread, sizeof(set), &set);
+}
+
+// Two sets of mailboxes, alternating by tick: tick k pushes into set k & 1
+// and pops what tick k-1 pushed into the other. A source cannot reach tick
+// k+2, and reuse the set, before the destination has passed the barrier
+// that ends tick k+1, so every setpoint is applied exactly one tick late
+// however the workers are scheduled.
+SpscMailbox& mailbox(PartitionedExecutor& ex, uint64_t tick, int src, int dst) noexcept
+{
+    const size_t n = ex.parts.size();
+    return ex.mailboxes[((tick & 1) * n + static_cast<size_t>(src)) * n + dst];
+}
+
+// Returns the ticks completed.
+uint64_t run_worker(PartitionedExecutor& ex, int w)
+{
+    AxisPartition& part = ex.parts[w];
+    const int n_parts = static_cast<int>(ex.parts.size());
+    const int n_local = static_cast<int>(part.axis_ids.size());
+    bool local_sense = false;
+    int64_t next = mono_ns() + ex.cfg.period_ns;
+
+    for (uint64_t k = 0; k < ex.cfg.n_ticks; ++k) {
+        const int64_t t0 = mono_ns();
+        // Parity follows the tick count across runs, so the last tick of
+        // one run feeds the first tick of the next.
+        const uint64_t tick = ex.ticks_done + k;
+
+        AxisSetpoint msg{};
+        for (int src = 0; src < n_parts; ++src) {
+            SpscMailbox& mb = mailbox(ex, tick - 1, src, w);
+            while (mailbox_pop(mb, msg)) {
+                part.inputs[ex.local_index[msg.dst_axis]].theta_target = msg.theta_target;
+            }
+        }
+
+        for (int i = 0; i < n_local; ++i) {
+            const int axis = part.axis_ids[i];
+            if (ex.sense != nullptr) {
+                ex.sense(ex.user, axis, k, part.inputs[i]);
+            }
+            const AxisCorePlan& plan = plan_exchange_acquire(part.plans[i]);
+            part.outputs[i] = run_axis_plan(part.states[i], part.guards[i], plan, part.inputs[i]);
+            if (ex.actuate != nullptr) {
+                ex.actuate(ex.user, axis, k, part.outputs[i]);
+            }
+        }
+
+        // Written after every local axis has run, so a local destination
+        // sees the setpoint next tick, as a mailbox would deliver it.
+        for (const AxisLink& link : part.links) {
+            const AxisCoreOutput& src_out = part.outputs[ex.local_index[link.src_axis]];
+            AxisSetpoint sp{link.dst_axis, axis_link_target(link, src_out.theta_ref)};
+            const int dst = ex.owner[link.dst_axis];
+            if (dst == w) {
+                part.inputs[ex.local_index[link.dst_axis]].theta_target = sp.theta_target;
+            } else if (!mailbox_push(mailbox(ex, tick, w, dst), sp)) {
+                ++part.mailbox_drops;
+            }
+        }
+
+        part.busy_ns += mono_ns() - t0;
+
+        if (w == 0 && ex.cfg.period_ns > 0) {
+            const timespec wake{static_cast<time_t>(next / 1000000000),
+                                static_cast<long>(next % 1000000000)};
+            const int err = sleep_until(wake);
+            if (err != 0) {
+                ex.sleep_error = err;
+                ex.halt.store(true, std::memory_order_relaxed);
+            }
+            next += ex.cfg.period_ns;
+        }
+        // The barrier orders worker 0's halt store before every check.
+        spin_barrier_wait(ex.barrier, local_sense);
+        if (ex.halt.load(std::memory_order_relaxed)) {
+            return k + 1;
+        }
+    }
+    return ex.cfg.n_ticks;
+}
+
+} // namespace
+
+bool partitioned_setup(
+    PartitionedExecutor& ex,
+    const PartitionedConfig& cfg,
+    const AxisCoreConfig* cfgs,
+    int n_axes,
+    const AxisLink* links,
+    int n_links,
+    AxisSenseFn sense,
+    AxisActuateFn actuate,
+    void* user)
+{
+    if (cfg.n_workers <= 0 || n_axes <= 0 || n_axes > 65535 || cfgs == nullptr) {
+        return false;
+    }
+    const int n_parts = cfg.n_workers < n_axes ? cfg.n_workers : n_axes;
+
+    ex.cfg = cfg;
+    ex.cfg.n_workers = n_parts;
+    ex.n_axes = n_axes;
+    ex.parts = std::vector<AxisPartition>(n_parts);
+    ex.owner.assign(n_axes, 0);
+    ex.local_index.assign(n_axes, 0);
+    ex.sense = sense;
+    ex.actuate = actuate;
+    ex.user = user;
+    ex.ticks_done = 0;
+    ex.sleep_error = 0;
+    ex.halt.store(false, std::memory_order_relaxed);
+
+    for (int a = 0; a < n_axes; ++a) {
+        const int w = static_cast<int>(static_cast<int64_t>(a) * n_parts / n_axes);
+        AxisPartition& part = ex.parts[w];
+        ex.owner[a] = static_cast<uint16_t>(w);
+        ex.local_index[a] = static_cast<uint16_t>(part.axis_ids.size());
+        part.axis_ids.push_back(static_cast<uint16_t>(a));
+    }
+    AxisCorePlan plan;
+    for (AxisPartition& part : ex.parts) {
+        part.plans.reset(new PlanExchange[part.axis_ids.size()]);
+        for (size_t i = 0; i < part.axis_ids.size(); ++i) {
+            if (!compile_axis_config(plan, cfgs[part.axis_ids[i]], cfg.dt)) {
+                return false;
+            }
+            plan_exchange_init(part.plans[i], plan);
+        }
+        part.states.assign(part.axis_ids.size(), AxisCoreState{});
+        part.guards.assign(part.axis_ids.size(), AxisGuardState{});
+        part.inputs.assign(part.axis_ids.size(), AxisCoreInput{});
+        part.outputs.assign(part.axis_ids.size(), AxisCoreOutput{});
+        part.mailbox_drops = 0;
+        part.busy_ns = 0;
+    }
+    // Each mailbox is drained every tick, so a pair of partitions fits
+    // mailbox_capacity links; more would drop setpoints every tick.
+    std::vector<uint32_t> pair_links(static_cast<size_t>(n_parts) * n_parts, 0);
+    for (int l = 0; l < n_links; ++l) {
+        if (links[l].src_axis >= n_axes || links[l].dst_axis >= n_axes) {
+            return false;
+        }
+        const int src = ex.owner[links[l].src_axis];
+        const int dst = ex.owner[links[l].dst_axis];
+        if (src != dst && ++pair_links[static_cast<size_t>(src) * n_parts + dst] > mailbox_capacity) {
+            return false;
+        }
+        ex.parts[src].links.push_back(links[l]);
+    }
+
+    ex.mailboxes.reset(new SpscMailbox[2 * static_cast<size_t>(n_parts) * n_parts]());
+    spin_barrier_init(ex.barrier, n_parts);
+    return true;
+}
+
+bool partitioned_publish_config(
+    PartitionedExecutor& ex,
+    int axis,
+    const AxisCoreConfig& cfg) noexcept
+{
+    if (axis < 0 || axis >= ex.n_axes) {
+        return false;
+    }
+    AxisPartition& part = ex.parts[ex.owner[axis]];
+    return plan_exchange_publish(part.plans[ex.local_index[axis]], cfg, ex.cfg.dt);
+}
+
+void partitioned_set_command(
+    PartitionedExecutor& ex,
+    int axis,
+    const AxisCoreInput& in) noexcept
+{
+    ex.parts[ex.owner[axis]].inputs[ex.local_index[axis]] = in;
+}
+
+void partitioned_run(PartitionedExecutor& ex)
+{
+    const int n_parts = static_cast<int>(ex.parts.size());
+    ex.sleep_error = 0;
+    ex.halt.store(false, std::memory_order_relaxed);
+    // Each worker starts from local_sense = false, so the barrier must too:
+    // a run of an odd number of ticks leaves its sense flipped.
+    spin_barrier_init(ex.barrier, n_parts);
+    std::vector<std::thread> threads;
+    threads.reserve(n_parts - 1);
+    for (int w = 1; w < n_parts; ++w) {
+        threads.emplace_back(run_worker, std::ref(ex), w);
+        if (ex.cfg.first_cpu >= 0) {
+            pin_to_cpu(threads.back().native_handle(), ex.cfg.first_cpu + w);
+        }
+    }
+    if (ex.cfg.first_cpu >= 0) {
+        pin_to_cpu(pthread_self(), ex.cfg.first_cpu);
+    }
+    const uint64_t ticks = run_worker(ex, 0);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    ex.ticks_done += ticks;
+}
+
+const AxisCoreState& partitioned_state(const PartitionedExecutor& ex, int axis) noexcept
+{
+    return ex.parts[ex.owner[axis]].states[ex.local_index[axis]];
+}
+
+const AxisCoreOutput& partitioned_output(const PartitionedExecutor& ex, int axis) noexcept
+{
+    return ex.parts[ex.owner[axis]].outputs[ex.local_index[axis]];
+}
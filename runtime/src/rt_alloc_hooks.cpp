@@ -0,0 +1,120 @@
+#include <cerrno>
+#include <cstddef>
+#include <dlfcn.h>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+#include "rt_safety.hpp"
+
+using MutexFn = int (*)(pthread_mutex_t*);
+
+// Forward to glibc's own entry points so the hooks never recurse.
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void  __libc_free(void*);
+
+void* malloc(size_t n)
+{
+    rt_safety_note_alloc();
+    return __libc_malloc(n);
+}
+
+void* calloc(size_t n, size_t size)
+{
+    rt_safety_note_alloc();
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, size_t n)
+{
+    rt_safety_note_alloc();
+    return __libc_realloc(p, n);
+}
+
+void* aligned_alloc(size_t align, size_t n)
+{
+    rt_safety_note_alloc();
+    return __libc_memalign(align, n);
+}
+
+// POSIX wants a power of two that is a multiple of sizeof(void*);
+// __libc_memalign would quietly round anything else up.
+int posix_memalign(void** out, size_t align, size_t n)
+{
+    rt_safety_note_alloc();
+    if (align % sizeof(void*) != 0 || (align & (align - 1)) != 0 || align == 0) {
+        return EINVAL;
+    }
+    void* p = __libc_memalign(align, n);
+    if (p == nullptr) {
+        return ENOMEM;
+    }
+    *out = p;
+    return 0;
+}
+
+void free(void* p)
+{
+    if (p != nullptr) {
+        rt_safety_note_free();
+    }
+    __libc_free(p);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* m)
+{
+    static const auto next = reinterpret_cast<MutexFn>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+    rt_safety_note_lock();
+    return next(m);
+}
+
+int pthread_mutex_trylock(pthread_mutex_t* m)
+{
+    static const auto next = reinterpret_cast<MutexFn>(dlsym(RTLD_NEXT, "pthread_mutex_trylock"));
+    rt_safety_note_lock();
+    return next(m);
+}
+}
+
+namespace {
+
+void* counted_new(std::size_t n)
+{
+    void* p = malloc(n == 0 ? 1 : n);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* counted_new_aligned(std::size_t n, std::align_val_t align)
+{
+    void* p = aligned_alloc(static_cast<size_t>(align), n == 0 ? 1 : n);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+[[maybe_unused]] const bool registered = (rt_safety_mark_hooks_installed(), true);
+
+} // namespace
+
+void* operator new(std::size_t n) { return counted_new(n); }
+void* operator new[](std::size_t n) { return counted_new(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return malloc(n == 0 ? 1 : n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return malloc(n == 0 ? 1 : n); }
+void* operator new(std::size_t n, std::align_val_t a) { return counted_new_aligned(n, a); }
+void* operator new[](std::size_t n, std::align_val_t a) { return counted_new_aligned(n, a); }
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, std::size_t) noexcept { free(p); }
+void operator delete[](void* p, std::size_t) noexcept { free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { free(p); }
@@ -0,0 +1,223 @@
+#include "rt_executor.hpp"
+
+#include <cerrno>
+#include <ctime>
+#include <limits>
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace {
+
+constexpr int64_t ns_per_s = 1000000000;
+
+int64_t to_ns(const timespec& t) noexcept
+{
+    return static_cast<int64_t>(t.tv_sec) * ns_per_s + t.tv_nsec;
+}
+
+timespec from_ns(int64_t ns) noexcept
+{
+    timespec t{};
+    t.tv_sec = static_cast<time_t>(ns / ns_per_s);
+    t.tv_nsec = static_cast<long>(ns % ns_per_s);
+    return t;
+}
+
+int64_t now_ns() noexcept
+{
+    timespec t{};
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return to_ns(t);
+}
+
+// Only a signal is retried: any other error would fail again at once and
+// turn the RT thread into a busy spin. Returns 0 or the error.
+int sleep_until(const timespec& wake) noexcept
+{
+    int err = 0;
+    do {
+        err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);
+    } while (err == EINTR);
+    return err;
+}
+
+void atomic_max(std::atomic<int64_t>& a, int64_t v) noexcept
+{
+    int64_t cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+    }
+}
+
+void atomic_min(std::atomic<int64_t>& a, int64_t v) noexcept
+{
+    int64_t cur = a.load(std::memory_order_relaxed);
+    while (v < cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {
+    }
+}
+
+void reset_metrics(RtMetrics& m) noexcept
+{
+    m.ticks.store(0, std::memory_order_relaxed);
+    m.overruns.store(0, std::memory_order_relaxed);
+    m.missed_periods.store(0, std::memory_order_relaxed);
+    m.latency_min_ns.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+    m.latency_max_ns.store(0, std::memory_order_relaxed);
+    m.latency_sum_ns.store(0, std::memory_order_relaxed);
+    m.exec_max_ns.store(0, std::memory_order_relaxed);
+    m.exec_sum_ns.store(0, std::memory_order_relaxed);
+    for (auto& h : m.latency_hist) {
+        h.store(0, std::memory_order_relaxed);
+    }
+    m.rt_sched_ok.store(false, std::memory_order_relaxed);
+    m.affinity_ok.store(false, std::memory_order_relaxed);
+    m.mlock_ok.store(false, std::memory_order_relaxed);
+    m.sleep_error.store(0, std::memory_order_relaxed);
+}
+
+// Runs on the new thread so the policy and mask apply to it alone. Each
+// request is best effort: without CAP_SYS_NICE / CAP_IPC_LOCK the loop
+// still runs under SCHED_OTHER and the metrics record what was granted.
+void apply_thread_policy(RtExecutor& ex) noexcept
+{
+    const RtExecutorConfig& cfg = ex.cfg;
+
+    if (cfg.cpu >= 0 && cfg.cpu < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cfg.cpu, &set);
+        ex.metrics.affinity_ok.store(
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0,
+            std::memory_order_relaxed);
+    }
+
+    if (cfg.priority > 0) {
+        sched_param sp{};
+        const int lo = sched_get_priority_min(SCHED_FIFO);
+        const int hi = sched_get_priority_max(SCHED_FIFO);
+        sp.sched_priority = cfg.priority < lo ? lo : (cfg.priority > hi ? hi : cfg.priority);
+        ex.metrics.rt_sched_ok.store(
+            pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) == 0,
+            std::memory_order_relaxed);
+    }
+}
+
+void record_tick(RtMetrics& m, int64_t latency, int64_t exec) noexcept
+{
+    atomic_min(m.latency_min_ns, latency);
+    atomic_max(m.latency_max_ns, latency);
+    m.latency_sum_ns.fetch_add(latency, std::memory_order_relaxed);
+    m.latency_hist[rt_hist_bin(latency)].fetch_add(1, std::memory_order_relaxed);
+    atomic_max(m.exec_max_ns, exec);
+    m.exec_sum_ns.fetch_add(exec, std::memory_order_relaxed);
+    m.ticks.fetch_add(1, std::memory_order_release);
+}
+
+void* rt_thread_main(void* arg)
+{
+    RtExecutor& ex = *static_cast<RtExecutor*>(arg);
+    apply_thread_policy(ex);
+
+    const int64_t period = ex.cfg.period_ns > 0 ? ex.cfg.period_ns : 1;
+    int64_t next = now_ns() + period;
+
+    for (uint64_t k = 0; ex.cfg.n_ticks == 0 || k < ex.cfg.n_ticks; ++k) {
+        if (ex.stop.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        const int err = sleep_until(from_ns(next));
+        if (err != 0) {
+            ex.metrics.sleep_error.store(err, std::memory_order_relaxed);
+            break;
+        }
+
+        const int64_t t_wake = now_ns();
+        ex.fn(ex.user, k);
+        const int64_t t_done = now_ns();
+
+        record_tick(ex.metrics, t_wake - next, t_done - t_wake);
+
+        // On overrun keep the grid: skip the slots already in the past
+        // rather than firing a burst of late ticks to catch up.
+        next += period;
+        if (t_done > next) {
+            const int64_t missed = (t_done - next) / period + 1;
+            ex.metrics.overruns.fetch_add(1, std::memory_order_relaxed);
+            ex.metrics.missed_periods.fetch_add(
+                static_cast<uint64_t>(missed), std::memory_order_relaxed);
+            next += missed * period;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool rt_executor_start(
+    RtExecutor& ex,
+    const RtExecutorConfig& cfg,
+    RtTickFn fn,
+    void* user) noexcept
+{
+    if (ex.started || fn == nullptr) {
+        return false;
+    }
+
+    ex.cfg = cfg;
+    ex.fn = fn;
+    ex.user = user;
+    ex.stop.store(false, std::memory_order_relaxed);
+    reset_metrics(ex.metrics);
+
+    if (cfg.lock_memory) {
+        ex.metrics.mlock_ok.store(mlockall(MCL_CURRENT | MCL_FUTURE) == 0,
+                                  std::memory_order_relaxed);
+    }
+
+    if (pthread_create(&ex.thread, nullptr, rt_thread_main, &ex) != 0) {
+        return false;
+    }
+    ex.started = true;
+    return true;
+}
+
+void rt_executor_request_stop(RtExecutor& ex) noexcept
+{
+    ex.stop.store(true, std::memory_order_release);
+}
+
+void rt_executor_join(RtExecutor& ex) noexcept
+{
+    if (!ex.started) {
+        return;
+    }
+    pthread_join(ex.thread, nullptr);
+    ex.started = false;
+    if (ex.cfg.lock_memory && ex.metrics.mlock_ok.load(std::memory_order_relaxed)) {
+        munlockall();
+    }
+}
+
+RtMetricsSnapshot rt_executor_metrics(const RtExecutor& ex) noexcept
+{
+    const RtMetrics& m = ex.metrics;
+    RtMetricsSnapshot s{};
+    s.ticks = m.ticks.load(std::memory_order_acquire);
+    s.overruns = m.overruns.load(std::memory_order_relaxed);
+    s.missed_periods = m.missed_periods.load(std::memory_order_relaxed);
+    s.latency_min_ns = s.ticks > 0 ? m.latency_min_ns.load(std::memory_order_relaxed) : 0;
+    s.latency_max_ns = m.latency_max_ns.load(std::memory_order_relaxed);
+    s.exec_max_ns = m.exec_max_ns.load(std::memory_order_relaxed);
+    if (s.ticks > 0) {
+        s.latency_mean_ns = static_cast<double>(m.latency_sum_ns.load(std::memory_order_relaxed)) / s.ticks;
+        s.exec_mean_ns = static_cast<double>(m.exec_sum_ns.load(std::memory_order_relaxed)) / s.ticks;
+    }
+    for (int i = 0; i < rt_hist_bins; ++i) {
+        s.latency_hist[i] = m.latency_hist[i].load(std::memory_order_relaxed);
+    }
+    s.rt_sched_ok = m.rt_sched_ok.load(std::memory_order_relaxed);
+    s.affinity_ok = m.affinity_ok.load(std::memory_order_relaxed);
+    s.mlock_ok = m.mlock_ok.load(std::memory_order_relaxed);
+    s.sleep_error = m.sleep_error.load(std::memory_order_relaxed);
+    return s;
+}
@@ -0,0 +1,107 @@
+#include "rt_safety.hpp"
+
+#include <cerrno>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+bool hooks_installed = false;
+thread_local bool armed = false;
+thread_local uint64_t n_alloc = 0;
+thread_local uint64_t n_free = 0;
+thread_local uint64_t n_lock = 0;
+
+bool run_in_strict_child(RtSafetyFn fn, void* user, uint64_t first, uint64_t n_ticks, bool& checked) noexcept
+{
+    const pid_t pid = fork();
+    if (pid < 0) {
+        checked = false;
+        return false;
+    }
+    if (pid == 0) {
+        if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT) != 0) {
+            _exit(2);
+        }
+        for (uint64_t k = 0; k < n_ticks; ++k) {
+            fn(user, first + k);
+        }
+        // exit_group is not on the strict allow-list; plain exit is.
+        syscall(SYS_exit, 0);
+    }
+
+    int status = 0;
+    pid_t waited = 0;
+    do {
+        waited = waitpid(pid, &status, 0);
+    } while (waited < 0 && errno == EINTR);
+    if (waited < 0) {
+        // ECHILD when SIGCHLD is ignored: the child reaped itself and its
+        // status is lost.
+        checked = false;
+        return false;
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 2) {
+        checked = false;
+        return false;
+    }
+    checked = true;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+void rt_safety_note_alloc() noexcept
+{
+    if (armed) {
+        ++n_alloc;
+    }
+}
+
+void rt_safety_note_free() noexcept
+{
+    if (armed) {
+        ++n_free;
+    }
+}
+
+void rt_safety_note_lock() noexcept
+{
+    if (armed) {
+        ++n_lock;
+    }
+}
+
+void rt_safety_mark_hooks_installed() noexcept
+{
+    hooks_installed = true;
+}
+
+RtSafetyReport rt_safety_check(RtSafetyFn fn, void* user, uint64_t n_ticks) noexcept
+{
+    RtSafetyReport r{};
+    r.hooks_installed = hooks_installed;
+
+    fn(user, 0);
+
+    n_alloc = 0;
+    n_free = 0;
+    n_lock = 0;
+    armed = true;
+    for (uint64_t k = 1; k <= n_ticks; ++k) {
+        fn(user, k);
+    }
+    armed = false;
+    r.allocations = n_alloc;
+    r.frees = n_free;
+    r.locks = n_lock;
+
+    r.syscall_free = run_in_strict_child(fn, user, n_ticks + 1, n_ticks, r.syscalls_checked);
+
+    r.ok = r.allocations == 0 && r.frees == 0 && r.locks == 0 &&
+           r.syscalls_checked && r.syscall_free;
+    return r;
+}
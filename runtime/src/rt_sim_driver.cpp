@@ -0,0 +1,14 @@
+#include "rt_sim_driver.hpp"
+
+// Stands in for the ADC-ready interrupt: one sim_axis_step per axis per
+// period, with the simulator playing the power stage and motor.
+void rt_sim_tick(void* user, uint64_t tick)
+{
+    (void)tick;
+    RtSimAxes& axes = *static_cast<RtSimAxes*>(user);
+    for (int a = 0; a < axes.n_axes; ++a) {
+        const RtAxisCommand& cmd = axes.cmds[a];
+        sim_axis_step(axes.states[a], axes.cfgs[a], axes.dt, cmd.mode,
+                      cmd.theta_target, cmd.w_target, cmd.iq_target);
+    }
+}
@@ -0,0 +1,126 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "rt_executor.hpp"
+#include "rt_sim_driver.hpp"
+
+namespace {
+
+constexpr const char* usage =
+    "usage: rt_sim [period_us] [n_axes] [n_ticks] [cpu] [priority]\n"
+    "  period_us  1..4294967 (default 500)\n"
+    "  n_axes     1..4096 (default 4)\n"
+    "  n_ticks    0 runs until killed (default 10000)\n"
+    "  cpu        -1 leaves affinity alone, else 0..1023 (default -1)\n"
+    "  priority   0 stays SCHED_OTHER, else 1..99 (default 80)\n";
+
+// Whole decimal argument in [lo, hi]; rejects empty input, trailing junk
+// and anything strtoll saturates.
+bool parse_arg(const char* s, long long lo, long long hi, long long& out)
+{
+    char* end = nullptr;
+    errno = 0;
+    const long long v = std::strtoll(s, &end, 10);
+    if (end == s || *end != '\0' || errno == ERANGE || v < lo || v > hi) {
+        return false;
+    }
+    out = v;
+    return true;
+}
+
+// As parse_arg over all of uint64; strtoull would negate a leading '-'.
+bool parse_arg_u64(const char* s, uint64_t& out)
+{
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long v = std::strtoull(s, &end, 10);
+    if (end == s || *end != '\0' || errno == ERANGE || std::strchr(s, '-') != nullptr) {
+        return false;
+    }
+    out = v;
+    return true;
+}
+
+SimAxisConfig make_axis_cfg()
+{
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.traj = TrajConfig{1.0f, 2.0f};
+    cfg.axis_cfg.pos  = PositionLoopConfig{-50.0f, 50.0f};
+    cfg.axis_cfg.spd  = SpeedLoopConfig{-50.0f, 50.0f};
+    cfg.axis_cfg.cur  = CurrentLoopConfig{0.8f};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-50.0f, 50.0f, -50.0f, 50.0f};
+    cfg.axis_cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.spd.iq_pi = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.00001f;
+    cfg.motor_params.B = 0.01f;
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // The executor period is a uint32 in ns, which caps period_us.
+    long long period_arg = 500;
+    long long n_axes_arg = 4;
+    uint64_t n_ticks = 10000;
+    long long cpu_arg = -1;
+    long long prio_arg = 80;
+    const bool args_ok = argc <= 6
+        && (argc <= 1 || parse_arg(argv[1], 1, UINT32_MAX / 1000u, period_arg))
+        && (argc <= 2 || parse_arg(argv[2], 1, 4096, n_axes_arg))
+        && (argc <= 3 || parse_arg_u64(argv[3], n_ticks))
+        && (argc <= 4 || parse_arg(argv[4], -1, 1023, cpu_arg))
+        && (argc <= 5 || parse_arg(argv[5], 0, 99, prio_arg));
+    if (!args_ok) {
+        std::fputs(usage, stderr);
+        return 2;
+    }
+    const uint32_t period_us = static_cast<uint32_t>(period_arg);
+    const int n_axes = static_cast<int>(n_axes_arg);
+    const int cpu = static_cast<int>(cpu_arg);
+    const int prio = static_cast<int>(prio_arg);
+
+    std::vector<SimAxisConfig> cfgs(n_axes, make_axis_cfg());
+    std::vector<SimAxisState> states(n_axes);
+    std::vector<RtAxisCommand> cmds(n_axes, RtAxisCommand{AxisMode::Position, 1.0f, 0.0f, 0.0f});
+    RtSimAxes axes{states.data(), cfgs.data(), cmds.data(), n_axes, period_us * 1e-6f};
+
+    static RtExecutor ex{};
+    const RtExecutorConfig cfg{cpu, prio, true, period_us * 1000u, n_ticks};
+    if (!rt_executor_start(ex, cfg, rt_sim_tick, &axes)) {
+        std::fprintf(stderr, "rt_sim: failed to start executor\n");
+        return 1;
+    }
+    rt_executor_join(ex);
+
+    const RtMetricsSnapshot m = rt_executor_metrics(ex);
+    std::printf("sched_fifo=%d affinity=%d mlock=%d\n", m.rt_sched_ok, m.affinity_ok, m.mlock_ok);
+    std::printf("ticks=%llu overruns=%llu missed=%llu\n",
+                static_cast<unsigned long long>(m.ticks),
+                static_cast<unsigned long long>(m.overruns),
+                static_cast<unsigned long long>(m.missed_periods));
+    std::printf("latency_ns min=%lld mean=%.0f max=%lld\n",
+                static_cast<long long>(m.latency_min_ns), m.latency_mean_ns,
+                static_cast<long long>(m.latency_max_ns));
+    std::printf("exec_ns mean=%.0f max=%lld\n", m.exec_mean_ns,
+                static_cast<long long>(m.exec_max_ns));
+    for (int b = 0; b < rt_hist_bins; ++b) {
+        if (m.latency_hist[b] != 0) {
+            std::printf("  <%lluns: %llu\n", 1ull << (b + 1),
+                        static_cast<unsigned long long>(m.latency_hist[b]));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "partitioned_executor.hpp"
+
+namespace {
+
+AxisCoreConfig make_axis_cfg(int axis)
+{
+    AxisCoreConfig cfg{};
+    cfg.traj = TrajConfig{1.0f + 0.1f * axis, 2.0f};
+    cfg.pos  = PositionLoopConfig{-100.0f, 100.0f, PIConfig{2.0f, 0.0f, -100.0f, 100.0f}};
+    cfg.spd  = SpeedLoopConfig{-10.0f, 10.0f, PIConfig{0.5f, 10.0f, -10.0f, 10.0f}};
+    cfg.cur  = CurrentLoopConfig{0.8f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                 PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.foc  = FocConfig{cfg.cur};
+    cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.lim  = LimitsConfig{-10.0f, 10.0f, -100.0f, 100.0f};
+    return cfg;
+}
+
+void sense(void*, int axis, uint64_t tick, AxisCoreInput& in)
+{
+    float t = static_cast<float>(tick % 2000);
+    in.theta_meas = position64_from_rad(0.0005f * t * (1 + axis % 3));
+    in.theta_elec = 0.002f * t;
+    in.i_abc = {0.1f * (axis % 4), -0.05f, -0.05f};
+}
+
+AxisCoreInput make_command(int axis)
+{
+    AxisCoreInput in{};
+    in.mode = AxisMode::Position;
+    in.theta_target = position64_from_rad(0.5f + 0.01f * axis);
+    in.v_bus = 24.0f;
+    return in;
+}
+
+} // namespace
+
+TEST(SpscMailbox, FifoUntilFull) {
+    static SpscMailbox mb{};
+    for (uint32_t i = 0; i < mailbox_capacity; ++i) {
+        EXPECT_TRUE(mailbox_push(mb, AxisSetpoint{static_cast<uint16_t>(i), position64_from_rad(1.0f * i)}));
+    }
+    EXPECT_FALSE(mailbox_push(mb, AxisSetpoint{0, 0}));
+
+    AxisSetpoint msg{};
+    for (uint32_t i = 0; i < mailbox_capacity; ++i) {
+        ASSERT_TRUE(mailbox_pop(mb, msg));
+        EXPECT_EQ(msg.dst_axis, i);
+    }
+    EXPECT_FALSE(mailbox_pop(mb, msg));
+}
+
+TEST(SpinBarrier, NoThreadRunsAhead) {
+    constexpr int n_threads = 4;
+    constexpr int rounds = 200;
+    SpinBarrier b{};
+    spin_barrier_init(b, n_threads);
+    std::atomic<int> arrived[rounds] = {};
+    std::atomic<bool> ok{true};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&] {
+            bool sense = false;
+            for (int r = 0; r < rounds; ++r) {
+                arrived[r].fetch_add(1);
+                spin_barrier_wait(b, sense);
+                if (arrived[r].load() != n_threads) {
+                    ok = false;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(ok.load());
+}
+
+TEST(PartitionedExecutor, MatchesSequentialReference) {
+    constexpr int n_axes = 10;
+    constexpr uint64_t ticks = 300;
+    std::vector<AxisCoreConfig> cfgs;
+    for (int a = 0; a < n_axes; ++a) {
+        cfgs.push_back(make_axis_cfg(a));
+    }
+    // Axis 7 follows axis 1 (different partitions), axis 3 follows axis 2.
+    const AxisLink links[] = {{1, 7, 2.0f, 0.1f}, {2, 3, 1.0f, 0.0f}};
+
+    PartitionedExecutor ex;
+    PartitionedConfig pcfg{3, -1, 0, ticks, 5e-5f};
+    ASSERT_TRUE(partitioned_setup(ex, pcfg, cfgs.data(), n_axes, links, 2, sense, nullptr, nullptr));
+    for (int a = 0; a < n_axes; ++a) {
+        partitioned_set_command(ex, a, make_command(a));
+    }
+    partitioned_run(ex);
+
+    std::vector<AxisCoreState> st(n_axes);
+    std::vector<AxisCoreInput> in(n_axes);
+    std::vector<AxisCoreOutput> out(n_axes);
+    for (int a = 0; a < n_axes; ++a) {
+        in[a] = make_command(a);
+    }
+    for (uint64_t k = 0; k < ticks; ++k) {
+        for (int a = 0; a < n_axes; ++a) {
+            sense(nullptr, a, k, in[a]);
+            out[a] = run_axis_core(st[a], cfgs[a], in[a], 5e-5f);
+        }
+        for (const AxisLink& l : links) {
+            in[l.dst_axis].theta_target = axis_link_target(l, out[l.src_axis].theta_ref);
+        }
+    }
+
+    for (int a = 0; a < n_axes; ++a) {
+        const AxisCoreOutput& o = partitioned_output(ex, a);
+        EXPECT_FLOAT_EQ(o.m_a, out[a].m_a) << "axis " << a;
+        EXPECT_EQ(o.theta_ref, out[a].theta_ref) << "axis " << a;
+        EXPECT_FLOAT_EQ(partitioned_state(ex, a).spd.iq_pi.integral, st[a].spd.iq_pi.integral);
+    }
+    for (const AxisPartition& p : ex.parts) {
+        EXPECT_EQ(p.mailbox_drops, 0u);
+    }
+}
+
+TEST(PartitionedExecutor, ManyLinksWithinAPartitionAreAllDelivered) {
+    // 100 followers of axis 0, all on its partition: far more than one
+    // mailbox holds, none of them dropped.
+    constexpr int n_axes = 101;
+    std::vector<AxisCoreConfig> cfgs(n_axes, make_axis_cfg(0));
+    std::vector<AxisLink> links;
+    for (int a = 1; a < n_axes; ++a) {
+        links.push_back(AxisLink{0, static_cast<uint16_t>(a), 1.0f, 0.01f * static_cast<float>(a)});
+    }
+
+    PartitionedExecutor ex;
+    PartitionedConfig pcfg{1, -1, 0, 3, 5e-5f};
+    ASSERT_TRUE(partitioned_setup(ex, pcfg, cfgs.data(), n_axes, links.data(),
+                                  static_cast<int>(links.size()), nullptr, nullptr, nullptr));
+    AxisCoreInput in = make_command(0);
+    for (int a = 0; a < n_axes; ++a) {
+        partitioned_set_command(ex, a, in);
+    }
+    partitioned_run(ex);
+
+    EXPECT_EQ(ex.parts[0].mailbox_drops, 0u);
+    const Position64 src_ref = partitioned_output(ex, 0).theta_ref;
+    for (int a = 1; a < n_axes; ++a) {
+        // The follower's input holds the target its last tick produced.
+        EXPECT_EQ(ex.parts[0].inputs[a].theta_target, axis_link_target(links[a - 1], src_ref))
+            << "axis " << a;
+    }
+}
+
+TEST(PartitionedExecutor, SetupRejectsMoreCrossLinksThanAMailboxHolds) {
+    constexpr int n_axes = 2 * (mailbox_capacity + 1);
+    std::vector<AxisCoreConfig> cfgs(n_axes, make_axis_cfg(0));
+    // Partition 0 holds axes 0..64, partition 1 the rest.
+    std::vector<AxisLink> links;
+    for (int a = 0; a < static_cast<int>(mailbox_capacity); ++a) {
+        links.push_back(AxisLink{static_cast<uint16_t>(a),
+                                 static_cast<uint16_t>(n_axes / 2 + a), 1.0f, 0.0f});
+    }
+    PartitionedExecutor ex;
+    PartitionedConfig pcfg{2, -1, 0, 1, 5e-5f};
+    EXPECT_TRUE(partitioned_setup(ex, pcfg, cfgs.data(), n_axes, links.data(),
+                                  static_cast<int>(links.size()), nullptr, nullptr, nullptr));
+
+    links.push_back(AxisLink{static_cast<uint16_t>(mailbox_capacity),
+                             static_cast<uint16_t>(n_axes - 1), 1.0f, 0.0f});
+    PartitionedExecutor over;
+    EXPECT_FALSE(partitioned_setup(over, pcfg, cfgs.data(), n_axes, links.data(),
+                                   static_cast<int>(links.size()), nullptr, nullptr, nullptr));
+
+    // The reverse direction has its own mailbox.
+    links.back() = AxisLink{static_cast<uint16_t>(n_axes - 1), 0, 1.0f, 0.0f};
+    PartitionedExecutor reverse;
+    EXPECT_TRUE(partitioned_setup(reverse, pcfg, cfgs.data(), n_axes, links.data(),
+                                  static_cast<int>(links.size()), nullptr, nullptr, nullptr));
+}
+
+TEST(PartitionedExecutor, SetupRejectsConfigThatDoesNotCompile) {
+    std::vector<AxisCoreConfig> cfgs{make_axis_cfg(0), make_axis_cfg(1)};
+    cfgs[1].lim.w_min = 1.0f;
+    cfgs[1].lim.w_max = -1.0f;
+    PartitionedExecutor ex;
+    PartitionedConfig pcfg{1, -1, 0, 1, 5e-5f};
+    EXPECT_FALSE(partitioned_setup(ex, pcfg, cfgs.data(), 2, nullptr, 0, nullptr, nullptr, nullptr));
+}
+
+TEST(PartitionedExecutor, PublishedConfigTakesOverAtNextTick) {
+    constexpr int n_axes = 4;
+    constexpr uint64_t ticks = 200;
+    std::vector<AxisCoreConfig> cfgs;
+    for (int a = 0; a < n_axes; ++a) {
+        cfgs.push_back(make_axis_cfg(a));
+    }
+    AxisCoreConfig stiff = make_axis_cfg(2);
+    stiff.spd.iq_pi.kp = 2.0f;
+
+    PartitionedExecutor ex;
+    PartitionedConfig pcfg{2, -1, 0, ticks, 5e-5f};
+    ASSERT_TRUE(partitioned_setup(ex, pcfg, cfgs.data(), n_axes, nullptr, 0, sense, nullptr, nullptr));
+    for (int a = 0; a < n_axes; ++a) {
+        partitioned_set_command(ex, a, make_command(a));
+    }
+    partitioned_run(ex);
+    ASSERT_TRUE(partitioned_publish_config(ex, 2, stiff));
+    EXPECT_FALSE(partitioned_publish_config(ex, n_axes, stiff));
+    partitioned_run(ex);
+
+    std::vector<AxisCoreState> st(n_axes);
+    std::vector<AxisCoreOutput> out(n_axes);
+    for (uint64_t k = 0; k < 2 * ticks; ++k) {
+        for (int a = 0; a < n_axes; ++a) {
+            AxisCoreInput in = make_command(a);
+            sense(nullptr, a, k % ticks, in);
+            const AxisCoreConfig& cfg = (a == 2 && k >= ticks) ? stiff : cfgs[a];
+            out[a] = run_axis_core(st[a], cfg, in, 5e-5f);
+        }
+    }
+    for (int a = 0; a < n_axes; ++a) {
+        EXPECT_FLOAT_EQ(partitioned_output(ex, a).m_a, out[a].m_a) << "axis " << a;
+        EXPECT_FLOAT_EQ(partitioned_state(ex, a).spd.iq_pi.integral, st[a].spd.iq_pi.integral);
+    }
+}
+
+namespace {
+
+// Axis 0 feeds axis 1 across partitions; per tick, axis 0's reference and
+// the target axis 1 starts its tick with.
+struct LagRecord {
+    std::vector<Position64> src_ref;
+    std::vector<Position64> dst_target;
+};
+
+void lag_sense(void* user, int axis, uint64_t tick, AxisCoreInput& in)
+{
+    sense(user, axis, tick, in);
+    if (axis == 1) {
+        static_cast<LagRecord*>(user)->dst_target.push_back(in.theta_target);
+        // A slow destination now and then lets the source run ahead.
+        if (tick % 7 == 0) {
+            for (volatile int spin = 0; spin < 20000; ++spin) {
+            }
+        }
+    }
+}
+
+void lag_actuate(void* user, int axis, uint64_t, const AxisCoreOutput& out)
+{
+    if (axis == 0) {
+        static_cast<LagRecord*>(user)->src_ref.push_back(out.theta_ref);
+    }
+}
+
+} // namespace
+
+TEST(PartitionedExecutor, CrossPartitionLinkLagsExactlyOneTick) {
+    constexpr uint64_t ticks = 301;
+    std::vector<AxisCoreConfig> cfgs{make_axis_cfg(0), make_axis_cfg(1)};
+    const AxisLink link{0, 1, 1.0f, 0.0f};
+    LagRecord rec;
+    rec.src_ref.reserve(2 * ticks);
+    rec.dst_target.reserve(2 * ticks);
+
+    PartitionedExecutor ex;
+    ASSERT_TRUE(partitioned_setup(ex, PartitionedConfig{2, -1, 0, ticks, 5e-5f}, cfgs.data(), 2,
+                                  &link, 1, lag_sense, lag_actuate, &rec));
+    ASSERT_EQ(ex.parts.size(), 2u);
+    for (int a = 0; a < 2; ++a) {
+        partitioned_set_command(ex, a, make_command(a));
+    }
+    // An odd tick count, run twice, also covers the hand-over between runs.
+    partitioned_run(ex);
+    partitioned_run(ex);
+
+    ASSERT_EQ(rec.src_ref.size(), 2 * ticks);
+    ASSERT_EQ(rec.dst_target.size(), 2 * ticks);
+    int late = 0;
+    for (size_t k = 1; k < rec.dst_target.size(); ++k) {
+        late += rec.dst_target[k] == axis_link_target(link, rec.src_ref[k - 1]) ? 1 : 0;
+    }
+    EXPECT_EQ(late, static_cast<int>(2 * ticks - 1));
+    EXPECT_NE(rec.src_ref.front(), rec.src_ref.back());
+    EXPECT_EQ(ex.parts[0].mailbox_drops, 0u);
+}
+
+TEST(PartitionedExecutor, MoreWorkersThanAxesCollapsesPartitions) {
+    std::vector<AxisCoreConfig> cfgs{make_axis_cfg(0), make_axis_cfg(1)};
+    PartitionedExecutor ex;
+    ASSERT_TRUE(partitioned_setup(ex, PartitionedConfig{8, -1, 0, 10, 5e-5f},
+                                  cfgs.data(), 2, nullptr, 0, sense, nullptr, nullptr));
+    EXPECT_EQ(ex.parts.size(), 2u);
+    partitioned_run(ex);
+    EXPECT_EQ(ex.ticks_done, 10u);
+    EXPECT_EQ(ex.sleep_error, 0);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "plan_exchange.hpp"
+
+namespace {
+
+// Every field the check reads is derived from k, so a plan assembled from
+// two publications cannot pass check_plan.
+AxisCoreConfig make_cfg(int k)
+{
+    const float g = static_cast<float>(k);
+    AxisCoreConfig cfg{};
+    cfg.traj = TrajConfig{g, 2.0f * g};
+    cfg.pos  = PositionLoopConfig{-g, g, PIConfig{g, 0.0f, -g, g}};
+    cfg.spd  = SpeedLoopConfig{-g, g, PIConfig{g, 2.0f * g, -g, g}};
+    cfg.cur  = CurrentLoopConfig{0.5f, PIConfig{g, g, -g, g}, PIConfig{g, g, -g, g}};
+    cfg.foc  = FocConfig{cfg.cur};
+    cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.lim  = LimitsConfig{-g, g, -g, g};
+    cfg.dtc  = DeadtimeCompConfig{0.01f * g, 0.1f};
+    return cfg;
+}
+
+int check_plan(const AxisCorePlan& p)
+{
+    const float g = p.traj.max_vel;
+    bool ok = p.traj.max_acc == 2.0f * g
+           && p.pos.w_max == g && p.pos.pos_pi.kp == g
+           && p.spd.iq_max == g && p.spd.iq_pi.kp == g
+           && p.foc.loop.id.kp == g && p.foc.loop.iq.out_max == g
+           && p.lim.iq_max == g && p.lim.w_min == -g
+           && p.dtc.v_comp == 0.01f * g;
+    return ok ? static_cast<int>(g) : -1;
+}
+
+} // namespace
+
+TEST(PlanExchange, ReaderSwitchesOnlyAtAcquire) {
+    auto ex = std::make_unique<PlanExchange>();
+    AxisCorePlan plan;
+    ASSERT_TRUE(compile_axis_config(plan, make_cfg(1), 5e-5f));
+    plan_exchange_init(*ex, plan);
+
+    const AxisCorePlan* cur = &plan_exchange_acquire(*ex);
+    EXPECT_EQ(check_plan(*cur), 1);
+
+    ASSERT_TRUE(plan_exchange_publish(*ex, make_cfg(2), 5e-5f));
+    ASSERT_TRUE(plan_exchange_publish(*ex, make_cfg(3), 5e-5f));
+    // The plan in use is untouched until the reader comes back for more.
+    EXPECT_EQ(check_plan(*cur), 1);
+
+    cur = &plan_exchange_acquire(*ex);
+    EXPECT_EQ(check_plan(*cur), 3);
+    EXPECT_EQ(check_plan(plan_exchange_acquire(*ex)), 3);
+    EXPECT_EQ(ex->published, 2u);
+    EXPECT_EQ(ex->picked_up, 1u);
+}
+
+TEST(PlanExchange, ConfigThatDoesNotCompileIsNotPublished) {
+    auto ex = std::make_unique<PlanExchange>();
+    AxisCorePlan plan;
+    ASSERT_TRUE(compile_axis_config(plan, make_cfg(1), 5e-5f));
+    plan_exchange_init(*ex, plan);
+
+    AxisCoreConfig bad = make_cfg(2);
+    bad.lim.iq_min = 5.0f;
+    EXPECT_FALSE(plan_exchange_publish(*ex, bad, 5e-5f));
+    EXPECT_EQ(check_plan(plan_exchange_acquire(*ex)), 1);
+    EXPECT_EQ(ex->published, 0u);
+}
+
+TEST(PlanExchange, NoTornReadsUnderConcurrentPublish) {
+    constexpr int n_publish = 20000;
+    auto ex = std::make_unique<PlanExchange>();
+    AxisCorePlan plan;
+    ASSERT_TRUE(compile_axis_config(plan, make_cfg(1), 5e-5f));
+    plan_exchange_init(*ex, plan);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int k = 2; k <= n_publish; ++k) {
+            plan_exchange_publish(*ex, make_cfg(k), 5e-5f);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    int last = 1;
+    int torn = 0;
+    int went_back = 0;
+    uint64_t reads = 0;
+    for (;;) {
+        bool finished = done.load(std::memory_order_acquire);
+        int k = check_plan(plan_exchange_acquire(*ex));
+        ++reads;
+        if (k < 0) {
+            ++torn;
+        } else {
+            if (k < last) {
+                ++went_back;
+            }
+            last = k;
+        }
+        if (finished) {
+            break;
+        }
+    }
+    writer.join();
+
+    RecordProperty("reads", std::to_string(reads));
+    RecordProperty("picked_up", std::to_string(ex->picked_up));
+    EXPECT_EQ(torn, 0);
+    EXPECT_EQ(went_back, 0);
+    // The read after the writer finished must see its last publication.
+    EXPECT_EQ(last, n_publish);
+    EXPECT_GE(ex->picked_up, 1u);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <ctime>
+#include "rt_executor.hpp"
+#include "rt_sim_driver.hpp"
+
+namespace {
+
+void count_tick(void* user, uint64_t)
+{
+    ++*static_cast<int*>(user);
+}
+
+void busy_tick(void* user, uint64_t tick)
+{
+    // Every 10th tick burns three periods to force an overrun.
+    if (tick % 10 == 5) {
+        timespec d{0, 3 * static_cast<long>(*static_cast<uint32_t*>(user))};
+        nanosleep(&d, nullptr);
+    }
+}
+
+SimAxisConfig make_axis_cfg()
+{
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.traj = TrajConfig{1.0f, 2.0f};
+    cfg.axis_cfg.pos  = PositionLoopConfig{-50.0f, 50.0f};
+    cfg.axis_cfg.spd  = SpeedLoopConfig{-50.0f, 50.0f};
+    cfg.axis_cfg.cur  = CurrentLoopConfig{0.8f};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-50.0f, 50.0f, -50.0f, 50.0f};
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.00001f;
+    cfg.motor_params.B = 0.01f;
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+void on_signal(int) {}
+
+} // namespace
+
+TEST(RtExecutor, RunsRequestedTicksWithoutPrivileges) {
+    static RtExecutor ex{};
+    int count = 0;
+    // Priority and mlock are requested; in an unprivileged container they
+    // are refused and the loop must still run under SCHED_OTHER.
+    const RtExecutorConfig cfg{0, 80, true, 200000, 50};
+    ASSERT_TRUE(rt_executor_start(ex, cfg, count_tick, &count));
+    rt_executor_join(ex);
+
+    const RtMetricsSnapshot m = rt_executor_metrics(ex);
+    EXPECT_EQ(count, 50);
+    EXPECT_EQ(m.ticks, 50u);
+    EXPECT_GE(m.latency_min_ns, 0);
+    EXPECT_LE(m.latency_min_ns, m.latency_max_ns);
+    EXPECT_GE(m.latency_mean_ns, static_cast<double>(m.latency_min_ns));
+    EXPECT_LE(m.latency_mean_ns, static_cast<double>(m.latency_max_ns));
+    EXPECT_EQ(m.sleep_error, 0);
+
+    uint64_t hist_total = 0;
+    for (uint64_t h : m.latency_hist) {
+        hist_total += h;
+    }
+    EXPECT_EQ(hist_total, m.ticks);
+}
+
+TEST(RtExecutor, CountsOverrunsAndSkipsMissedSlots) {
+    static RtExecutor ex{};
+    uint32_t period = 1000000;
+    const RtExecutorConfig cfg{-1, 0, false, period, 30};
+    ASSERT_TRUE(rt_executor_start(ex, cfg, busy_tick, &period));
+    rt_executor_join(ex);
+
+    const RtMetricsSnapshot m = rt_executor_metrics(ex);
+    EXPECT_EQ(m.ticks, 30u);
+    EXPECT_GE(m.overruns, 3u);
+    EXPECT_GE(m.missed_periods, 3u * 3u);
+    EXPECT_GE(m.exec_max_ns, 3 * static_cast<int64_t>(period));
+}
+
+TEST(RtExecutor, StopEndsOpenEndedRun) {
+    static RtExecutor ex{};
+    int count = 0;
+    const RtExecutorConfig cfg{-1, 0, false, 100000, 0};
+    ASSERT_TRUE(rt_executor_start(ex, cfg, count_tick, &count));
+    EXPECT_FALSE(rt_executor_start(ex, cfg, count_tick, &count));
+
+    timespec d{0, 20000000};
+    nanosleep(&d, nullptr);
+    rt_executor_request_stop(ex);
+    rt_executor_join(ex);
+
+    EXPECT_GT(rt_executor_metrics(ex).ticks, 0u);
+}
+
+TEST(RtExecutor, DrivesSimulatedAxes) {
+    static RtExecutor ex{};
+    constexpr int n_axes = 3;
+    SimAxisConfig cfgs[n_axes] = {make_axis_cfg(), make_axis_cfg(), make_axis_cfg()};
+    SimAxisState states[n_axes]{};
+    RtAxisCommand cmds[n_axes]{};
+    for (int a = 0; a < n_axes; ++a) {
+        cfgs[a].axis_cfg.spd.iq_pi = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+        cfgs[a].axis_cfg.foc.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+        cfgs[a].axis_cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+        cmds[a] = RtAxisCommand{AxisMode::CurrentIq, 0.0f, 0.0f, 0.5f * (a + 1)};
+    }
+    RtSimAxes axes{states, cfgs, cmds, n_axes, 5e-5f};
+
+    const RtExecutorConfig cfg{-1, 0, false, 50000, 400};
+    ASSERT_TRUE(rt_executor_start(ex, cfg, rt_sim_tick, &axes));
+    rt_executor_join(ex);
+
+    EXPECT_EQ(rt_executor_metrics(ex).ticks, 400u);
+    for (int a = 1; a < n_axes; ++a) {
+        EXPECT_GT(states[a].motor_state.omega_m, states[a - 1].motor_state.omega_m);
+    }
+    EXPECT_GT(states[0].motor_state.omega_m, 0.0f);
+}
+
+TEST(RtExecutor, SignalsInterruptingTheSleepAreRetried) {
+    struct sigaction sa{};
+    sa.sa_handler = on_signal;
+    struct sigaction old{};
+    ASSERT_EQ(sigaction(SIGUSR1, &sa, &old), 0);
+
+    static RtExecutor ex{};
+    int count = 0;
+    const RtExecutorConfig cfg{-1, 0, false, 1000000, 40};
+    ASSERT_TRUE(rt_executor_start(ex, cfg, count_tick, &count));
+    for (int k = 0; k < 20; ++k) {
+        pthread_kill(ex.thread, SIGUSR1);
+        timespec d{0, 1500000};
+        nanosleep(&d, nullptr);
+    }
+    rt_executor_join(ex);
+    sigaction(SIGUSR1, &old, nullptr);
+
+    const RtMetricsSnapshot m = rt_executor_metrics(ex);
+    EXPECT_EQ(m.sleep_error, 0);
+    EXPECT_EQ(m.ticks, 40u);
+}
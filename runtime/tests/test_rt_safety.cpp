@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+#include "axis_core.hpp"
+#include "plan_exchange.hpp"
+#include "rt_safety.hpp"
+#include "sim_axis_runner.hpp"
+
+namespace {
+
+void allocating_tick(void* user, uint64_t tick)
+{
+    auto* sink = static_cast<std::vector<float>*>(user);
+    std::vector<float> v(8, static_cast<float>(tick));
+    (*sink)[0] += v[7];
+}
+
+void locking_tick(void* user, uint64_t)
+{
+    std::lock_guard<std::mutex> lock(*static_cast<std::mutex*>(user));
+}
+
+void syscall_tick(void* user, uint64_t)
+{
+    *static_cast<long*>(user) += syscall(SYS_getpid);
+}
+
+AxisCoreConfig make_axis_cfg()
+{
+    AxisCoreConfig cfg{};
+    cfg.traj = TrajConfig{1.0f, 2.0f};
+    cfg.pos  = PositionLoopConfig{-100.0f, 100.0f};
+    cfg.spd  = SpeedLoopConfig{-100.0f, 100.0f};
+    cfg.cur  = CurrentLoopConfig{0.8f};
+    cfg.foc  = FocConfig{cfg.cur};
+    cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.lim  = LimitsConfig{-100.0f, 100.0f, -100.0f, 100.0f};
+    cfg.dtc  = DeadtimeCompConfig{0.2f, 0.1f};
+    cfg.rate = MultirateConfig{4, 8, 1};
+    return cfg;
+}
+
+struct AxisCoreHarness {
+    AxisCoreState st;
+    AxisGuardState guard;
+    AxisCoreConfig cfg;
+};
+
+void axis_core_tick(void* user, uint64_t tick)
+{
+    auto& h = *static_cast<AxisCoreHarness*>(user);
+    AxisCoreInput in{};
+    in.mode = (tick / 500) % 2 == 0 ? AxisMode::Position : AxisMode::Velocity;
+    in.theta_meas = position64_from_rad(0.001f * static_cast<float>(tick % 1000));
+    in.i_abc = {0.3f, -0.1f, -0.2f};
+    in.theta_target = position64_from_rad(1.0f);
+    in.w_target = 5.0f;
+    in.v_bus = 24.0f;
+    in.theta_elec = 0.004f * static_cast<float>(tick % 1000);
+    run_axis_core(h.st, h.guard, h.cfg, in, 5e-5f);
+}
+
+struct PlanSwapHarness {
+    AxisCoreState st;
+    AxisCoreConfig cfgs[2];
+    PlanExchange ex;
+};
+
+// Publishes on the RT thread too, so compiling a plan is covered as well
+// as picking it up.
+void plan_swap_tick(void* user, uint64_t tick)
+{
+    auto& h = *static_cast<PlanSwapHarness*>(user);
+    if (tick % 100 == 0) {
+        plan_exchange_publish(h.ex, h.cfgs[(tick / 100) % 2], 5e-5f);
+    }
+    AxisCoreInput in{};
+    in.mode = AxisMode::Velocity;
+    in.theta_meas = position64_from_rad(0.001f * static_cast<float>(tick % 1000));
+    in.i_abc = {0.3f, -0.1f, -0.2f};
+    in.w_target = 5.0f;
+    in.v_bus = 24.0f;
+    run_axis_plan(h.st, plan_exchange_acquire(h.ex), in);
+}
+
+struct FocHarness {
+    FocState st;
+    FocConfig cfg;
+};
+
+void foc_tick(void* user, uint64_t tick)
+{
+    auto& h = *static_cast<FocHarness*>(user);
+    FocInput in{};
+    in.i_abc = {0.5f, -0.25f, -0.25f};
+    in.theta_elec = 0.01f * static_cast<float>(tick % 600);
+    in.i_setpoint = DQ{0.0f, 2.0f};
+    in.v_bus = 24.0f;
+    run_foc(h.st, h.cfg, in, 5e-5f);
+}
+
+struct SimHarness {
+    SimAxisState st;
+    SimAxisConfig cfg;
+};
+
+void sim_tick(void* user, uint64_t)
+{
+    auto& h = *static_cast<SimHarness*>(user);
+    sim_axis_step(h.st, h.cfg, 5e-5f, AxisMode::Velocity, 0.0f, 20.0f, 0.0f);
+}
+
+SimHarness make_sim_harness()
+{
+    SimHarness h{};
+    h.cfg.axis_cfg = make_axis_cfg();
+    h.cfg.motor_params.Rs = 0.1f;
+    h.cfg.motor_params.Ls = 0.001f;
+    h.cfg.motor_params.psi_m = 0.05f;
+    h.cfg.motor_params.p = 4.0f;
+    h.cfg.motor_params.J = 1e-4f;
+    h.cfg.motor_params.B = 1e-4f;
+    h.cfg.load.T_coulomb = 0.01f;
+    h.cfg.load.cog_amp = 0.002f;
+    h.cfg.load.cog_periods = 6.0f;
+    h.cfg.inverter.t_dead = 5e-7f;
+    h.cfg.inverter.f_pwm = 20000.0f;
+    h.cfg.v_bus = 24.0f;
+    h.cfg.axis_cfg.spd.iq_pi = PIConfig{0.05f, 1.0f, -5.0f, 5.0f};
+    h.cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    h.cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    return h;
+}
+
+} // namespace
+
+TEST(RtSafety, HooksAreLinked) {
+    RtSafetyReport r = rt_safety_check([](void*, uint64_t) {}, nullptr, 10);
+    EXPECT_TRUE(r.hooks_installed);
+    if (!r.syscalls_checked) {
+        GTEST_SKIP() << "seccomp strict mode unavailable";
+    }
+    EXPECT_TRUE(r.ok);
+}
+
+TEST(RtSafety, DetectsAllocation) {
+    std::vector<float> sink(1, 0.0f);
+    RtSafetyReport r = rt_safety_check(allocating_tick, &sink, 10);
+    EXPECT_EQ(r.allocations, 10u);
+    EXPECT_EQ(r.frees, 10u);
+    EXPECT_FALSE(r.ok);
+}
+
+TEST(RtSafety, PosixMemalignHookFollowsPosix) {
+    void* p = nullptr;
+    EXPECT_EQ(posix_memalign(&p, 3 * sizeof(void*), 64), EINVAL);
+    EXPECT_EQ(posix_memalign(&p, sizeof(void*) / 2, 64), EINVAL);
+    EXPECT_EQ(posix_memalign(&p, 0, 64), EINVAL);
+    EXPECT_EQ(p, nullptr);
+
+    ASSERT_EQ(posix_memalign(&p, 64, 64), 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+    free(p);
+
+    EXPECT_EQ(posix_memalign(&p, 64, static_cast<size_t>(-1) / 2), ENOMEM);
+}
+
+TEST(RtSafety, DetectsLock) {
+    std::mutex m;
+    RtSafetyReport r = rt_safety_check(locking_tick, &m, 10);
+    EXPECT_EQ(r.locks, 10u);
+    EXPECT_FALSE(r.ok);
+}
+
+TEST(RtSafety, DetectsSyscall) {
+    long sink = 0;
+    RtSafetyReport r = rt_safety_check(syscall_tick, &sink, 10);
+    EXPECT_EQ(r.allocations, 0u);
+    if (!r.syscalls_checked) {
+        GTEST_SKIP() << "seccomp strict mode unavailable";
+    }
+    EXPECT_FALSE(r.syscall_free);
+    EXPECT_FALSE(r.ok);
+}
+
+TEST(RtSafety, AxisCoreTickIsRealTimeSafe) {
+    AxisCoreHarness h{};
+    h.cfg = make_axis_cfg();
+    h.cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -100.0f, 100.0f};
+    h.cfg.spd.iq_pi = PIConfig{0.5f, 10.0f, -10.0f, 10.0f};
+    h.cfg.foc.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    h.cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    h.cfg.prot = ProtectionConfig{50.0f, 10.0f, 100.0f, 10.0f, 20.0f, 0.1f, 1.0f, 1000.0f};
+
+    RtSafetyReport r = rt_safety_check(axis_core_tick, &h, 2000);
+    EXPECT_EQ(r.allocations, 0u);
+    EXPECT_EQ(r.locks, 0u);
+    EXPECT_EQ(r.frees, 0u);
+    if (!r.syscalls_checked) {
+        GTEST_SKIP() << "seccomp strict mode unavailable";
+    }
+    EXPECT_TRUE(r.syscall_free);
+    EXPECT_TRUE(r.ok);
+}
+
+TEST(RtSafety, PlanSwapIsRealTimeSafe) {
+    auto h = std::make_unique<PlanSwapHarness>();
+    h->cfgs[0] = make_axis_cfg();
+    h->cfgs[0].spd.iq_pi = PIConfig{0.5f, 10.0f, -10.0f, 10.0f};
+    h->cfgs[1] = h->cfgs[0];
+    h->cfgs[1].spd.iq_pi.kp = 1.0f;
+    AxisCorePlan plan;
+    ASSERT_TRUE(compile_axis_config(plan, h->cfgs[0], 5e-5f));
+    plan_exchange_init(h->ex, plan);
+
+    RtSafetyReport r = rt_safety_check(plan_swap_tick, h.get(), 2000);
+    EXPECT_EQ(r.allocations, 0u);
+    EXPECT_EQ(r.locks, 0u);
+    EXPECT_GT(h->ex.picked_up, 0u);
+    if (!r.syscalls_checked) {
+        GTEST_SKIP() << "seccomp strict mode unavailable";
+    }
+    EXPECT_TRUE(r.ok);
+}
+
+TEST(RtSafety, FocTickIsRealTimeSafe) {
+    FocHarness h{};
+    h.cfg = FocConfig{CurrentLoopConfig{0.8f}};
+    h.cfg.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    h.cfg.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+
+    RtSafetyReport r = rt_safety_check(foc_tick, &h, 2000);
+    EXPECT_EQ(r.allocations, 0u);
+    if (!r.syscalls_checked) {
+        GTEST_SKIP() << "seccomp strict mode unavailable";
+    }
+    EXPECT_TRUE(r.ok);
+}
+
+TEST(RtSafety, SimAxisStepIsRealTimeSafe) {
+    SimHarness h = make_sim_harness();
+    RtSafetyReport r = rt_safety_check(sim_tick, &h, 2000);
+    EXPECT_EQ(r.allocations, 0u);
+
+    SimHarness hs = make_sim_harness();
+    hs.cfg.switched_pwm = true;
+    RtSafetyReport rs = rt_safety_check(sim_tick, &hs, 200);
+    EXPECT_EQ(rs.allocations, 0u);
+    if (!r.syscalls_checked) {
+        GTEST_SKIP() << "seccomp strict mode unavailable";
+    }
+    EXPECT_TRUE(r.ok);
+    EXPECT_TRUE(rs.ok);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+struct InverterParams {
+    float t_dead;
+    float f_pwm;
+    float v_sw;
+    float r_on;
+    float i_dead_band;
+    int   pwm_counts;
+};
+
+struct InverterInput {
+    float m_a;
+    float m_b;
+    float m_c;
+    float ia;
+    float ib;
+    float ic;
+    float v_bus;
+    bool gates_off;     // every device off; the legs float
+    float ea;           // phase back-EMF (v = R i + L di/dt + e), read
+    float eb;           // only with gates_off
+    float ec;
+};
+
+struct InverterOutput {
+    float va;
+    float vb;
+    float vc;
+    bool leg_open[3];   // gates_off only: the leg carries no current
+};
+
+// With gates_off a leg carrying current is clamped to a rail by the diode
+// that current forward-biases, and a leg carrying none floats at its own
+// back-EMF above the star point. An idle winding only starts conducting
+// once its line EMF overcomes the bus, as into a diode rectifier.
+InverterOutput inverter_step(
+    const InverterParams& params,
+    const InverterInput& in) noexcept;
+
+// A diode does not conduct backwards: after a step with the gates off, a
+// current that crossed zero stops there, an open leg's current stays zero,
+// and what is left is rebalanced so the star currents still sum to zero.
+void inverter_off_settle(
+    const InverterOutput& out,
+    const float i_prev[3],
+    float i[3]) noexcept;
@@ -0,0 +1,54 @@
+#pragma once
+
+struct LoadContext {
+    float omega_m;
+    float theta_e;
+    float omega_load;
+};
+
+using LoadTorqueFn = float (*)(const LoadContext& ctx, void* user);
+
+struct LoadTable {
+    const float* w;
+    const float* torque;
+    int n;
+};
+
+struct LoadParams {
+    float T_const;
+    float T_coulomb;
+    float T_stribeck;
+    float w_stribeck;
+    float w_coulomb_band;
+    float B_viscous;
+    float cog_amp;
+    float cog_periods;      // per electrical turn; a whole number, see load_params_valid
+    float cog_phase;
+    float k_shaft;
+    float c_shaft;
+    float J_load;
+    float B_load;
+    LoadTable table;
+    LoadTorqueFn fn;
+    void* user;
+};
+
+struct LoadTorques {
+    float T_rotor;
+    float T_load_net;
+};
+
+[[nodiscard]] inline bool load_has_shaft(const LoadParams& load) noexcept {
+    return load.J_load > 0.0f && load.k_shaft > 0.0f;
+}
+
+// Cogging is driven from the wrapped electrical angle, so it is only
+// continuous for a whole number of periods per electrical turn. A real
+// machine always has one: lcm(slots, 2p) periods per mechanical turn is
+// lcm(slots, 2p) / p per electrical turn, which divides exactly.
+bool load_params_valid(const LoadParams& load) noexcept;
+
+LoadTorques load_torques(
+    const LoadParams& load,
+    const LoadContext& ctx,
+    float shaft_twist) noexcept;
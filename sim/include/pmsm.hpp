@@ -1,5 +1,7 @@
 #pragma once
 
+#include "load_model.hpp"
+
 struct PmsmParams {
     float Rs;
     float Ls;
@@ -15,6 +17,8 @@ struct PmsmState {
     float ic;
     float omega_m;
     float theta_e;
+    float shaft_twist;
+    float omega_load;
 };
 
 struct PmsmInput {
@@ -31,10 +35,30 @@ struct PmsmOutput {
     float omega_m;
     float theta_e;
     float torque;
+    float T_load;
+};
+
+struct PmsmBackEmf {
+    float ea;
+    float eb;
+    float ec;
 };
 
+// Phase back-EMF in the sense v = Rs i + Ls di/dt + e, which is the phase
+// voltage that holds a zero current at zero.
+PmsmBackEmf pmsm_back_emf(
+    const PmsmState& state,
+    const PmsmParams& params) noexcept;
+
+PmsmOutput pmsm_step(
+    PmsmState& state,
+    const PmsmParams& params,
+    const PmsmInput& input,
+    float dt) noexcept;
+
 PmsmOutput pmsm_step(
     PmsmState& state,
     const PmsmParams& params,
+    const LoadParams& load,
     const PmsmInput& input,
-    float dt) noexcept;
\ No newline at end of file
+    float dt) noexcept;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "pmsm.hpp"
+#include "load_model.hpp"
+
+struct FluxMapNode {
+    float id;
+    float iq;
+};
+
+struct PmsmFluxMap {
+    const FluxMapNode* nodes;
+    int n_d;
+    int n_q;
+    float psi_d_min;
+    float psi_q_min;
+    float inv_step_d;
+    float inv_step_q;
+    float psi_d0;
+};
+
+struct SaturationModel {
+    float psi_m;
+    float Ld;
+    float Lq;
+    float i_sat;
+    float k_inf;
+    float k_cross;
+};
+
+struct PmsmFluxState {
+    float psi_d;
+    float psi_q;
+    bool initialized;
+};
+
+void saturation_model_flux(
+    const SaturationModel& model,
+    float id,
+    float iq,
+    float& psi_d,
+    float& psi_q) noexcept;
+
+bool fluxmap_build(
+    PmsmFluxMap& map,
+    FluxMapNode* nodes,
+    int n_d,
+    int n_q,
+    float psi_d_min,
+    float psi_d_max,
+    float psi_q_min,
+    float psi_q_max,
+    const SaturationModel& model) noexcept;
+
+FluxMapNode fluxmap_lookup(
+    const PmsmFluxMap& map,
+    float psi_d,
+    float psi_q) noexcept;
+
+PmsmOutput pmsm_fluxmap_step(
+    PmsmState& state,
+    PmsmFluxState& flux,
+    const PmsmParams& params,
+    const PmsmFluxMap& map,
+    const LoadParams& load,
+    const PmsmInput& input,
+    float dt) noexcept;
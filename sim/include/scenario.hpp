@@ -0,0 +1,163 @@
+#pragma once
+
+// C++20: build targets including this header with CXX_STANDARD 20.
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sim_axis_runner.hpp"
+
+enum class ScenarioWaitKind {
+    None,
+    Ticks,
+    Settled,
+    Ramp,
+    Until,
+};
+
+struct ScenarioContext;
+
+using ScenarioPredicate = bool (*)(const ScenarioContext& ctx, void* user);
+
+struct ScenarioWait {
+    ScenarioWaitKind kind;
+    uint64_t deadline;
+    uint64_t start;
+    uint64_t hold_ticks;
+    uint64_t held;
+    float pos_tol;
+    float w_tol;
+    float w_from;
+    float w_to;
+    ScenarioPredicate pred;
+    void* pred_user;
+    bool result;
+};
+
+// Everything one scenario owns: its own plant, config copy (so load steps
+// and parameter changes stay local) and the current axis command.
+struct ScenarioContext {
+    SimAxisConfig cfg;
+    SimAxisState st;
+    float dt;
+    AxisMode mode;
+    float theta_target;
+    float w_target;
+    float iq_target;
+    uint64_t tick;
+    AxisCoreOutput out;
+    ScenarioWait wait;
+};
+
+struct Scenario {
+    struct promise_type {
+        bool passed = false;
+
+        Scenario get_return_object() noexcept
+        {
+            return Scenario{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(bool ok) noexcept { passed = ok; }
+        void unhandled_exception() noexcept { passed = false; }
+    };
+
+    explicit Scenario(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+    Scenario(Scenario&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Scenario(const Scenario&) = delete;
+    Scenario& operator=(const Scenario&) = delete;
+    Scenario& operator=(Scenario&&) = delete;
+    ~Scenario()
+    {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Suspends the scenario until the runner finds ctx.wait satisfied; the
+// co_await result is false when a Settled/Until wait timed out.
+struct ScenarioAwaiter {
+    ScenarioContext& ctx;
+
+    bool await_ready() const noexcept { return ctx.wait.kind == ScenarioWaitKind::None; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    bool await_resume() const noexcept { return ctx.wait.result; }
+};
+
+// Commands take effect on the next tick.
+void move_to(ScenarioContext& ctx, float theta) noexcept;
+void set_speed(ScenarioContext& ctx, float w) noexcept;
+void set_current(ScenarioContext& ctx, float iq) noexcept;
+void apply_load_step(ScenarioContext& ctx, float torque) noexcept;
+
+ScenarioAwaiter wait_for(ScenarioContext& ctx, float seconds) noexcept;
+// Resumes true once the axis has stayed inside both bands for hold_s (at
+// least one tick), false at the timeout.
+ScenarioAwaiter settle(
+    ScenarioContext& ctx,
+    float pos_tol,
+    float w_tol,
+    float hold_s,
+    float timeout_s) noexcept;
+ScenarioAwaiter ramp_speed(ScenarioContext& ctx, float w_end, float seconds) noexcept;
+ScenarioAwaiter wait_until(
+    ScenarioContext& ctx,
+    ScenarioPredicate pred,
+    void* user,
+    float timeout_s) noexcept;
+
+struct ScenarioResult {
+    bool done;
+    bool passed;
+    uint64_t ticks;
+};
+
+struct ScenarioSlot {
+    std::unique_ptr<ScenarioContext> ctx;
+    Scenario task;
+};
+
+struct ScenarioRunner {
+    std::vector<ScenarioSlot> slots;
+};
+
+ScenarioContext& scenario_context(
+    ScenarioRunner& runner,
+    const SimAxisConfig& cfg,
+    float dt);
+
+// Whatever task's frame refers to must outlive the runner; see
+// scenario_spawn.
+int scenario_start(ScenarioRunner& runner, ScenarioContext& ctx, Scenario task);
+
+// Creates a context and starts fn(ctx, args...) on it; returns its id.
+// fn must be a plain function: a lambda coroutine's frame refers to the
+// lambda object for its captures, and the copy here dies on return. A
+// captureless lambda can be passed as +[](ScenarioContext&) -> Scenario.
+// Arguments are taken into the frame by the coroutine's own parameters.
+template <typename Fn, typename... Args>
+int scenario_spawn(
+    ScenarioRunner& runner,
+    const SimAxisConfig& cfg,
+    float dt,
+    Fn fn,
+    Args&&... args)
+{
+    static_assert(std::is_pointer_v<Fn> && std::is_function_v<std::remove_pointer_t<Fn>>,
+                  "scenario_spawn needs a function, not a callable object");
+    ScenarioContext& ctx = scenario_context(runner, cfg, dt);
+    return scenario_start(runner, ctx, fn(ctx, std::forward<Args>(args)...));
+}
+
+// Round-robins every unfinished scenario one tick at a time in the
+// calling thread until all complete or max_ticks ticks have passed for
+// each. Returns the number still running.
+int scenario_run(ScenarioRunner& runner, uint64_t max_ticks);
+
+ScenarioResult scenario_result(const ScenarioRunner& runner, int id) noexcept;
@@ -1,21 +1,55 @@
 #pragma once
 
 #include "pmsm.hpp"
+#include "pmsm_fluxmap.hpp"
+#include "inverter.hpp"
+#include "switched_inverter.hpp"
 #include "axis_core.hpp"
+#include "angle.hpp"
+#include "sim_encoder.hpp"
+#include "thermal_model.hpp"
+#include "sim_current_sensor.hpp"
 
 struct SimAxisConfig {
     AxisCoreConfig axis_cfg;
     PmsmParams motor_params;
+    LoadParams load;
+    const PmsmFluxMap* flux_map;    // nullptr = linear model; averaged PWM only
+    InverterParams inverter;
     float v_bus;
+    bool switched_pwm;              // integrates the linear model; not with flux_map
+    const SimEncoderConfig* encoder;  // nullptr = ideal angle measurement
+    const ThermalParams* thermal;     // nullptr = motor_params at all loads
+    const SimCurrentSensorConfig* current_sensor;  // nullptr = exact phase currents
 };
 
 struct SimAxisState {
     AxisCoreState axis_state;
+    AxisGuardState guard;
     PmsmState motor_state;
-    float theta_mech;
+    PmsmFluxState flux_state;
+    Position64 theta_e_acc;  // unwrapped electrical angle
+    Position64 theta_mech;   // theta_e_acc / p, kept in step with it
+    EncoderState encoder;
+    int64_t t_ns;
+    ThermalState thermal;
+    SimCurrentSensorState current_sensor;
+    AxisCorePlan plan;       // cfg.axis_cfg compiled for plan_dt
+    float plan_dt;           // 0 = not compiled yet
+    bool plan_ok;
 };
 
-void sim_axis_step(
+// Compiles cfg.axis_cfg into st.plan for steps of dt and returns whether
+// the config is valid. So must the load be (load_params_valid), and
+// switched_pwm together with a flux_map is not supported. sim_axis_step does this itself on its first step
+// and whenever dt changes; call it again after changing cfg.axis_cfg.
+bool sim_axis_prepare(SimAxisState& st, const SimAxisConfig& cfg, float dt) noexcept;
+
+// With an invalid axis config the controller is not run: the step leaves
+// the gates off and only the plant advances. Whenever pwm_enable is false
+// the inverter floats the legs instead of applying m_abc.
+
+AxisCoreOutput sim_axis_step(
     SimAxisState& st,
     const SimAxisConfig& cfg,
     float dt,
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "foc_math.hpp"
+
+#include <cstdint>
+
+constexpr int sim_current_sensor_max_delay = 7;
+
+// Phase-current sensing as the controller's ADC sees it: per-channel gain
+// error and offset, white noise, clipping at full scale and quantization,
+// read out delay_ticks control ticks late. A two-shunt board has no
+// channel c, which reads 0. A zeroed config is an exact, immediate sensor.
+struct SimCurrentSensorConfig {
+    bool two_shunt;
+    PhaseCurrents offset;       // A
+    PhaseCurrents gain_err;     // relative, 0 = exact
+    float noise_rms;            // A
+    float lsb;                  // A per count; 0 = not quantized
+    float full_scale;           // A; 0 = no clipping
+    int delay_ticks;            // 0..sim_current_sensor_max_delay
+    uint32_t seed;              // 0 = a fixed default
+};
+
+struct SimCurrentSensorState {
+    PhaseCurrents history[sim_current_sensor_max_delay + 1];  // true currents
+    uint32_t n;
+    uint32_t rng;
+};
+
+// Records this tick's true currents and returns the reading the ADC
+// delivers for it.
+PhaseCurrents sim_current_sensor_sample(
+    SimCurrentSensorState& state,
+    const SimCurrentSensorConfig& cfg,
+    const PhaseCurrents& i_true) noexcept;
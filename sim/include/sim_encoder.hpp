@@ -0,0 +1,18 @@
+#pragma once
+
+#include "encoder.hpp"
+
+// Physical encoder on the simulated shaft. decoder is the core-side
+// configuration of the same device (type and line count are read from it).
+struct SimEncoderConfig {
+    EncoderConfig decoder;
+    float amplitude;    // analog channels, SinCos only; 0 = 1
+    float sin_offset;
+    float cos_offset;
+};
+
+// Counter and analog readings for a mechanical position. Timestamps are
+// left to the caller.
+EncoderInput sim_encoder_sample(
+    const SimEncoderConfig& cfg,
+    Position64 theta_mech) noexcept;
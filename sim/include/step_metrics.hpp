@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+// Online step-response metrics: fed one sample per tick, no history kept.
+struct StepMetricsConfig {
+    float initial;
+    float target;
+    float rise_lo;
+    float rise_hi;
+    float settle_band;
+    float ss_window_start;
+};
+
+struct StepMetricsState {
+    bool rise_lo_seen;
+    bool rise_hi_seen;
+    float t_rise_lo;
+    float t_rise_hi;
+    float peak_excess;
+    float t_last_outside;
+    float t;
+    float y_last;
+    double err_sum;
+    double ripple_sum;
+    double ripple_sum2;
+    uint64_t n_ss;
+};
+
+struct StepMetrics {
+    float rise_time;
+    float overshoot;
+    float settling_time;
+    float ss_error;
+    float ripple_rms;
+};
+
+// y is the tracked output; r is any signal whose AC content in the
+// steady-state window is reported as ripple (e.g. measured iq).
+void step_metrics_update(
+    StepMetricsState& state,
+    const StepMetricsConfig& cfg,
+    float t,
+    float y,
+    float r) noexcept;
+
+// Metrics that never happened (no rise, never settled) report the time of
+// the last sample, so they always compare as worse than any real value.
+StepMetrics step_metrics_finish(
+    const StepMetricsState& state,
+    const StepMetricsConfig& cfg) noexcept;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "pmsm.hpp"
+#include "inverter.hpp"
+
+struct SwitchedInverterInput {
+    float m_a;
+    float m_b;
+    float m_c;
+    float v_bus;
+    float T_L;
+    bool gates_off;     // no edges; the diodes set the poles, see inverter_step
+};
+
+struct SwitchedInverterOutput {
+    PmsmOutput motor;
+    float i_min[3];
+    float i_max[3];
+    int segments;
+};
+
+SwitchedInverterOutput switched_inverter_step(
+    PmsmState& state,
+    const PmsmParams& motor_params,
+    const LoadParams& load,
+    const InverterParams& inv_params,
+    const SwitchedInverterInput& in,
+    float period) noexcept;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "pmsm.hpp"
+
+// Two-node lumped network: the copper is heated by its I^2*R loss and
+// leaks to ambient and into the rotor magnets, which leak to ambient in
+// turn. Rs follows the copper temperature and psi_m the magnet
+// temperature, linearly about t_ref, where PmsmParams holds. Temperatures
+// are degC.
+struct ThermalParams {
+    float t_ambient;
+    float t_ref;
+    float alpha_cu;     // 1/K, copper resistance (about +0.0039)
+    float alpha_mag;    // 1/K, magnet remanence (NdFeB about -0.0012)
+    float C_cu;         // J/K
+    float C_mag;        // J/K
+    float R_cu_amb;     // K/W
+    float R_cu_mag;     // K/W
+    float R_mag_amb;    // K/W
+};
+
+// Rises above ambient, so a zeroed state starts at ambient.
+struct ThermalState {
+    float rise_cu;
+    float rise_mag;
+};
+
+// params with Rs and psi_m moved to the state's temperatures.
+PmsmParams thermal_motor_params(
+    const PmsmParams& params,
+    const ThermalParams& thermal,
+    const ThermalState& state) noexcept;
+
+// Copper loss of the phase currents at resistance Rs.
+float thermal_copper_loss(const PmsmState& motor, float Rs) noexcept;
+
+// Explicit Euler; the network's time constants are seconds to minutes,
+// far above any control tick.
+void thermal_step(
+    ThermalState& state,
+    const ThermalParams& thermal,
+    float p_cu,
+    float dt) noexcept;
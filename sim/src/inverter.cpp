@@ -0,0 +1,150 @@
+#include "inverter.hpp"
+#include <cmath>
+
+// Below i_dead_band the device output capacitance is not fully swung within
+// the dead time, so the error fades linearly towards zero current.
+static float current_sign(float i, float band) noexcept {
+    if (band > 0.0f) {
+        float s = i / band;
+        return s < -1.0f ? -1.0f : (s > 1.0f ? 1.0f : s);
+    }
+    return i > 0.0f ? 1.0f : (i < 0.0f ? -1.0f : 0.0f);
+}
+
+// Averaged pole voltage of one leg relative to the bus midpoint. The timer
+// quantizes the duty; during the dead time both devices are off and the
+// freewheeling diode picked by the current sign sets the pole, which costs
+// one t_dead per period against the current. A leg clamped to a rail never
+// switches and sees no dead time.
+static float leg_voltage(
+    const InverterParams& params,
+    float m,
+    float i,
+    float v_bus) noexcept
+{
+    float d = 0.5f * (m + 1.0f);
+    d = d < 0.0f ? 0.0f : (d > 1.0f ? 1.0f : d);
+
+    if (params.pwm_counts > 0) {
+        float counts = static_cast<float>(params.pwm_counts);
+        d = std::nearbyint(d * counts) / counts;
+    }
+
+    float s = current_sign(i, params.i_dead_band);
+    if (d > 0.0f && d < 1.0f) {
+        d -= s * params.t_dead * params.f_pwm;
+        d = d < 0.0f ? 0.0f : (d > 1.0f ? 1.0f : d);
+    }
+
+    float v = (d - 0.5f) * v_bus;
+    v -= s * params.v_sw + i * params.r_on;
+    return v;
+}
+
+static InverterOutput off_step(
+    const InverterParams& params,
+    const InverterInput& in) noexcept
+{
+    InverterOutput out{};
+    float i[3] = {in.ia, in.ib, in.ic};
+    float e[3] = {in.ea, in.eb, in.ec};
+    float rail = 0.5f * (in.v_bus > 0.0f ? in.v_bus : 0.0f) + params.v_sw;
+
+    float pole[3] = {0.0f, 0.0f, 0.0f};
+    bool on[3] = {false, false, false};
+    int n_on = 0;
+    for (int k = 0; k < 3; ++k) {
+        if (i[k] != 0.0f) {
+            pole[k] = (i[k] > 0.0f ? -rail : rail) - i[k] * params.r_on;
+            on[k] = true;
+            ++n_on;
+        }
+    }
+
+    // The highest-EMF phase drives current out into the top diode, the
+    // lowest draws it from the bottom one.
+    if (n_on == 0) {
+        int hi = 0;
+        int lo = 0;
+        for (int k = 1; k < 3; ++k) {
+            hi = e[k] > e[hi] ? k : hi;
+            lo = e[k] < e[lo] ? k : lo;
+        }
+        if (e[hi] - e[lo] > 2.0f * rail) {
+            pole[hi] = rail;
+            pole[lo] = -rail;
+            on[hi] = on[lo] = true;
+            n_on = 2;
+        }
+    }
+
+    // The conducting currents sum to zero, and so does the EMF over all
+    // three phases, which fixes the star point against the clamped poles.
+    float v_n = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+        v_n += on[k] ? pole[k] - e[k] : 0.0f;
+    }
+    v_n = n_on > 0 ? v_n / static_cast<float>(n_on) : 0.0f;
+
+    float v[3];
+    for (int k = 0; k < 3; ++k) {
+        v[k] = on[k] ? pole[k] - v_n : e[k];
+        out.leg_open[k] = !on[k];
+    }
+    out.va = v[0];
+    out.vb = v[1];
+    out.vc = v[2];
+    return out;
+}
+
+InverterOutput inverter_step(
+    const InverterParams& params,
+    const InverterInput& in) noexcept
+{
+    if (in.gates_off) {
+        return off_step(params, in);
+    }
+
+    InverterOutput out{};
+
+    if (in.v_bus <= 0.0f) {
+        return out;
+    }
+
+    float va = leg_voltage(params, in.m_a, in.ia, in.v_bus);
+    float vb = leg_voltage(params, in.m_b, in.ib, in.v_bus);
+    float vc = leg_voltage(params, in.m_c, in.ic, in.v_bus);
+
+    // The star point floats, so the zero-sequence the modulator injects
+    // appears across the neutral rather than the windings.
+    float v_n = (va + vb + vc) * (1.0f / 3.0f);
+
+    out.va = va - v_n;
+    out.vb = vb - v_n;
+    out.vc = vc - v_n;
+    return out;
+}
+
+void inverter_off_settle(
+    const InverterOutput& out,
+    const float i_prev[3],
+    float i[3]) noexcept
+{
+    int n_on = 0;
+    for (int k = 0; k < 3; ++k) {
+        if (out.leg_open[k] || i[k] * i_prev[k] < 0.0f) {
+            i[k] = 0.0f;
+        }
+        n_on += i[k] != 0.0f ? 1 : 0;
+    }
+
+    if (n_on < 2) {
+        i[0] = i[1] = i[2] = 0.0f;
+    } else if (n_on == 2) {
+        int a = i[0] != 0.0f ? 0 : 1;
+        int b = i[2] != 0.0f ? 2 : 1;
+        float d = 0.5f * (i[a] - i[b]);
+        i[a] = d;
+        i[b] = -d;
+    }
+}
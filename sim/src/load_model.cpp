@@ -0,0 +1,83 @@
+#include "load_model.hpp"
+#include <cmath>
+
+static float friction_torque(const LoadParams& load, float w) noexcept {
+    float T = load.B_viscous * w;
+    if (load.T_coulomb == 0.0f && load.T_stribeck == 0.0f) {
+        return T;
+    }
+
+    // A tanh through w_coulomb_band keeps the RK4 step stable around zero
+    // speed; a zero band is a hard sign.
+    float s = load.w_coulomb_band > 0.0f
+        ? std::tanh(w / load.w_coulomb_band)
+        : (w > 0.0f ? 1.0f : (w < 0.0f ? -1.0f : 0.0f));
+
+    float level = load.T_coulomb;
+    if (load.w_stribeck > 0.0f) {
+        float r = w / load.w_stribeck;
+        level += (load.T_stribeck - load.T_coulomb) * std::exp(-r * r);
+    }
+    return T + level * s;
+}
+
+static float table_torque(const LoadTable& table, float w) noexcept {
+    if (table.n <= 0 || table.w == nullptr || table.torque == nullptr) {
+        return 0.0f;
+    }
+    if (w <= table.w[0]) {
+        return table.torque[0];
+    }
+    if (w >= table.w[table.n - 1]) {
+        return table.torque[table.n - 1];
+    }
+
+    int k = 1;
+    while (w > table.w[k]) {
+        ++k;
+    }
+    float w0 = table.w[k - 1];
+    float w1 = table.w[k];
+    float f = (w - w0) / (w1 - w0);
+    return table.torque[k - 1] + f * (table.torque[k] - table.torque[k - 1]);
+}
+
+bool load_params_valid(const LoadParams& load) noexcept
+{
+    return load.cog_amp == 0.0f || std::nearbyint(load.cog_periods) == load.cog_periods;
+}
+
+// Cogging belongs to the motor and always acts on the rotor. The process
+// load (constant, friction, table, user hook) acts on the load inertia when
+// a compliant shaft is configured, and on the rotor directly otherwise.
+LoadTorques load_torques(
+    const LoadParams& load,
+    const LoadContext& ctx,
+    float shaft_twist) noexcept
+{
+    LoadTorques out{};
+
+    if (load.cog_amp != 0.0f) {
+        out.T_rotor += load.cog_amp * std::sin(load.cog_periods * ctx.theta_e + load.cog_phase);
+    }
+
+    bool shaft = load_has_shaft(load);
+    float w_process = shaft ? ctx.omega_load : ctx.omega_m;
+
+    float T_process = load.T_const
+        + friction_torque(load, w_process)
+        + table_torque(load.table, w_process);
+    if (load.fn != nullptr) {
+        T_process += load.fn(ctx, load.user);
+    }
+
+    if (shaft) {
+        float T_shaft = load.k_shaft * shaft_twist + load.c_shaft * (ctx.omega_m - ctx.omega_load);
+        out.T_rotor += T_shaft;
+        out.T_load_net = T_shaft - T_process - load.B_load * ctx.omega_load;
+    } else {
+        out.T_rotor += T_process;
+        out.T_load_net = 0.0f;
+    }
+    return out;
+}
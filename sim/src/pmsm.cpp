@@ -8,6 +8,8 @@ struct PmsmDeriv {
     float dic;
     float domega_m;
     float dtheta_e;
+    float dshaft_twist;
+    float domega_load;
 };
 
 static PmsmDeriv pmsm_rk4_combine(
@@ -23,12 +25,15 @@ static PmsmDeriv pmsm_rk4_combine(
     k.dic = (k1.dic + 2.0f * k2.dic + 2.0f * k3.dic + k4.dic) * inv6;
     k.domega_m = (k1.domega_m + 2.0f * k2.domega_m + 2.0f * k3.domega_m + k4.domega_m) * inv6;
     k.dtheta_e = (k1.dtheta_e + 2.0f * k2.dtheta_e + 2.0f * k3.dtheta_e + k4.dtheta_e) * inv6;
+    k.dshaft_twist = (k1.dshaft_twist + 2.0f * k2.dshaft_twist + 2.0f * k3.dshaft_twist + k4.dshaft_twist) * inv6;
+    k.domega_load = (k1.domega_load + 2.0f * k2.domega_load + 2.0f * k3.domega_load + k4.domega_load) * inv6;
     return k;
 }
 
 static PmsmDeriv pmsm_rhs(
     const PmsmState& x,
     const PmsmParams& params,
+    const LoadParams& load,
     const PmsmInput& input) noexcept
 {
     PmsmDeriv dx{};
@@ -53,9 +58,9 @@ static PmsmDeriv pmsm_rhs(
 
     float omega_e = p * omega_m;
 
-    dx.dia = (va - Rs * ia - psi_m * omega_e * std::sin(theta_e)) / Ls;
-    dx.dib = (vb - Rs * ib - psi_m * omega_e * std::sin(theta_e - 2.0f * pi_v / 3.0f)) / Ls;
-    dx.dic = (vc - Rs * ic - psi_m * omega_e * std::sin(theta_e + 2.0f * pi_v / 3.0f)) / Ls;
+    dx.dia = (va - Rs * ia + psi_m * omega_e * std::sin(theta_e)) / Ls;
+    dx.dib = (vb - Rs * ib + psi_m * omega_e * std::sin(theta_e - 2.0f * pi_v / 3.0f)) / Ls;
+    dx.dic = (vc - Rs * ic + psi_m * omega_e * std::sin(theta_e + 2.0f * pi_v / 3.0f)) / Ls;
 
     float ialpha = (2.0f / 3.0f) * (ia - 0.5f * ib - 0.5f * ic);
     float ibeta = (2.0f / 3.0f) * ((sqrt3_v * 0.5f) * (ib - ic));
@@ -65,9 +70,17 @@ static PmsmDeriv pmsm_rhs(
 
     float Te = 1.5f * p * (psia * ibeta - psib * ialpha);
 
-    dx.domega_m = (Te - T_L - B * omega_m) / J;
+    LoadContext ctx{omega_m, theta_e, x.omega_load};
+    LoadTorques T_ext = load_torques(load, ctx, x.shaft_twist);
+
+    dx.domega_m = (Te - T_L - T_ext.T_rotor - B * omega_m) / J;
     dx.dtheta_e = omega_e;
 
+    if (load_has_shaft(load)) {
+        dx.dshaft_twist = omega_m - x.omega_load;
+        dx.domega_load = T_ext.T_load_net / load.J_load;
+    }
+
     return dx;
 }
 
@@ -82,6 +95,8 @@ static PmsmState pmsm_add(
     r.ic = x.ic + step * k.dic;
     r.omega_m  = x.omega_m + step * k.domega_m;
     r.theta_e = x.theta_e + step * k.dtheta_e;
+    r.shaft_twist = x.shaft_twist + step * k.dshaft_twist;
+    r.omega_load = x.omega_load + step * k.domega_load;
     return r;
 }
 
@@ -99,9 +114,31 @@ static PmsmState integrate_rk4(
     return pmsm_add(x0, k, dt);
 }
 
+PmsmBackEmf pmsm_back_emf(
+    const PmsmState& state,
+    const PmsmParams& params) noexcept
+{
+    float w = params.psi_m * params.p * state.omega_m;
+    PmsmBackEmf e{};
+    e.ea = -w * std::sin(state.theta_e);
+    e.eb = -w * std::sin(state.theta_e - 2.0f * pi_v / 3.0f);
+    e.ec = -w * std::sin(state.theta_e + 2.0f * pi_v / 3.0f);
+    return e;
+}
+
+PmsmOutput pmsm_step(
+    PmsmState& state,
+    const PmsmParams& params,
+    const PmsmInput& input,
+    float dt) noexcept
+{
+    return pmsm_step(state, params, LoadParams{}, input, dt);
+}
+
 PmsmOutput pmsm_step(
     PmsmState& state,
     const PmsmParams& params,
+    const LoadParams& load,
     const PmsmInput& input,
     float dt) noexcept
 {
@@ -118,7 +155,7 @@ PmsmOutput pmsm_step(
     }
 
     auto rhs = [&](const PmsmState& x) noexcept {
-        return pmsm_rhs(x, params, input);
+        return pmsm_rhs(x, params, load, input);
     };
 
     PmsmState x = integrate_rk4(state, dt, rhs);
@@ -150,5 +187,6 @@ PmsmOutput pmsm_step(
     out.omega_m = omega_m;
     out.theta_e = theta_e;
     out.torque = Te;
+    out.T_load = load_torques(load, LoadContext{omega_m, theta_e, x.omega_load}, x.shaft_twist).T_rotor;
     return out;
 }
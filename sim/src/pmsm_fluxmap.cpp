@@ -0,0 +1,268 @@
+#include "pmsm_fluxmap.hpp"
+#include "sim_math.hpp"
+#include <cmath>
+
+// Flux-linkage state of the saturating machine. Currents are algebraic
+// outputs of the inverse flux map, so saliency, saturation and
+// cross-saturation all come from the table.
+struct FluxMapX {
+    float psi_d;
+    float psi_q;
+    float omega_m;
+    float theta_e;
+    float shaft_twist;
+    float omega_load;
+};
+
+void saturation_model_flux(
+    const SaturationModel& model,
+    float id,
+    float iq,
+    float& psi_d,
+    float& psi_q) noexcept
+{
+    // Apparent inductance falls from L to k_inf * L around i_sat and
+    // depends on the total current; q current also pulls down the magnet
+    // flux on the d axis (k_cross), which is what costs torque per amp.
+    float inv_sat2 = 1.0f / (model.i_sat * model.i_sat);
+    float s2 = (id * id + iq * iq) * inv_sat2;
+    float g = (1.0f - model.k_inf) / (1.0f + s2) + model.k_inf;
+    float psi_pm = model.psi_m / (1.0f + model.k_cross * iq * iq * inv_sat2);
+    psi_d = psi_pm + model.Ld * g * id;
+    psi_q = model.Lq * g * iq;
+}
+
+static bool invert_model(
+    const SaturationModel& model,
+    float psi_d,
+    float psi_q,
+    FluxMapNode& node) noexcept
+{
+    float id = (psi_d - model.psi_m) / model.Ld;
+    float iq = psi_q / model.Lq;
+    const float h = 1e-3f * model.i_sat;
+
+    for (int it = 0; it < 50; ++it) {
+        float fd, fq;
+        saturation_model_flux(model, id, iq, fd, fq);
+        float rd = fd - psi_d;
+        float rq = fq - psi_q;
+        if (std::fabs(rd) < 1e-7f && std::fabs(rq) < 1e-7f) {
+            node = FluxMapNode{id, iq};
+            return true;
+        }
+
+        float fd_d, fq_d, fd_q, fq_q;
+        saturation_model_flux(model, id + h, iq, fd_d, fq_d);
+        saturation_model_flux(model, id, iq + h, fd_q, fq_q);
+        float j11 = (fd_d - fd) / h;
+        float j21 = (fq_d - fq) / h;
+        float j12 = (fd_q - fd) / h;
+        float j22 = (fq_q - fq) / h;
+
+        float det = j11 * j22 - j12 * j21;
+        if (std::fabs(det) < 1e-12f) {
+            break;
+        }
+        id -= ( j22 * rd - j12 * rq) / det;
+        iq -= (-j21 * rd + j11 * rq) / det;
+    }
+
+    node = FluxMapNode{id, iq};
+    return false;
+}
+
+bool fluxmap_build(
+    PmsmFluxMap& map,
+    FluxMapNode* nodes,
+    int n_d,
+    int n_q,
+    float psi_d_min,
+    float psi_d_max,
+    float psi_q_min,
+    float psi_q_max,
+    const SaturationModel& model) noexcept
+{
+    if (nodes == nullptr || n_d < 2 || n_q < 2
+        || psi_d_max <= psi_d_min || psi_q_max <= psi_q_min
+        || model.Ld <= 0.0f || model.Lq <= 0.0f || model.i_sat <= 0.0f) {
+        return false;
+    }
+
+    float step_d = (psi_d_max - psi_d_min) / static_cast<float>(n_d - 1);
+    float step_q = (psi_q_max - psi_q_min) / static_cast<float>(n_q - 1);
+
+    bool ok = true;
+    for (int q = 0; q < n_q; ++q) {
+        for (int d = 0; d < n_d; ++d) {
+            float psi_d = psi_d_min + d * step_d;
+            float psi_q = psi_q_min + q * step_q;
+            ok &= invert_model(model, psi_d, psi_q, nodes[q * n_d + d]);
+        }
+    }
+
+    map.nodes = nodes;
+    map.n_d = n_d;
+    map.n_q = n_q;
+    map.psi_d_min = psi_d_min;
+    map.psi_q_min = psi_q_min;
+    map.inv_step_d = 1.0f / step_d;
+    map.inv_step_q = 1.0f / step_q;
+    map.psi_d0 = model.psi_m;
+    return ok;
+}
+
+// Nodes are stored row-major with psi_d fastest and id/iq interleaved, so
+// the four corners of a cell are two adjacent pairs in two rows. Lookups
+// outside the grid extrapolate linearly from the edge cell.
+FluxMapNode fluxmap_lookup(
+    const PmsmFluxMap& map,
+    float psi_d,
+    float psi_q) noexcept
+{
+    float u = (psi_d - map.psi_d_min) * map.inv_step_d;
+    float v = (psi_q - map.psi_q_min) * map.inv_step_q;
+
+    int d = static_cast<int>(u);
+    int q = static_cast<int>(v);
+    if (u < 0.0f) d = 0;
+    if (v < 0.0f) q = 0;
+    if (d > map.n_d - 2) d = map.n_d - 2;
+    if (q > map.n_q - 2) q = map.n_q - 2;
+
+    float fu = u - static_cast<float>(d);
+    float fv = v - static_cast<float>(q);
+
+    const FluxMapNode* r0 = map.nodes + q * map.n_d + d;
+    const FluxMapNode* r1 = r0 + map.n_d;
+
+    float id0 = r0[0].id + fu * (r0[1].id - r0[0].id);
+    float iq0 = r0[0].iq + fu * (r0[1].iq - r0[0].iq);
+    float id1 = r1[0].id + fu * (r1[1].id - r1[0].id);
+    float iq1 = r1[0].iq + fu * (r1[1].iq - r1[0].iq);
+
+    return FluxMapNode{id0 + fv * (id1 - id0), iq0 + fv * (iq1 - iq0)};
+}
+
+static FluxMapX fluxmap_rhs(
+    const FluxMapX& x,
+    const PmsmParams& params,
+    const PmsmFluxMap& map,
+    const LoadParams& load,
+    float vd,
+    float vq,
+    float T_L) noexcept
+{
+    FluxMapX dx{};
+
+    FluxMapNode i = fluxmap_lookup(map, x.psi_d, x.psi_q);
+    float omega_e = params.p * x.omega_m;
+
+    dx.psi_d = vd - params.Rs * i.id + omega_e * x.psi_q;
+    dx.psi_q = vq - params.Rs * i.iq - omega_e * x.psi_d;
+
+    float Te = 1.5f * params.p * (x.psi_d * i.iq - x.psi_q * i.id);
+
+    LoadContext ctx{x.omega_m, x.theta_e, x.omega_load};
+    LoadTorques T_ext = load_torques(load, ctx, x.shaft_twist);
+
+    dx.omega_m = (Te - T_L - T_ext.T_rotor - params.B * x.omega_m) / params.J;
+    dx.theta_e = omega_e;
+
+    if (load_has_shaft(load)) {
+        dx.shaft_twist = x.omega_m - x.omega_load;
+        dx.omega_load = T_ext.T_load_net / load.J_load;
+    }
+    return dx;
+}
+
+static FluxMapX fluxmap_add(const FluxMapX& x, const FluxMapX& k, float step) noexcept {
+    FluxMapX r{};
+    r.psi_d = x.psi_d + step * k.psi_d;
+    r.psi_q = x.psi_q + step * k.psi_q;
+    r.omega_m = x.omega_m + step * k.omega_m;
+    r.theta_e = x.theta_e + step * k.theta_e;
+    r.shaft_twist = x.shaft_twist + step * k.shaft_twist;
+    r.omega_load = x.omega_load + step * k.omega_load;
+    return r;
+}
+
+PmsmOutput pmsm_fluxmap_step(
+    PmsmState& state,
+    PmsmFluxState& flux,
+    const PmsmParams& params,
+    const PmsmFluxMap& map,
+    const LoadParams& load,
+    const PmsmInput& input,
+    float dt) noexcept
+{
+    PmsmOutput out{};
+
+    // A fresh flux state starts from zero current.
+    if (!flux.initialized) {
+        flux.psi_d = map.psi_d0;
+        flux.psi_q = 0.0f;
+        flux.initialized = true;
+    }
+
+    FluxMapX x{flux.psi_d, flux.psi_q, state.omega_m, state.theta_e,
+               state.shaft_twist, state.omega_load};
+
+    if (dt > 0.0f) {
+        // The inverter holds the stator-frame voltage over the step, so it is
+        // rotated into dq at each stage angle.
+        float v_alpha = (2.0f / 3.0f) * (input.va - 0.5f * input.vb - 0.5f * input.vc);
+        float v_beta = (input.vb - input.vc) * inv_sqrt3_v;
+
+        auto rhs = [&](const FluxMapX& xs) noexcept {
+            float s = std::sin(xs.theta_e);
+            float c = std::cos(xs.theta_e);
+            float vd =  c * v_alpha + s * v_beta;
+            float vq = -s * v_alpha + c * v_beta;
+            return fluxmap_rhs(xs, params, map, load, vd, vq, input.T_L);
+        };
+
+        FluxMapX k1 = rhs(x);
+        FluxMapX k2 = rhs(fluxmap_add(x, k1, 0.5f * dt));
+        FluxMapX k3 = rhs(fluxmap_add(x, k2, 0.5f * dt));
+        FluxMapX k4 = rhs(fluxmap_add(x, k3, dt));
+
+        constexpr float inv6 = 1.0f / 6.0f;
+        FluxMapX k{};
+        k.psi_d = (k1.psi_d + 2.0f * k2.psi_d + 2.0f * k3.psi_d + k4.psi_d) * inv6;
+        k.psi_q = (k1.psi_q + 2.0f * k2.psi_q + 2.0f * k3.psi_q + k4.psi_q) * inv6;
+        k.omega_m = (k1.omega_m + 2.0f * k2.omega_m + 2.0f * k3.omega_m + k4.omega_m) * inv6;
+        k.theta_e = (k1.theta_e + 2.0f * k2.theta_e + 2.0f * k3.theta_e + k4.theta_e) * inv6;
+        k.shaft_twist = (k1.shaft_twist + 2.0f * k2.shaft_twist + 2.0f * k3.shaft_twist + k4.shaft_twist) * inv6;
+        k.omega_load = (k1.omega_load + 2.0f * k2.omega_load + 2.0f * k3.omega_load + k4.omega_load) * inv6;
+
+        x = fluxmap_add(x, k, dt);
+        x.theta_e = wrap_2pi(x.theta_e);
+    }
+
+    FluxMapNode i = fluxmap_lookup(map, x.psi_d, x.psi_q);
+    float s = std::sin(x.theta_e);
+    float c = std::cos(x.theta_e);
+    float i_alpha = c * i.id - s * i.iq;
+    float i_beta = s * i.id + c * i.iq;
+
+    flux.psi_d = x.psi_d;
+    flux.psi_q = x.psi_q;
+    state.ia = i_alpha;
+    state.ib = (-i_alpha + sqrt3_v * i_beta) * 0.5f;
+    state.ic = (-i_alpha - sqrt3_v * i_beta) * 0.5f;
+    state.omega_m = x.omega_m;
+    state.theta_e = x.theta_e;
+    state.shaft_twist = x.shaft_twist;
+    state.omega_load = x.omega_load;
+
+    out.ia = state.ia;
+    out.ib = state.ib;
+    out.ic = state.ic;
+    out.omega_m = x.omega_m;
+    out.theta_e = x.theta_e;
+    out.torque = 1.5f * params.p * (x.psi_d * i.iq - x.psi_q * i.id);
+    out.T_load = load_torques(load, LoadContext{x.omega_m, x.theta_e, x.omega_load},
+                              x.shaft_twist).T_rotor;
+    return out;
+}
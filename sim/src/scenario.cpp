@@ -0,0 +1,221 @@
+#include "scenario.hpp"
+
+#include <cmath>
+
+namespace {
+
+uint64_t seconds_to_ticks(const ScenarioContext& ctx, float seconds) noexcept
+{
+    if (seconds <= 0.0f || ctx.dt <= 0.0f) {
+        return 0;
+    }
+    // Round when float error puts us a hair above a whole tick count.
+    double n = static_cast<double>(seconds) / ctx.dt;
+    double r = std::round(n);
+    return static_cast<uint64_t>(std::fabs(n - r) < 1e-3 ? r : std::ceil(n));
+}
+
+ScenarioAwaiter begin_wait(ScenarioContext& ctx, ScenarioWaitKind kind, float timeout_s) noexcept
+{
+    ctx.wait = ScenarioWait{};
+    ctx.wait.kind = kind;
+    ctx.wait.start = ctx.tick;
+    ctx.wait.deadline = ctx.tick + seconds_to_ticks(ctx, timeout_s);
+    ctx.wait.result = true;
+    return ScenarioAwaiter{ctx};
+}
+
+// Called after each plant step; true once the scenario should resume.
+bool wait_satisfied(ScenarioContext& ctx) noexcept
+{
+    ScenarioWait& w = ctx.wait;
+    const bool timed_out = ctx.tick >= w.deadline;
+
+    switch (w.kind) {
+    case ScenarioWaitKind::None:
+        return true;
+
+    case ScenarioWaitKind::Ticks:
+        return timed_out;
+
+    case ScenarioWaitKind::Ramp:
+        if (timed_out) {
+            ctx.w_target = w.w_to;
+            return true;
+        } else {
+            float f = static_cast<float>(ctx.tick - w.start) / static_cast<float>(w.deadline - w.start);
+            ctx.w_target = w.w_from + (w.w_to - w.w_from) * f;
+            return false;
+        }
+
+    case ScenarioWaitKind::Settled: {
+        bool in_band = std::fabs(position64_to_rad(ctx.st.theta_mech) - ctx.theta_target) < w.pos_tol &&
+                       std::fabs(ctx.st.motor_state.omega_m) < w.w_tol;
+        w.held = in_band ? w.held + 1 : 0;
+        if (w.held >= w.hold_ticks) {
+            return true;
+        }
+        w.result = !timed_out;
+        return timed_out;
+    }
+
+    case ScenarioWaitKind::Until:
+        if (w.pred(ctx, w.pred_user)) {
+            return true;
+        }
+        w.result = !timed_out;
+        return timed_out;
+    }
+    return true;
+}
+
+} // namespace
+
+void move_to(ScenarioContext& ctx, float theta) noexcept
+{
+    ctx.mode = AxisMode::Position;
+    ctx.theta_target = theta;
+}
+
+void set_speed(ScenarioContext& ctx, float w) noexcept
+{
+    ctx.mode = AxisMode::Velocity;
+    ctx.w_target = w;
+}
+
+void set_current(ScenarioContext& ctx, float iq) noexcept
+{
+    ctx.mode = AxisMode::CurrentIq;
+    ctx.iq_target = iq;
+}
+
+void apply_load_step(ScenarioContext& ctx, float torque) noexcept
+{
+    ctx.cfg.load.T_const = torque;
+}
+
+ScenarioAwaiter wait_for(ScenarioContext& ctx, float seconds) noexcept
+{
+    ScenarioAwaiter a = begin_wait(ctx, ScenarioWaitKind::Ticks, seconds);
+    if (ctx.wait.deadline == ctx.tick) {
+        ctx.wait.kind = ScenarioWaitKind::None;
+    }
+    return a;
+}
+
+ScenarioAwaiter settle(
+    ScenarioContext& ctx,
+    float pos_tol,
+    float w_tol,
+    float hold_s,
+    float timeout_s) noexcept
+{
+    ScenarioAwaiter a = begin_wait(ctx, ScenarioWaitKind::Settled, timeout_s);
+    ctx.wait.pos_tol = pos_tol;
+    ctx.wait.w_tol = w_tol;
+    // Even with no hold the band has to be met on one tick.
+    const uint64_t hold = seconds_to_ticks(ctx, hold_s);
+    ctx.wait.hold_ticks = hold > 0 ? hold : 1;
+    return a;
+}
+
+ScenarioAwaiter ramp_speed(ScenarioContext& ctx, float w_end, float seconds) noexcept
+{
+    float w_start = ctx.mode == AxisMode::Velocity ? ctx.w_target : ctx.st.motor_state.omega_m;
+    ctx.mode = AxisMode::Velocity;
+    ScenarioAwaiter a = begin_wait(ctx, ScenarioWaitKind::Ramp, seconds);
+    ctx.wait.w_from = w_start;
+    ctx.wait.w_to = w_end;
+    if (ctx.wait.deadline == ctx.tick) {
+        ctx.w_target = w_end;
+        ctx.wait.kind = ScenarioWaitKind::None;
+    }
+    return a;
+}
+
+ScenarioAwaiter wait_until(
+    ScenarioContext& ctx,
+    ScenarioPredicate pred,
+    void* user,
+    float timeout_s) noexcept
+{
+    ScenarioAwaiter a = begin_wait(ctx, ScenarioWaitKind::Until, timeout_s);
+    ctx.wait.pred = pred;
+    ctx.wait.pred_user = user;
+    return a;
+}
+
+ScenarioContext& scenario_context(
+    ScenarioRunner& runner,
+    const SimAxisConfig& cfg,
+    float dt)
+{
+    auto ctx = std::make_unique<ScenarioContext>();
+    ctx->cfg = cfg;
+    ctx->dt = dt;
+    ctx->mode = AxisMode::Idle;
+    ScenarioContext& ref = *ctx;
+    runner.slots.push_back(ScenarioSlot{std::move(ctx), Scenario{std::coroutine_handle<Scenario::promise_type>{}}});
+    return ref;
+}
+
+int scenario_start(ScenarioRunner& runner, ScenarioContext& ctx, Scenario task)
+{
+    for (size_t i = 0; i < runner.slots.size(); ++i) {
+        ScenarioSlot& slot = runner.slots[i];
+        if (slot.ctx.get() == &ctx && !slot.task.handle) {
+            std::swap(slot.task.handle, task.handle);
+            slot.task.handle.resume();
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int scenario_run(ScenarioRunner& runner, uint64_t max_ticks)
+{
+    int live = 0;
+    for (uint64_t k = 0; k < max_ticks; ++k) {
+        live = 0;
+        for (ScenarioSlot& slot : runner.slots) {
+            if (!slot.task.handle || slot.task.handle.done()) {
+                continue;
+            }
+            ++live;
+            ScenarioContext& ctx = *slot.ctx;
+            ctx.out = sim_axis_step(ctx.st, ctx.cfg, ctx.dt, ctx.mode,
+                                    ctx.theta_target, ctx.w_target, ctx.iq_target);
+            ++ctx.tick;
+            if (wait_satisfied(ctx)) {
+                ctx.wait.kind = ScenarioWaitKind::None;
+                slot.task.handle.resume();
+            }
+        }
+        if (live == 0) {
+            break;
+        }
+    }
+
+    live = 0;
+    for (const ScenarioSlot& slot : runner.slots) {
+        if (slot.task.handle && !slot.task.handle.done()) {
+            ++live;
+        }
+    }
+    return live;
+}
+
+ScenarioResult scenario_result(const ScenarioRunner& runner, int id) noexcept
+{
+    ScenarioResult r{};
+    if (id < 0 || static_cast<size_t>(id) >= runner.slots.size()) {
+        return r;
+    }
+    const ScenarioSlot& slot = runner.slots[id];
+    r.ticks = slot.ctx->tick;
+    if (slot.task.handle && slot.task.handle.done()) {
+        r.done = true;
+        r.passed = slot.task.handle.promise().passed;
+    }
+    return r;
+}
@@ -1,7 +1,54 @@
 #include "sim_axis_runner.hpp"
 #include "foc_math.hpp"
 
-void sim_axis_step(
+// theta_e wraps once per electrical revolution, so theta_e / p alone
+// aliases for p > 1. The electrical increments are summed in whole counts,
+// so the mechanical angle derived from them never drifts.
+static void advance_theta_mech(SimAxisState& st, float theta_e_prev, float p) noexcept
+{
+    st.theta_e_acc += angle32_delta(angle32_from_rad(st.motor_state.theta_e),
+                                    angle32_from_rad(theta_e_prev));
+    int64_t poles = p >= 1.0f ? static_cast<int64_t>(p + 0.5f) : 1;
+    st.theta_mech = st.theta_e_acc / poles;
+}
+
+static void heat_motor(SimAxisState& st, const SimAxisConfig& cfg, float Rs, float dt) noexcept
+{
+    if (cfg.thermal != nullptr) {
+        thermal_step(st.thermal, *cfg.thermal, thermal_copper_loss(st.motor_state, Rs), dt);
+    }
+}
+
+bool sim_axis_prepare(SimAxisState& st, const SimAxisConfig& cfg, float dt) noexcept
+{
+    // The switched inverter integrates the linear model segment by segment
+    // and has no flux-map plant, so it would silently drop the map.
+    st.plan_ok = compile_axis_config(st.plan, cfg.axis_cfg, dt)
+              && load_params_valid(cfg.load)
+              && !(cfg.switched_pwm && cfg.flux_map != nullptr);
+    st.plan_dt = dt;
+    return st.plan_ok;
+}
+
+// The flux-map model integrates flux, not current, so a winding the
+// diodes have cut off entirely restarts from the zero-current flux.
+static void settle_floating_legs(
+    SimAxisState& st,
+    const InverterOutput& inv_out,
+    const InverterInput& inv_in) noexcept
+{
+    float i_prev[3] = {inv_in.ia, inv_in.ib, inv_in.ic};
+    float i[3] = {st.motor_state.ia, st.motor_state.ib, st.motor_state.ic};
+    inverter_off_settle(inv_out, i_prev, i);
+    st.motor_state.ia = i[0];
+    st.motor_state.ib = i[1];
+    st.motor_state.ic = i[2];
+    if (i[0] == 0.0f && i[1] == 0.0f && i[2] == 0.0f) {
+        st.flux_state.initialized = false;
+    }
+}
+
+AxisCoreOutput sim_axis_step(
     SimAxisState& st,
     const SimAxisConfig& cfg,
     float dt,
@@ -14,27 +61,97 @@ void sim_axis_step(
 
     float theta_e = st.motor_state.theta_e;
     float p = cfg.motor_params.p;
-    float theta_m = wrap_pi(theta_e / p);
+
+    PmsmParams motor = cfg.motor_params;
+    if (cfg.thermal != nullptr) {
+        motor = thermal_motor_params(cfg.motor_params, *cfg.thermal, st.thermal);
+    }
 
     AxisCoreInput in{};
     in.mode = mode;
-    in.theta_meas = theta_m;
+    in.theta_meas = st.theta_mech;
     in.i_abc = {st.motor_state.ia, st.motor_state.ib, st.motor_state.ic};
-    in.theta_target = theta_target;
+    if (cfg.current_sensor != nullptr) {
+        in.i_abc = sim_current_sensor_sample(st.current_sensor, *cfg.current_sensor, in.i_abc);
+    }
+    in.theta_target = position64_from_rad(theta_target);
     in.w_target = w_target;
     in.iq_target = iq_target;
     in.v_bus = v_bus;
     in.theta_elec = theta_e;
 
-    AxisCoreOutput out = run_axis_core(st.axis_state, cfg.axis_cfg, in, dt);
+    // The encoder is sampled at the start of the tick; the voltages it
+    // feeds are held over the whole tick, so their centre is dt / 2 later.
+    int64_t dt_ns = static_cast<int64_t>(dt * 1e9f + 0.5f);
+    if (cfg.encoder != nullptr) {
+        EncoderInput enc_in = sim_encoder_sample(*cfg.encoder, st.theta_mech);
+        enc_in.t_sample_ns = st.t_ns;
+        enc_in.t_apply_ns = st.t_ns + dt_ns / 2;
+        EncoderOutput enc_out = run_encoder(st.encoder, cfg.encoder->decoder, enc_in);
+        in.theta_meas = enc_out.theta_mech;
+        in.theta_elec = enc_out.theta_elec;
+    }
+    st.t_ns += dt_ns;
+
+    if (st.plan_dt != dt) {
+        sim_axis_prepare(st, cfg, dt);
+    }
+    AxisCoreOutput out{};
+    if (st.plan_ok) {
+        out = run_axis_plan(st.axis_state, st.guard, st.plan, in);
+    }
+
+    if (cfg.switched_pwm) {
+        SwitchedInverterInput sw_in{};
+        sw_in.m_a = out.m_a;
+        sw_in.m_b = out.m_b;
+        sw_in.m_c = out.m_c;
+        sw_in.v_bus = v_bus;
+        sw_in.T_L = 0.0f;
+        sw_in.gates_off = !out.pwm_enable;
 
-    float half_vbus = 0.5f * v_bus;
+        switched_inverter_step(
+            st.motor_state, motor, cfg.load, cfg.inverter, sw_in, dt);
+        advance_theta_mech(st, theta_e, p);
+        heat_motor(st, cfg, motor.Rs, dt);
+        return out;
+    }
+
+    InverterInput inv_in{};
+    inv_in.m_a = out.m_a;
+    inv_in.m_b = out.m_b;
+    inv_in.m_c = out.m_c;
+    inv_in.ia = st.motor_state.ia;
+    inv_in.ib = st.motor_state.ib;
+    inv_in.ic = st.motor_state.ic;
+    inv_in.v_bus = v_bus;
+    inv_in.gates_off = !out.pwm_enable;
+    if (inv_in.gates_off) {
+        PmsmBackEmf e = pmsm_back_emf(st.motor_state, motor);
+        inv_in.ea = e.ea;
+        inv_in.eb = e.eb;
+        inv_in.ec = e.ec;
+    }
+
+    InverterOutput inv_out = inverter_step(cfg.inverter, inv_in);
 
     PmsmInput motor_in{};
-    motor_in.va = -out.m_a * half_vbus;
-    motor_in.vb = -out.m_b * half_vbus;
-    motor_in.vc = -out.m_c * half_vbus;
+    motor_in.va = inv_out.va;
+    motor_in.vb = inv_out.vb;
+    motor_in.vc = inv_out.vc;
     motor_in.T_L = 0.0f;
 
-    pmsm_step(st.motor_state, cfg.motor_params, motor_in, dt);
+    if (cfg.flux_map != nullptr) {
+        pmsm_fluxmap_step(st.motor_state, st.flux_state, motor,
+                          *cfg.flux_map, cfg.load, motor_in, dt);
+    } else {
+        pmsm_step(st.motor_state, motor, cfg.load, motor_in, dt);
+    }
+    if (inv_in.gates_off) {
+        settle_floating_legs(st, inv_out, inv_in);
+    }
+    advance_theta_mech(st, theta_e, p);
+    heat_motor(st, cfg, motor.Rs, dt);
+
+    return out;
 }
\ No newline at end of file
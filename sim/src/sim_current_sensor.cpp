@@ -0,0 +1,64 @@
+#include "sim_current_sensor.hpp"
+
+#include <cmath>
+
+namespace {
+
+constexpr int history_len = sim_current_sensor_max_delay + 1;
+
+float uniform(uint32_t& rng) noexcept
+{
+    // xorshift32; the top 24 bits as a fraction in [-0.5, 0.5).
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return static_cast<float>(rng >> 8) * (1.0f / 16777216.0f) - 0.5f;
+}
+
+// Sum of four uniforms: close enough to normal for sensor noise, with the
+// tails clipped at 2 * sqrt(3) sigma.
+float gaussian(uint32_t& rng) noexcept
+{
+    constexpr float sqrt3 = 1.7320508f;
+    return (uniform(rng) + uniform(rng) + uniform(rng) + uniform(rng)) * sqrt3;
+}
+
+float adc(const SimCurrentSensorConfig& cfg, uint32_t& rng,
+          float i, float offset, float gain_err) noexcept
+{
+    float x = i * (1.0f + gain_err) + offset + cfg.noise_rms * gaussian(rng);
+    if (cfg.full_scale > 0.0f) {
+        x = std::fmax(-cfg.full_scale, std::fmin(cfg.full_scale, x));
+    }
+    if (cfg.lsb > 0.0f) {
+        x = std::nearbyint(x / cfg.lsb) * cfg.lsb;
+    }
+    return x;
+}
+
+} // namespace
+
+PhaseCurrents sim_current_sensor_sample(
+    SimCurrentSensorState& state,
+    const SimCurrentSensorConfig& cfg,
+    const PhaseCurrents& i_true) noexcept
+{
+    if (state.rng == 0) {
+        state.rng = cfg.seed != 0 ? cfg.seed : 0x9e3779b9u;
+    }
+
+    int delay = cfg.delay_ticks < 0 ? 0
+              : (cfg.delay_ticks > sim_current_sensor_max_delay ? sim_current_sensor_max_delay
+                                                                : cfg.delay_ticks);
+    // history_len divides 2^32, so the unsigned index wraps cleanly; slots
+    // not yet written read as zero current.
+    state.history[state.n % history_len] = i_true;
+    PhaseCurrents i = state.history[(state.n - static_cast<uint32_t>(delay)) % history_len];
+    ++state.n;
+
+    PhaseCurrents out;
+    out.a = adc(cfg, state.rng, i.a, cfg.offset.a, cfg.gain_err.a);
+    out.b = adc(cfg, state.rng, i.b, cfg.offset.b, cfg.gain_err.b);
+    out.c = cfg.two_shunt ? 0.0f : adc(cfg, state.rng, i.c, cfg.offset.c, cfg.gain_err.c);
+    return out;
+}
@@ -0,0 +1,29 @@
+#include "sim_encoder.hpp"
+#include "sim_math.hpp"
+
+EncoderInput sim_encoder_sample(
+    const SimEncoderConfig& cfg,
+    Position64 theta_mech) noexcept
+{
+    EncoderInput in{};
+    const uint32_t lines = cfg.decoder.lines;
+    if (lines == 0) {
+        return in;
+    }
+
+    bool sincos = cfg.decoder.type == EncoderType::SinCos;
+    uint64_t per_turn = sincos ? 4ull * lines : lines;
+    uint64_t frac = static_cast<uint32_t>(theta_mech);
+    int64_t turns = theta_mech >> 32;
+
+    int64_t edges = turns * static_cast<int64_t>(per_turn) + static_cast<int64_t>((frac * per_turn) >> 32);
+    in.count = static_cast<uint16_t>(edges);
+
+    if (sincos) {
+        float amp = cfg.amplitude > 0.0f ? cfg.amplitude : 1.0f;
+        float phase = angle32_to_rad(static_cast<Angle32>(frac * lines));
+        in.sin = amp * std::sin(phase) + cfg.sin_offset;
+        in.cos = amp * std::cos(phase) + cfg.cos_offset;
+    }
+    return in;
+}
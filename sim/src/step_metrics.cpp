@@ -0,0 +1,69 @@
+#include "step_metrics.hpp"
+
+#include <cmath>
+
+void step_metrics_update(
+    StepMetricsState& state,
+    const StepMetricsConfig& cfg,
+    float t,
+    float y,
+    float r) noexcept
+{
+    const float span = cfg.target - cfg.initial;
+    const float dir = span >= 0.0f ? 1.0f : -1.0f;
+    const float progress = span != 0.0f ? (y - cfg.initial) / span : 1.0f;
+
+    if (!state.rise_lo_seen && progress >= cfg.rise_lo) {
+        state.rise_lo_seen = true;
+        state.t_rise_lo = t;
+    }
+    if (!state.rise_hi_seen && progress >= cfg.rise_hi) {
+        state.rise_hi_seen = true;
+        state.t_rise_hi = t;
+    }
+
+    const float excess = dir * (y - cfg.target);
+    if (excess > state.peak_excess) {
+        state.peak_excess = excess;
+    }
+
+    const float band = cfg.settle_band * std::fabs(span);
+    if (std::fabs(y - cfg.target) > band) {
+        state.t_last_outside = t;
+    }
+
+    if (t >= cfg.ss_window_start) {
+        state.err_sum += std::fabs(y - cfg.target);
+        state.ripple_sum += r;
+        state.ripple_sum2 += static_cast<double>(r) * r;
+        ++state.n_ss;
+    }
+
+    state.t = t;
+    state.y_last = y;
+}
+
+StepMetrics step_metrics_finish(
+    const StepMetricsState& state,
+    const StepMetricsConfig& cfg) noexcept
+{
+    StepMetrics m{};
+    const float span = std::fabs(cfg.target - cfg.initial);
+
+    m.rise_time = state.rise_lo_seen && state.rise_hi_seen
+                      ? state.t_rise_hi - state.t_rise_lo
+                      : state.t;
+    m.overshoot = span > 0.0f ? state.peak_excess / span : 0.0f;
+    m.settling_time = state.t_last_outside;
+
+    if (state.n_ss > 0) {
+        const double n = static_cast<double>(state.n_ss);
+        const double mean = state.ripple_sum / n;
+        const double var = state.ripple_sum2 / n - mean * mean;
+        m.ss_error = static_cast<float>(state.err_sum / n);
+        m.ripple_rms = static_cast<float>(std::sqrt(var > 0.0 ? var : 0.0));
+    } else {
+        m.ss_error = std::fabs(state.y_last - cfg.target);
+    }
+    return m;
+}
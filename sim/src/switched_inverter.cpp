@@ -0,0 +1,185 @@
+#include "switched_inverter.hpp"
+#include <cmath>
+
+struct PwmEdge {
+    float t;
+    int leg;
+    bool rising;
+    bool committed;
+};
+
+static float phase_current(const PmsmState& x, int leg) noexcept {
+    return leg == 0 ? x.ia : (leg == 1 ? x.ib : x.ic);
+}
+
+static void track_ripple(SwitchedInverterOutput& out, const PmsmState& x) noexcept {
+    float i[3] = {x.ia, x.ib, x.ic};
+    for (int k = 0; k < 3; ++k) {
+        if (i[k] < out.i_min[k]) out.i_min[k] = i[k];
+        if (i[k] > out.i_max[k]) out.i_max[k] = i[k];
+    }
+}
+
+static PmsmInput phase_voltages(
+    const InverterParams& params,
+    const PmsmState& x,
+    const bool high[3],
+    float v_bus,
+    float T_L) noexcept
+{
+    float v[3];
+    for (int k = 0; k < 3; ++k) {
+        float i = phase_current(x, k);
+        float s = i > 0.0f ? 1.0f : (i < 0.0f ? -1.0f : 0.0f);
+        v[k] = (high[k] ? 0.5f : -0.5f) * v_bus - s * params.v_sw - i * params.r_on;
+    }
+
+    float v_n = (v[0] + v[1] + v[2]) * (1.0f / 3.0f);
+
+    PmsmInput u{};
+    u.va = v[0] - v_n;
+    u.vb = v[1] - v_n;
+    u.vc = v[2] - v_n;
+    u.T_L = T_L;
+    return u;
+}
+
+// Centre-aligned PWM: each leg's top device is gated on for d * period
+// around the middle of the period, so a period has at most six edges and
+// seven constant-voltage segments. The motor is integrated exactly across
+// each segment instead of oversampling the carrier. Dead time is resolved
+// per edge from the phase current at that instant: a rising edge against
+// positive current, or a falling edge against negative current, is held
+// off by t_dead while the freewheeling diode keeps the pole where it was.
+// A held edge pushed past its partner swallows the pulse.
+SwitchedInverterOutput switched_inverter_step(
+    PmsmState& state,
+    const PmsmParams& motor_params,
+    const LoadParams& load,
+    const InverterParams& inv_params,
+    const SwitchedInverterInput& in,
+    float period) noexcept
+{
+    SwitchedInverterOutput out{};
+    for (int k = 0; k < 3; ++k) {
+        out.i_min[k] = phase_current(state, k);
+        out.i_max[k] = phase_current(state, k);
+    }
+
+    // With the gates off there are no edges to resolve: the diodes hold
+    // the poles over the whole period.
+    if (in.gates_off && period > 0.0f) {
+        PmsmBackEmf e = pmsm_back_emf(state, motor_params);
+        InverterInput off{};
+        off.ia = state.ia;
+        off.ib = state.ib;
+        off.ic = state.ic;
+        off.v_bus = in.v_bus;
+        off.gates_off = true;
+        off.ea = e.ea;
+        off.eb = e.eb;
+        off.ec = e.ec;
+        InverterOutput v = inverter_step(inv_params, off);
+
+        float i_prev[3] = {state.ia, state.ib, state.ic};
+        out.motor = pmsm_step(state, motor_params, load, PmsmInput{v.va, v.vb, v.vc, in.T_L}, period);
+        float i[3] = {state.ia, state.ib, state.ic};
+        inverter_off_settle(v, i_prev, i);
+        state.ia = out.motor.ia = i[0];
+        state.ib = out.motor.ib = i[1];
+        state.ic = out.motor.ic = i[2];
+        track_ripple(out, state);
+        out.segments = 1;
+        return out;
+    }
+
+    if (period <= 0.0f || in.v_bus <= 0.0f) {
+        PmsmInput u{};
+        u.T_L = in.T_L;
+        out.motor = pmsm_step(state, motor_params, load, u, period);
+        return out;
+    }
+
+    float m[3] = {in.m_a, in.m_b, in.m_c};
+    bool high[3] = {false, false, false};
+
+    PwmEdge edges[6];
+    int n_edges = 0;
+
+    for (int k = 0; k < 3; ++k) {
+        float d = 0.5f * (m[k] + 1.0f);
+        d = d < 0.0f ? 0.0f : (d > 1.0f ? 1.0f : d);
+
+        if (inv_params.pwm_counts > 0) {
+            float counts = static_cast<float>(inv_params.pwm_counts);
+            d = std::nearbyint(d * counts) / counts;
+        }
+
+        if (d >= 1.0f) {
+            high[k] = true;
+            continue;
+        }
+        if (d <= 0.0f) {
+            continue;
+        }
+
+        float t_on = 0.5f * (1.0f - d) * period;
+        float t_off = 0.5f * (1.0f + d) * period;
+        edges[n_edges++] = PwmEdge{t_on, k, true, false};
+        edges[n_edges++] = PwmEdge{t_off, k, false, false};
+    }
+
+    float t = 0.0f;
+
+    while (true) {
+        int next = -1;
+        for (int e = 0; e < n_edges; ++e) {
+            if (edges[e].t >= 0.0f && (next < 0 || edges[e].t < edges[next].t)) {
+                next = e;
+            }
+        }
+
+        float t_next = next >= 0 ? edges[next].t : period;
+        if (t_next > period) {
+            t_next = period;
+        }
+
+        if (t_next > t) {
+            PmsmInput u = phase_voltages(inv_params, state, high, in.v_bus, in.T_L);
+            out.motor = pmsm_step(state, motor_params, load, u, t_next - t);
+            track_ripple(out, state);
+            ++out.segments;
+            t = t_next;
+        }
+
+        if (next < 0 || t >= period) {
+            break;
+        }
+
+        PwmEdge& edge = edges[next];
+        float i = phase_current(state, edge.leg);
+        bool held = edge.rising ? (i > 0.0f) : (i < 0.0f);
+
+        if (!edge.committed && held && inv_params.t_dead > 0.0f) {
+            edge.t += inv_params.t_dead;
+            edge.committed = true;
+            // A pulse shorter than the dead time never reaches the pole: if
+            // the held edge lands on or past its leg's other pending edge,
+            // both are swallowed.
+            for (int e = 0; e < n_edges; ++e) {
+                if (e != next && edges[e].leg == edge.leg && edges[e].t >= 0.0f
+                    && edges[e].t <= edge.t) {
+                    edges[e].t = -1.0f;
+                    edge.t = -1.0f;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        high[edge.leg] = edge.rising;
+        edge.t = -1.0f;
+    }
+
+    return out;
+}
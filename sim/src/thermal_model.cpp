@@ -0,0 +1,41 @@
+#include "thermal_model.hpp"
+
+PmsmParams thermal_motor_params(
+    const PmsmParams& params,
+    const ThermalParams& thermal,
+    const ThermalState& state) noexcept
+{
+    float t_cu = thermal.t_ambient + state.rise_cu;
+    float t_mag = thermal.t_ambient + state.rise_mag;
+
+    PmsmParams hot = params;
+    hot.Rs = params.Rs * (1.0f + thermal.alpha_cu * (t_cu - thermal.t_ref));
+    hot.psi_m = params.psi_m * (1.0f + thermal.alpha_mag * (t_mag - thermal.t_ref));
+    return hot;
+}
+
+float thermal_copper_loss(const PmsmState& motor, float Rs) noexcept
+{
+    return Rs * (motor.ia * motor.ia + motor.ib * motor.ib + motor.ic * motor.ic);
+}
+
+void thermal_step(
+    ThermalState& state,
+    const ThermalParams& thermal,
+    float p_cu,
+    float dt) noexcept
+{
+    // Missing resistances are open circuits, missing capacities freeze
+    // their node.
+    float q_cu_amb = thermal.R_cu_amb > 0.0f ? state.rise_cu / thermal.R_cu_amb : 0.0f;
+    float q_cu_mag = thermal.R_cu_mag > 0.0f
+        ? (state.rise_cu - state.rise_mag) / thermal.R_cu_mag : 0.0f;
+    float q_mag_amb = thermal.R_mag_amb > 0.0f ? state.rise_mag / thermal.R_mag_amb : 0.0f;
+
+    if (thermal.C_cu > 0.0f) {
+        state.rise_cu += (p_cu - q_cu_amb - q_cu_mag) * dt / thermal.C_cu;
+    }
+    if (thermal.C_mag > 0.0f) {
+        state.rise_mag += (q_cu_mag - q_mag_amb) * dt / thermal.C_mag;
+    }
+}
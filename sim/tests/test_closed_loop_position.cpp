@@ -30,10 +30,10 @@ TEST(ClosedLoop, PositionStepMovesTowardTarget) {
     SimAxisState st{};
     st.motor_state = PmsmState{0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
 
-    st.axis_state.pos.pos_pi = PI{2.0f, 0.0f, 0.0f, -200.0f, 200.0f};
-    st.axis_state.spd.iq_pi = PI{1.0f, 0.0f, 0.0f, -200.0f, 200.0f};
-    st.axis_state.foc.loop.id = PI{1.0f, 0.0f, 0.0f, -200.0f, 200.0f};
-    st.axis_state.foc.loop.iq = PI{1.0f, 0.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.spd.iq_pi = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
 
     float dt = 0.0005f;
     float theta_target = 1.0f;
@@ -48,4 +48,70 @@ TEST(ClosedLoop, PositionStepMovesTowardTarget) {
     float err_final = theta_target - theta_m;
 
     EXPECT_LT(std::fabs(err_final), std::fabs(err0));
-}
\ No newline at end of file
+}
+TEST(ClosedLoop, DecimatedOuterLoopsStillReachTarget) {
+    SimAxisConfig cfg = make_sim_axis_cfg();
+    cfg.axis_cfg.rate = MultirateConfig{5, 10, 3};
+
+    SimAxisState st{};
+    cfg.axis_cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.spd.iq_pi = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+
+    float dt = 0.0005f;
+    float theta_target = 1.0f;
+
+    for (int k = 0; k < 20000; ++k) {
+        sim_axis_step(st, cfg, dt, AxisMode::Position,
+                      theta_target, 0.0f, 0.0f);
+    }
+
+    EXPECT_LT(std::fabs(theta_target - position64_to_rad(st.theta_mech)), 0.1f);
+}
+
+TEST(ClosedLoop, MultiTurnMoveDoesNotTakeShortcut) {
+    SimAxisConfig cfg = make_sim_axis_cfg();
+    cfg.axis_cfg.traj = TrajConfig{20.0f, 40.0f};
+
+    SimAxisState st{};
+    cfg.axis_cfg.pos.pos_pi = PIConfig{2.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.spd.iq_pi = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+
+    // Five turns and a bit: a single-turn error would wrap this to 0.5 rad.
+    float dt = 0.0005f;
+    float theta_target = 5.0f * two_pi_v + 0.5f;
+
+    for (int k = 0; k < 20000; ++k) {
+        sim_axis_step(st, cfg, dt, AxisMode::Position,
+                      theta_target, 0.0f, 0.0f);
+    }
+
+    EXPECT_LT(std::fabs(theta_target - position64_to_rad(st.theta_mech)), 0.1f);
+}
+
+TEST(ClosedLoop, PlanIsCompiledOnceAndInvalidConfigIsNotRun) {
+    SimAxisConfig cfg = make_sim_axis_cfg();
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 0.0f, -200.0f, 200.0f};
+    SimAxisState st{};
+    const float dt = 0.0005f;
+
+    AxisCoreOutput out = sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 2.0f);
+    EXPECT_TRUE(st.plan_ok);
+    EXPECT_FLOAT_EQ(st.plan_dt, dt);
+    EXPECT_NE(out.m_b, 0.0f);
+
+    // The step keeps running the compiled plan until it is prepared again.
+    cfg.axis_cfg.lim = LimitsConfig{1.0f, -1.0f, -50.0f, 50.0f};
+    out = sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 2.0f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, 2.0f);
+
+    EXPECT_FALSE(sim_axis_prepare(st, cfg, dt));
+    out = sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 2.0f);
+    EXPECT_FLOAT_EQ(out.iq_cmd, 0.0f);
+    EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+    EXPECT_FLOAT_EQ(out.m_b, 0.0f);
+    EXPECT_FLOAT_EQ(out.m_c, 0.0f);
+}
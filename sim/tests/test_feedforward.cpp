@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include "sim_axis_runner.hpp"
+
+// Peak |pos_ref - theta_mech| over a trapezoidal move; gain_scale shrinks
+// the position and speed feedback gains together.
+static float run_move_following_error(bool feedforward, float gain_scale) {
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.traj = TrajConfig{5.0f, 50.0f};
+    cfg.axis_cfg.pos = PositionLoopConfig{-100.0f, 100.0f, PIConfig{20.0f * gain_scale, 0.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.spd = SpeedLoopConfig{-20.0f, 20.0f,
+                                       PIConfig{0.05f * gain_scale, 2.0f * gain_scale, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                         PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+    cfg.v_bus = 24.0f;
+
+    if (feedforward) {
+        const float kt = 1.5f * cfg.motor_params.p * cfg.motor_params.psi_m;
+        cfg.axis_cfg.pos.kff_vel = 1.0f;
+        cfg.axis_cfg.spd.kff_acc = cfg.motor_params.J / kt;
+    }
+
+    SimAxisState st{};
+    const float dt = 5e-5f;
+    float max_err = 0.0f;
+    for (int k = 0; k < 20000; ++k) {
+        sim_axis_step(st, cfg, dt, AxisMode::Position, 3.0f, 0.0f, 0.0f);
+        float err = std::fabs(position64_delta_rad(st.axis_state.traj.pos, st.theta_mech));
+        if (err > max_err) max_err = err;
+    }
+    return max_err;
+}
+
+TEST(Feedforward, CutsFollowingErrorDuringMove) {
+    float fb_only = run_move_following_error(false, 1.0f);
+    float with_ff = run_move_following_error(true, 1.0f);
+    float ff_low_gain = run_move_following_error(true, 0.5f);
+
+    RecordProperty("fb_only_max_err_rad", std::to_string(fb_only));
+    RecordProperty("ff_max_err_rad", std::to_string(with_ff));
+    RecordProperty("ff_half_gain_max_err_rad", std::to_string(ff_low_gain));
+
+    EXPECT_LT(with_ff, 0.25f * fb_only);
+    EXPECT_LT(ff_low_gain, fb_only);
+}
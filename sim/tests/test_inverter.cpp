@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "inverter.hpp"
+#include "sim_axis_runner.hpp"
+#include "foc_math.hpp"
+
+static InverterInput make_input(float m_a, float m_b, float m_c, float i_a, float i_b) {
+    InverterInput in{};
+    in.m_a = m_a;
+    in.m_b = m_b;
+    in.m_c = m_c;
+    in.ia = i_a;
+    in.ib = i_b;
+    in.ic = -i_a - i_b;
+    in.v_bus = 24.0f;
+    return in;
+}
+
+TEST(Inverter, IdealParamsGiveAveragedPhaseVoltages) {
+    InverterParams params{};
+    InverterOutput out = inverter_step(params, make_input(0.5f, -0.25f, 0.1f, 1.0f, 2.0f));
+
+    float va = 0.5f * 12.0f;
+    float vb = -0.25f * 12.0f;
+    float vc = 0.1f * 12.0f;
+    float vn = (va + vb + vc) / 3.0f;
+    EXPECT_NEAR(out.va, va - vn, 1e-5f);
+    EXPECT_NEAR(out.vb, vb - vn, 1e-5f);
+    EXPECT_NEAR(out.vc, vc - vn, 1e-5f);
+    EXPECT_NEAR(out.va + out.vb + out.vc, 0.0f, 1e-5f);
+}
+
+TEST(Inverter, DeadtimeOpposesPhaseCurrent) {
+    InverterParams params{};
+    params.t_dead = 1e-6f;
+    params.f_pwm = 20000.0f;
+
+    InverterParams ideal{};
+    InverterInput in = make_input(0.2f, -0.1f, -0.1f, 5.0f, -2.5f);
+    InverterOutput out = inverter_step(params, in);
+    InverterOutput ref = inverter_step(ideal, in);
+
+    // A 2% duty loss on leg a against +5 A and a 2% gain on legs b and c,
+    // seen through the floating neutral.
+    float dv = 1e-6f * 20000.0f * 24.0f;
+    EXPECT_NEAR(out.va - ref.va, -dv * 4.0f / 3.0f, 1e-4f);
+    EXPECT_NEAR(out.vb - ref.vb,  dv * 2.0f / 3.0f, 1e-4f);
+    EXPECT_NEAR(out.vc - ref.vc,  dv * 2.0f / 3.0f, 1e-4f);
+}
+
+TEST(Inverter, DeadtimeErrorFadesInsideCurrentBand) {
+    InverterParams params{};
+    params.t_dead = 1e-6f;
+    params.f_pwm = 20000.0f;
+    params.i_dead_band = 1.0f;
+
+    InverterParams ideal{};
+    InverterInput in = make_input(0.2f, -0.1f, -0.1f, 0.5f, -0.25f);
+    InverterOutput out = inverter_step(params, in);
+    InverterOutput ref = inverter_step(ideal, in);
+
+    float dv = 1e-6f * 20000.0f * 24.0f;
+    EXPECT_NEAR(out.va - ref.va, -0.5f * dv, 1e-4f);
+}
+
+TEST(Inverter, ClampedLegSeesOnlyDeviceDrop) {
+    InverterParams params{};
+    params.t_dead = 1e-6f;
+    params.f_pwm = 20000.0f;
+    params.v_sw = 0.7f;
+
+    InverterParams ideal{};
+    InverterInput in = make_input(1.0f, 1.0f, 1.0f, 3.0f, 3.0f);
+    InverterOutput out = inverter_step(params, in);
+    InverterOutput ref = inverter_step(ideal, in);
+
+    // Legs a and b sit on the rail: -0.7 V each; leg c carries -6 A: +0.7 V.
+    EXPECT_NEAR(out.va - ref.va, -0.7f - (-0.7f - 0.7f + 0.7f) / 3.0f, 1e-4f);
+    EXPECT_NEAR(out.vc - ref.vc,  0.7f - (-0.7f - 0.7f + 0.7f) / 3.0f, 1e-4f);
+}
+
+TEST(Inverter, QuantizesDutyToTimerCounts) {
+    InverterParams params{};
+    params.pwm_counts = 10;
+
+    InverterOutput out = inverter_step(params, make_input(0.13f, -0.13f, 0.0f, 0.0f, 0.0f));
+
+    // d_a = 0.565 -> 0.6, d_b = 0.435 -> 0.4, d_c = 0.5.
+    EXPECT_NEAR(out.va,  0.1f * 24.0f, 1e-4f);
+    EXPECT_NEAR(out.vb, -0.1f * 24.0f, 1e-4f);
+    EXPECT_NEAR(out.vc,  0.0f, 1e-4f);
+}
+
+static InverterInput make_off_input(float i_a, float i_b, float e_a, float e_b) {
+    InverterInput in = make_input(0.0f, 0.0f, 0.0f, i_a, i_b);
+    in.gates_off = true;
+    in.ea = e_a;
+    in.eb = e_b;
+    in.ec = -e_a - e_b;
+    return in;
+}
+
+TEST(Inverter, GatesOffClampConductingLegsAndFloatTheIdleOne) {
+    InverterParams params{};
+    InverterOutput out = inverter_step(params, make_off_input(3.0f, -3.0f, 1.0f, 2.0f));
+
+    // Poles at -12 V and +12 V; the star point follows from the EMFs.
+    EXPECT_NEAR(out.va, -10.5f, 1e-5f);
+    EXPECT_NEAR(out.vb,  13.5f, 1e-5f);
+    EXPECT_NEAR(out.vc,  -3.0f, 1e-5f);
+    EXPECT_FALSE(out.leg_open[0]);
+    EXPECT_FALSE(out.leg_open[1]);
+    EXPECT_TRUE(out.leg_open[2]);
+}
+
+TEST(Inverter, GatesOffIdleWindingConductsOnlyAboveTheBus) {
+    InverterParams params{};
+    InverterOutput out = inverter_step(params, make_off_input(0.0f, 0.0f, 5.0f, -2.0f));
+    EXPECT_FLOAT_EQ(out.va, 5.0f);
+    EXPECT_FLOAT_EQ(out.vb, -2.0f);
+    EXPECT_FLOAT_EQ(out.vc, -3.0f);
+    EXPECT_TRUE(out.leg_open[0] && out.leg_open[1] && out.leg_open[2]);
+
+    // A 35 V line EMF against a 24 V bus rectifies through a and c.
+    out = inverter_step(params, make_off_input(0.0f, 0.0f, 20.0f, -5.0f));
+    EXPECT_NEAR(out.va, 14.5f, 1e-5f);
+    EXPECT_NEAR(out.vb, -5.0f, 1e-5f);
+    EXPECT_NEAR(out.vc, -9.5f, 1e-5f);
+    EXPECT_TRUE(out.leg_open[1]);
+    EXPECT_FALSE(out.leg_open[0] || out.leg_open[2]);
+}
+
+TEST(Inverter, OffSettleStopsCurrentsAtZero) {
+    InverterOutput out{};
+    const float prev[3] = {2.0f, -1.0f, -1.0f};
+    float i[3] = {-0.1f, -0.5f, 0.6f};
+    inverter_off_settle(out, prev, i);
+    EXPECT_EQ(i[0], 0.0f);
+    EXPECT_EQ(i[1], 0.0f);
+    EXPECT_EQ(i[2], 0.0f);
+
+    out.leg_open[2] = true;
+    const float prev2[3] = {2.0f, -2.0f, 0.0f};
+    float j[3] = {1.5f, -1.4f, -0.1f};
+    inverter_off_settle(out, prev2, j);
+    EXPECT_FLOAT_EQ(j[0], 1.45f);
+    EXPECT_FLOAT_EQ(j[1], -1.45f);
+    EXPECT_EQ(j[2], 0.0f);
+}
+
+static SimAxisConfig make_sim_axis_cfg() {
+    SimAxisConfig cfg{};
+
+    cfg.axis_cfg.cur  = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.02f;
+
+    cfg.inverter.t_dead = 1e-6f;
+    cfg.inverter.f_pwm = 20000.0f;
+    cfg.inverter.v_sw = 0.7f;
+    cfg.inverter.r_on = 0.01f;
+    cfg.inverter.i_dead_band = 0.1f;
+    cfg.inverter.pwm_counts = 2000;
+
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+// RMS deviation of the measured dq current from its command once the drive
+// has settled; the inverter nonlinearity shows up as a 6th-harmonic ripple.
+static float dq_current_distortion(const SimAxisConfig& cfg, float iq_target) {
+    SimAxisState st{};
+
+    const float dt = 5e-5f;
+    const int steps = 20000;
+    double err2 = 0.0;
+    int n = 0;
+    for (int k = 0; k < steps; ++k) {
+        AxisCoreOutput out =
+            sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, iq_target);
+        if (k >= steps / 2) {
+            float ed = out.i_dq.d;
+            float eq = iq_target - out.i_dq.q;
+            err2 += ed * ed + eq * eq;
+            ++n;
+        }
+    }
+    return static_cast<float>(std::sqrt(err2 / n));
+}
+
+TEST(Inverter, DeadtimeCompensationReducesCurrentDistortion) {
+    SimAxisConfig ideal = make_sim_axis_cfg();
+    ideal.inverter = InverterParams{};
+
+    SimAxisConfig raw = make_sim_axis_cfg();
+
+    // Calibrated against the inverter, and with the voltage estimate 20% low.
+    SimAxisConfig comp = make_sim_axis_cfg();
+    float v_dead = comp.inverter.t_dead * comp.inverter.f_pwm * comp.v_bus;
+    float v_err = v_dead + comp.inverter.v_sw;
+    comp.axis_cfg.dtc = DeadtimeCompConfig{v_err, comp.inverter.i_dead_band};
+
+    SimAxisConfig comp_low = comp;
+    comp_low.axis_cfg.dtc.v_comp = 0.8f * v_err;
+
+    float d_ideal = dq_current_distortion(ideal, 1.0f);
+    float d_raw = dq_current_distortion(raw, 1.0f);
+    float d_comp = dq_current_distortion(comp, 1.0f);
+    float d_comp_low = dq_current_distortion(comp_low, 1.0f);
+
+    EXPECT_GT(d_raw, 0.1f);
+    EXPECT_LT(d_ideal, 0.01f);
+    EXPECT_LT(d_comp, 0.1f * d_raw);
+    EXPECT_LT(d_comp_low, 0.5f * d_raw);
+}
+
+// An Idle axis must let a spinning rotor coast: the zero vector would short
+// the windings and brake it with tens of amps.
+TEST(Inverter, IdleAxisFloatsTheLegs) {
+    for (bool switched : {false, true}) {
+        SimAxisConfig cfg = make_sim_axis_cfg();
+        cfg.motor_params.B = 0.0f;
+        cfg.switched_pwm = switched;
+        SimAxisState st{};
+        st.motor_state.omega_m = 50.0f;
+
+        AxisCoreOutput out{};
+        for (int k = 0; k < 2000; ++k) {
+            out = sim_axis_step(st, cfg, 5e-5f, AxisMode::Idle, 0.0f, 0.0f, 0.0f);
+            ASSERT_EQ(st.motor_state.ia, 0.0f) << "switched=" << switched << " k=" << k;
+            ASSERT_EQ(st.motor_state.ib, 0.0f);
+            ASSERT_EQ(st.motor_state.ic, 0.0f);
+        }
+        EXPECT_FALSE(out.pwm_enable);
+        EXPECT_FLOAT_EQ(st.motor_state.omega_m, 50.0f);
+    }
+}
+
+TEST(Inverter, FloatingLegsLetTheCurrentDecayToZero) {
+    for (bool switched : {false, true}) {
+        SimAxisConfig cfg = make_sim_axis_cfg();
+        cfg.switched_pwm = switched;
+        SimAxisState st{};
+        st.motor_state.ia = 5.0f;
+        st.motor_state.ib = -2.5f;
+        st.motor_state.ic = -2.5f;
+
+        // Against the 24 V bus the 5 A decays in well under a millisecond,
+        // and once out it stays out.
+        for (int k = 0; k < 20; ++k) {
+            sim_axis_step(st, cfg, 5e-5f, AxisMode::Idle, 0.0f, 0.0f, 0.0f);
+            EXPECT_GE(st.motor_state.ia, 0.0f) << "switched=" << switched;
+            EXPECT_NEAR(st.motor_state.ia + st.motor_state.ib + st.motor_state.ic, 0.0f, 1e-4f);
+        }
+        EXPECT_EQ(st.motor_state.ia, 0.0f) << "switched=" << switched;
+        EXPECT_EQ(st.motor_state.ib, 0.0f);
+        EXPECT_EQ(st.motor_state.ic, 0.0f);
+    }
+}
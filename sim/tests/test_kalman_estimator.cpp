@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include "sim_axis_runner.hpp"
+
+struct EstimatorRun {
+    float rms_est_err;  // speed estimate against the true rotor speed, settled
+    float dip;          // peak speed drop after a load step
+};
+
+// Velocity mode at 50 rad/s on a 2048-line encoder; a load step lands
+// after the loop has settled.
+static EstimatorRun run_speed_hold(SpeedEstimatorKind kind) {
+    const float dt = 5e-5f;
+    const uint16_t spd_div = 4;
+    const float w_target = 50.0f;
+
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.spd = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f, PIConfig{5.0f, 500.0f, -100.0f, 100.0f},
+                                         PIConfig{5.0f, 500.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.lim = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+    cfg.axis_cfg.rate = MultirateConfig{spd_div, spd_div, 0};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+    cfg.v_bus = 24.0f;
+
+    const float kt = 1.5f * cfg.motor_params.p * cfg.motor_params.psi_m;
+    cfg.axis_cfg.est.lp = LowPassConfig{0.2f};
+    cfg.axis_cfg.est.kind = kind;
+    EXPECT_TRUE(kalman_build(cfg.axis_cfg.est.kf,
+                             KalmanModel{cfg.motor_params.J, cfg.motor_params.B, kt, 0.05f, 5e-3f, 3e-3f},
+                             dt * spd_div));
+
+    SimEncoderConfig enc{};
+    EXPECT_TRUE(encoder_build(enc.decoder, EncoderType::Incremental, 2048, 4, 0, 0.0f));
+    cfg.encoder = &enc;
+
+    SimAxisState st{};
+    EstimatorRun r{};
+    double sq = 0.0;
+    int n = 0;
+    for (int k = 0; k < 40000; ++k) {
+        if (k == 30000) {
+            cfg.load.T_const = 0.05f;
+        }
+        sim_axis_step(st, cfg, dt, AxisMode::Velocity, 0.0f, w_target, 0.0f);
+        float w_true = st.motor_state.omega_m;
+        if (k >= 15000 && k < 30000) {
+            float e = st.axis_state.est.lp.y - w_true;
+            sq += static_cast<double>(e) * e;
+            ++n;
+        }
+        if (k >= 30000) {
+            r.dip = std::fmax(r.dip, w_target - w_true);
+        }
+    }
+    r.rms_est_err = static_cast<float>(std::sqrt(sq / n));
+    return r;
+}
+
+TEST(KalmanEstimator, RejectsEncoderQuantizationNoise) {
+    EstimatorRun lp = run_speed_hold(SpeedEstimatorKind::LowPass);
+    EstimatorRun kf = run_speed_hold(SpeedEstimatorKind::Kalman);
+
+    RecordProperty("lowpass_rms_est_err", std::to_string(lp.rms_est_err));
+    RecordProperty("kalman_rms_est_err", std::to_string(kf.rms_est_err));
+    RecordProperty("lowpass_load_dip", std::to_string(lp.dip));
+    RecordProperty("kalman_load_dip", std::to_string(kf.dip));
+
+    EXPECT_LT(kf.rms_est_err, 0.2f * lp.rms_est_err);
+    // The load torque estimate lets it hold the loop as stiff as the
+    // unfiltered difference would.
+    EXPECT_LT(kf.dip, 1.1f * lp.dip);
+}
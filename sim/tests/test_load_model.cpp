@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "load_model.hpp"
+#include "pmsm.hpp"
+#include "sim_axis_runner.hpp"
+
+static PmsmParams make_default_params() {
+    PmsmParams p{};
+    p.Rs = 0.1f;
+    p.Ls = 0.001f;
+    p.psi_m = 0.05f;
+    p.p = 4.0f;
+    p.J = 0.0001f;
+    p.B = 0.0f;
+    return p;
+}
+
+TEST(LoadModel, EmptyParamsGiveNoTorque) {
+    LoadTorques T = load_torques(LoadParams{}, LoadContext{10.0f, 1.0f, 0.0f}, 0.0f);
+    EXPECT_FLOAT_EQ(T.T_rotor, 0.0f);
+    EXPECT_FLOAT_EQ(T.T_load_net, 0.0f);
+}
+
+TEST(LoadModel, StribeckFrictionDecaysToCoulomb) {
+    LoadParams load{};
+    load.T_coulomb = 0.1f;
+    load.T_stribeck = 0.3f;
+    load.w_stribeck = 1.0f;
+    load.B_viscous = 0.01f;
+
+    float T_slow = load_torques(load, LoadContext{1e-3f, 0.0f, 0.0f}, 0.0f).T_rotor;
+    float T_fast = load_torques(load, LoadContext{20.0f, 0.0f, 0.0f}, 0.0f).T_rotor;
+    float T_back = load_torques(load, LoadContext{-20.0f, 0.0f, 0.0f}, 0.0f).T_rotor;
+
+    EXPECT_NEAR(T_slow, 0.3f, 1e-3f);
+    EXPECT_NEAR(T_fast, 0.1f + 0.2f, 1e-4f);
+    EXPECT_NEAR(T_back, -T_fast, 1e-6f);
+}
+
+TEST(LoadModel, CoggingFollowsElectricalAngle) {
+    LoadParams load{};
+    load.cog_amp = 0.05f;
+    load.cog_periods = 6.0f;
+
+    float th = 0.1f;
+    float T = load_torques(load, LoadContext{0.0f, th, 0.0f}, 0.0f).T_rotor;
+    EXPECT_NEAR(T, 0.05f * std::sin(6.0f * th), 1e-6f);
+}
+
+TEST(LoadModel, CoggingNeedsWholePeriodsPerElectricalTurn) {
+    LoadParams load{};
+    load.cog_periods = 1.5f;
+    EXPECT_TRUE(load_params_valid(load));   // no cogging configured
+
+    load.cog_amp = 0.05f;
+    EXPECT_FALSE(load_params_valid(load));
+    load.cog_periods = 6.0f;
+    EXPECT_TRUE(load_params_valid(load));
+
+    // Whole periods are continuous across the wrap of theta_e.
+    float T_end = load_torques(load, LoadContext{0.0f, 2.0f * 3.14159265f - 1e-4f, 0.0f}, 0.0f).T_rotor;
+    float T_start = load_torques(load, LoadContext{0.0f, 0.0f, 0.0f}, 0.0f).T_rotor;
+    EXPECT_NEAR(T_end, T_start, 1e-3f);
+
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.load = load;
+    SimAxisState st{};
+    EXPECT_TRUE(sim_axis_prepare(st, cfg, 5e-5f));
+    cfg.load.cog_periods = 1.5f;
+    EXPECT_FALSE(sim_axis_prepare(st, cfg, 5e-5f));
+}
+
+TEST(LoadModel, TableInterpolatesAndClamps) {
+    static const float w[] = {0.0f, 10.0f, 20.0f};
+    static const float torque[] = {0.0f, 0.1f, 0.4f};
+    LoadParams load{};
+    load.table = LoadTable{w, torque, 3};
+
+    EXPECT_NEAR(load_torques(load, LoadContext{5.0f, 0.0f, 0.0f}, 0.0f).T_rotor, 0.05f, 1e-6f);
+    EXPECT_NEAR(load_torques(load, LoadContext{15.0f, 0.0f, 0.0f}, 0.0f).T_rotor, 0.25f, 1e-6f);
+    EXPECT_NEAR(load_torques(load, LoadContext{50.0f, 0.0f, 0.0f}, 0.0f).T_rotor, 0.4f, 1e-6f);
+    EXPECT_NEAR(load_torques(load, LoadContext{-5.0f, 0.0f, 0.0f}, 0.0f).T_rotor, 0.0f, 1e-6f);
+}
+
+static float quadratic_fan(const LoadContext& ctx, void* user) {
+    float k = *static_cast<float*>(user);
+    return k * ctx.omega_m * std::fabs(ctx.omega_m);
+}
+
+TEST(LoadModel, UserHookAddsTorque) {
+    float k = 1e-3f;
+    LoadParams load{};
+    load.T_const = 0.02f;
+    load.fn = quadratic_fan;
+    load.user = &k;
+
+    float T = load_torques(load, LoadContext{10.0f, 0.0f, 0.0f}, 0.0f).T_rotor;
+    EXPECT_NEAR(T, 0.02f + 0.1f, 1e-6f);
+}
+
+TEST(LoadModel, ConstantLoadDeceleratesRotor) {
+    PmsmParams params = make_default_params();
+    params.psi_m = 0.0f;
+    LoadParams load{};
+    load.T_const = 0.01f;
+
+    PmsmState st{};
+    st.omega_m = 10.0f;
+
+    float dt = 1e-4f;
+    for (int k = 0; k < 1000; ++k) {
+        pmsm_step(st, params, load, PmsmInput{}, dt);
+    }
+
+    // 0.1 s at -0.01 N*m / 1e-4 kg*m^2 = -100 rad/s^2.
+    EXPECT_NEAR(st.omega_m, 0.0f, 1e-3f);
+}
+
+TEST(LoadModel, CompliantShaftOscillatesAtTwoMassFrequency) {
+    PmsmParams params = make_default_params();
+    params.psi_m = 0.0f;
+    LoadParams load{};
+    load.k_shaft = 10.0f;
+    load.J_load = 0.0001f;
+
+    PmsmState st{};
+    st.shaft_twist = 0.01f;
+
+    // Two-mass mode: w = sqrt(k * (1/J_m + 1/J_l)) = sqrt(2e5) rad/s.
+    float w_res = std::sqrt(10.0f * (1.0f / 0.0001f + 1.0f / 0.0001f));
+    float half_period = pi_v / w_res;
+
+    float dt = 1e-6f;
+    int steps = static_cast<int>(half_period / dt);
+    for (int k = 0; k < steps; ++k) {
+        pmsm_step(st, params, load, PmsmInput{}, dt);
+    }
+
+    EXPECT_NEAR(st.shaft_twist, -0.01f, 5e-4f);
+    EXPECT_NEAR(st.omega_m + st.omega_load, 0.0f, 1e-3f);
+}
+
+TEST(LoadModel, VelocityLoopRejectsLoadStep) {
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.spd = SpeedLoopConfig{-20.0f, 20.0f};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+    cfg.motor_params = make_default_params();
+    cfg.motor_params.B = 0.001f;
+    cfg.load.T_coulomb = 0.01f;
+    cfg.load.w_coulomb_band = 1.0f;
+    cfg.v_bus = 24.0f;
+
+    SimAxisState st{};
+    cfg.axis_cfg.spd.iq_pi = PIConfig{0.05f, 2.0f, -20.0f, 20.0f};
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+
+    const float dt = 5e-5f;
+    const float w_target = 20.0f;
+    for (int k = 0; k < 20000; ++k) {
+        sim_axis_step(st, cfg, dt, AxisMode::Velocity, 0.0f, w_target, 0.0f);
+    }
+    EXPECT_NEAR(st.motor_state.omega_m, w_target, 0.5f);
+
+    cfg.load.T_const = 0.1f;
+    float w_min = st.motor_state.omega_m;
+    for (int k = 0; k < 40000; ++k) {
+        sim_axis_step(st, cfg, dt, AxisMode::Velocity, 0.0f, w_target, 0.0f);
+        w_min = std::fmin(w_min, st.motor_state.omega_m);
+    }
+
+    EXPECT_LT(w_min, w_target - 0.5f);
+    EXPECT_NEAR(st.motor_state.omega_m, w_target, 0.5f);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "sim_axis_runner.hpp"
+#include "foc_math.hpp"
+
+static SimAxisConfig make_sim_axis_cfg(ModulationMode mode) {
+    SimAxisConfig cfg{};
+
+    cfg.axis_cfg.traj = TrajConfig{1.0f, 2.0f};
+    cfg.axis_cfg.pos  = PositionLoopConfig{-500.0f, 500.0f};
+    cfg.axis_cfg.spd  = SpeedLoopConfig{-20.0f, 20.0f};
+    cfg.axis_cfg.cur  = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+    cfg.axis_cfg.mod  = ModulationConfig{mode};
+    cfg.axis_cfg.foc.loop.id = PIConfig{2.0f, 400.0f, -100.0f, 100.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{2.0f, 400.0f, -100.0f, 100.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+struct ModulationRun {
+    float omega_m;
+    float iq_rms_err;
+    long  switch_events;
+};
+
+static int switching_legs(const AxisCoreOutput& out) {
+    int n = 0;
+    if (std::fabs(out.m_a) < 1.0f) ++n;
+    if (std::fabs(out.m_b) < 1.0f) ++n;
+    if (std::fabs(out.m_c) < 1.0f) ++n;
+    return n;
+}
+
+// Drives a constant iq demand and reports where the motor settles, how well
+// iq tracked over the second half and how many leg transitions the inverter
+// made. An unclamped leg toggles twice per centre-aligned PWM period.
+static ModulationRun run_iq_drive(ModulationMode mode, float iq_target, int steps) {
+    SimAxisConfig cfg = make_sim_axis_cfg(mode);
+    SimAxisState st{};
+
+    const float dt = 5e-5f;
+    ModulationRun r{0.0f, 0.0f, 0};
+    double err2 = 0.0;
+    int n_err = 0;
+
+    for (int k = 0; k < steps; ++k) {
+        AxisCoreOutput out =
+            sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, iq_target);
+        r.switch_events += 2 * switching_legs(out);
+
+        if (k >= steps / 2) {
+            float e = iq_target - out.i_dq.q;
+            err2 += e * e;
+            ++n_err;
+        }
+    }
+
+    r.omega_m = st.motor_state.omega_m;
+    r.iq_rms_err = static_cast<float>(std::sqrt(err2 / n_err));
+    return r;
+}
+
+TEST(ModulationModes, DpwmCutsSwitchingEventsByAThird) {
+    const ModulationMode modes[] = {
+        ModulationMode::Dpwm60,
+        ModulationMode::Dpwm120High,
+        ModulationMode::Dpwm120Low,
+    };
+
+    // A small iq demand settles below base speed against viscous friction, so
+    // every mode stays in the linear range.
+    ModulationRun ref = run_iq_drive(ModulationMode::Svpwm, 0.2f, 20000);
+    ASSERT_GT(ref.switch_events, 0);
+
+    for (ModulationMode mode : modes) {
+        ModulationRun r = run_iq_drive(mode, 0.2f, 20000);
+        float ratio = static_cast<float>(r.switch_events) / ref.switch_events;
+        EXPECT_NEAR(ratio, 2.0f / 3.0f, 0.03f);
+        EXPECT_NEAR(r.omega_m, ref.omega_m, 0.01f * std::fabs(ref.omega_m));
+        EXPECT_NEAR(r.iq_rms_err, ref.iq_rms_err, 0.05f);
+    }
+}
+
+TEST(ModulationModes, OvermodRaisesVoltageLimitedSpeed) {
+    ModulationRun svpwm = run_iq_drive(ModulationMode::Svpwm, 2.0f, 40000);
+    ModulationRun dpwm = run_iq_drive(ModulationMode::Dpwm60, 2.0f, 40000);
+    ModulationRun ovm = run_iq_drive(ModulationMode::Overmod, 2.0f, 40000);
+
+    // No-load speed is set by the fundamental voltage the inverter can reach.
+    EXPECT_NEAR(dpwm.omega_m, svpwm.omega_m, 0.005f * svpwm.omega_m);
+    EXPECT_GT(ovm.omega_m, 1.015f * svpwm.omega_m);
+
+    float six_step_limit = 2.0f / pi_v * 24.0f / (0.05f * 4.0f);
+    EXPECT_LT(ovm.omega_m, six_step_limit);
+}
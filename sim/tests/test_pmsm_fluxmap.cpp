@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "pmsm_fluxmap.hpp"
+#include "sim_axis_runner.hpp"
+
+static PmsmParams make_default_params() {
+    PmsmParams p{};
+    p.Rs = 0.1f;
+    p.Ls = 0.001f;
+    p.psi_m = 0.05f;
+    p.p = 4.0f;
+    p.J = 0.0001f;
+    p.B = 0.0001f;
+    return p;
+}
+
+static SaturationModel make_linear_model() {
+    return SaturationModel{0.05f, 0.001f, 0.001f, 10.0f, 1.0f, 0.0f};
+}
+
+static SaturationModel make_saturating_model() {
+    return SaturationModel{0.05f, 0.001f, 0.0016f, 10.0f, 0.5f, 0.1f};
+}
+
+struct FluxMapFixture {
+    std::vector<FluxMapNode> nodes;
+    PmsmFluxMap map{};
+    bool ok;
+
+    explicit FluxMapFixture(const SaturationModel& model)
+        : nodes(81 * 81)
+    {
+        ok = fluxmap_build(map, nodes.data(), 81, 81,
+                           -0.03f, 0.09f, -0.06f, 0.06f, model);
+    }
+};
+
+static float torque_at(const SaturationModel& model, float id, float iq, float p) {
+    float psi_d, psi_q;
+    saturation_model_flux(model, id, iq, psi_d, psi_q);
+    return 1.5f * p * (psi_d * iq - psi_q * id);
+}
+
+TEST(PmsmFluxMap, BuildRejectsBadGrid) {
+    FluxMapNode nodes[4];
+    PmsmFluxMap map{};
+    EXPECT_FALSE(fluxmap_build(map, nodes, 1, 4, 0.0f, 1.0f, 0.0f, 1.0f, make_linear_model()));
+    EXPECT_FALSE(fluxmap_build(map, nodes, 2, 2, 1.0f, 0.0f, 0.0f, 1.0f, make_linear_model()));
+}
+
+TEST(PmsmFluxMap, LookupInvertsSaturationModel) {
+    SaturationModel model = make_saturating_model();
+    FluxMapFixture fx(model);
+    ASSERT_TRUE(fx.ok);
+
+    const float currents[][2] = {
+        {0.0f, 0.0f}, {-5.0f, 10.0f}, {3.0f, -8.0f}, {-12.0f, 20.0f}, {0.0f, 25.0f},
+    };
+    for (const auto& c : currents) {
+        float psi_d, psi_q;
+        saturation_model_flux(model, c[0], c[1], psi_d, psi_q);
+        FluxMapNode i = fluxmap_lookup(fx.map, psi_d, psi_q);
+        EXPECT_NEAR(i.id, c[0], 0.3f);
+        EXPECT_NEAR(i.iq, c[1], 0.3f);
+    }
+}
+
+TEST(PmsmFluxMap, SaturationAndCrossSaturationShape) {
+    SaturationModel sat = make_saturating_model();
+    SaturationModel lin = make_linear_model();
+    lin.Lq = sat.Lq;
+
+    // Torque per amp drops at high q current.
+    float kt_low = torque_at(sat, 0.0f, 1.0f, 4.0f) / 1.0f;
+    float kt_high = torque_at(sat, 0.0f, 30.0f, 4.0f) / 30.0f;
+    EXPECT_LT(kt_high, 0.8f * kt_low);
+
+    // Saliency: with Lq > Ld, negative id adds reluctance torque.
+    EXPECT_GT(torque_at(lin, -5.0f, 5.0f, 4.0f), torque_at(lin, 0.0f, 5.0f, 4.0f));
+
+    // Cross-saturation: q flux at fixed iq falls as |id| grows.
+    float psi_d, psi_q_0, psi_q_x;
+    saturation_model_flux(sat, 0.0f, 10.0f, psi_d, psi_q_0);
+    saturation_model_flux(sat, -15.0f, 10.0f, psi_d, psi_q_x);
+    EXPECT_LT(psi_q_x, psi_q_0);
+}
+
+TEST(PmsmFluxMap, LinearMapMatchesPhaseModel) {
+    PmsmParams params = make_default_params();
+    FluxMapFixture fx(make_linear_model());
+    ASSERT_TRUE(fx.ok);
+
+    PmsmState abc{};
+    PmsmState fm{};
+    PmsmFluxState flux{};
+
+    float dt = 1e-5f;
+    float v_amp = 5.0f;
+    for (int k = 0; k < 5000; ++k) {
+        float th = abc.theta_e + 1.5f;
+        PmsmInput in{};
+        in.va = v_amp * std::cos(th);
+        in.vb = v_amp * std::cos(th - 2.0f * pi_v / 3.0f);
+        in.vc = v_amp * std::cos(th + 2.0f * pi_v / 3.0f);
+        pmsm_step(abc, params, in, dt);
+        pmsm_fluxmap_step(fm, flux, params, fx.map, LoadParams{}, in, dt);
+    }
+
+    EXPECT_GT(abc.omega_m, 1.0f);
+    EXPECT_NEAR(fm.omega_m, abc.omega_m, 0.01f * abc.omega_m);
+    EXPECT_NEAR(fm.ia, abc.ia, 0.05f);
+    EXPECT_NEAR(fm.ib, abc.ib, 0.05f);
+}
+
+TEST(PmsmFluxMap, CurrentLoopTracksSaturatingMotor) {
+    FluxMapFixture fx(make_saturating_model());
+    ASSERT_TRUE(fx.ok);
+
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim = LimitsConfig{-40.0f, 40.0f, -500.0f, 500.0f};
+    cfg.motor_params = make_default_params();
+    cfg.motor_params.J = 0.01f;
+    cfg.flux_map = &fx.map;
+    cfg.v_bus = 48.0f;
+
+    SimAxisState st{};
+    cfg.axis_cfg.foc.loop.id = PIConfig{1.0f, 200.0f, -100.0f, 100.0f};
+    cfg.axis_cfg.foc.loop.iq = PIConfig{1.0f, 200.0f, -100.0f, 100.0f};
+
+    AxisCoreOutput out{};
+    for (int k = 0; k < 4000; ++k) {
+        out = sim_axis_step(st, cfg, 5e-5f, AxisMode::CurrentIq, 0.0f, 0.0f, 25.0f);
+    }
+
+    EXPECT_NEAR(out.i_dq.q, 25.0f, 0.5f);
+    EXPECT_NEAR(out.i_dq.d, 0.0f, 0.5f);
+    EXPECT_GT(st.motor_state.omega_m, 0.0f);
+}
+
+TEST(PmsmFluxMap, SwitchedPwmWithFluxMapIsRejected) {
+    FluxMapFixture fx(make_saturating_model());
+    ASSERT_TRUE(fx.ok);
+
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim = LimitsConfig{-40.0f, 40.0f, -500.0f, 500.0f};
+    cfg.motor_params = make_default_params();
+    cfg.flux_map = &fx.map;
+    cfg.v_bus = 48.0f;
+
+    SimAxisState st{};
+    EXPECT_TRUE(sim_axis_prepare(st, cfg, 5e-5f));
+
+    cfg.switched_pwm = true;
+    EXPECT_FALSE(sim_axis_prepare(st, cfg, 5e-5f));
+    AxisCoreOutput out = sim_axis_step(st, cfg, 5e-5f, AxisMode::CurrentIq, 0.0f, 0.0f, 25.0f);
+    EXPECT_FALSE(out.pwm_enable);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include "sim_axis_runner.hpp"
+#include "step_metrics.hpp"
+
+// Closed-loop performance regression suite. Each case runs a standard
+// step through sim_axis_step, computes its metrics and compares them with
+// sim/regression/baseline.txt. All metrics are lower-is-better; a case
+// fails when one exceeds baseline * (1 + rel) + abs.
+//
+// Re-record after an intended change with
+//   SIM_REGRESSION_UPDATE=1 ctest -R Regression
+// Recording is done by Regression.RecordBaseline alone, which runs every
+// case and writes the file once; the per-case tests skip meanwhile, so
+// ctest -j cannot interleave their writes.
+
+namespace {
+
+using MetricMap = std::map<std::string, double>;
+
+struct Tolerance {
+    const char* metric;
+    double rel;
+    double abs;
+};
+
+// Only deterministic metrics belong here: wall-clock cost depends on the
+// machine and on whatever else ctest runs in parallel, and is measured by
+// bench/bench_sim_step instead.
+constexpr Tolerance tolerances[] = {
+    {"rise_time",     0.05, 1e-4},
+    {"overshoot",     0.10, 1e-3},
+    {"settling_time", 0.10, 5e-4},
+    {"ss_error",      0.25, 1e-4},
+    {"ripple_rms",    0.25, 1e-3},
+};
+
+struct RegressionCase {
+    const char* name;
+    AxisMode mode;
+    float target;
+    float duration;
+    float ss_window_start;
+    float t_dead;
+    float J;
+};
+
+SimAxisConfig make_sim_axis_cfg(float t_dead, float J)
+{
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.traj = TrajConfig{5.0f, 50.0f};
+    cfg.axis_cfg.pos  = PositionLoopConfig{-100.0f, 100.0f, PIConfig{20.0f, 0.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.spd  = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur  = CurrentLoopConfig{1.0f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                          PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = J;
+    cfg.motor_params.B = 0.001f;
+
+    cfg.inverter.t_dead = t_dead;
+    cfg.inverter.f_pwm = 20000.0f;
+    cfg.inverter.i_dead_band = 0.1f;
+
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+MetricMap run_case(const RegressionCase& c)
+{
+    const SimAxisConfig cfg = make_sim_axis_cfg(c.t_dead, c.J);
+    SimAxisState st{};
+    const float dt = 5e-5f;
+    const int steps = static_cast<int>(c.duration / dt);
+
+    StepMetricsConfig mcfg{0.0f, c.target, 0.1f, 0.9f, 0.02f, c.ss_window_start};
+    StepMetricsState mst{};
+
+    for (int k = 1; k <= steps; ++k) {
+        AxisCoreOutput out = sim_axis_step(st, cfg, dt, c.mode, c.target, c.target, c.target);
+        float y = c.mode == AxisMode::Position ? position64_to_rad(st.theta_mech)
+                : c.mode == AxisMode::Velocity ? st.motor_state.omega_m
+                : out.i_dq.q;
+        step_metrics_update(mst, mcfg, k * dt, y, out.i_dq.q);
+    }
+
+    StepMetrics m = step_metrics_finish(mst, mcfg);
+    MetricMap r;
+    r["rise_time"] = m.rise_time;
+    r["overshoot"] = m.overshoot;
+    r["settling_time"] = m.settling_time;
+    r["ss_error"] = m.ss_error;
+    r["ripple_rms"] = m.ripple_rms;
+    return r;
+}
+
+MetricMap load_baseline()
+{
+    MetricMap m;
+    std::ifstream f(SIM_REGRESSION_BASELINE);
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ss(line);
+        std::string key;
+        double value = 0.0;
+        if (ss >> key >> value) {
+            m[key] = value;
+        }
+    }
+    return m;
+}
+
+void store_baseline(const MetricMap& m)
+{
+    std::ofstream f(SIM_REGRESSION_BASELINE);
+    f << "# Closed-loop regression baseline: <case>.<metric> <value>\n";
+    f << "# Regenerate with SIM_REGRESSION_UPDATE=1 ctest -R Regression\n";
+    f.precision(9);
+    for (const auto& kv : m) {
+        f << kv.first << ' ' << kv.second << '\n';
+    }
+}
+
+const RegressionCase cases[] = {
+    {"position_step", AxisMode::Position, 1.0f, 1.5f, 1.0f, 0.0f, 1e-4f},
+    {"velocity_step", AxisMode::Velocity, 50.0f, 1.5f, 1.0f, 0.0f, 1e-4f},
+    // Heavy rotor so back-EMF stays small over the window.
+    {"current_step", AxisMode::CurrentIq, 2.0f, 0.05f, 0.03f, 0.0f, 0.1f},
+    {"velocity_step_deadtime", AxisMode::Velocity, 50.0f, 1.5f, 1.0f, 1e-6f, 1e-4f},
+};
+
+bool recording()
+{
+    return std::getenv("SIM_REGRESSION_UPDATE") != nullptr;
+}
+
+void check_case(const char* name)
+{
+    if (recording()) {
+        GTEST_SKIP() << "recorded by Regression.RecordBaseline";
+    }
+    const RegressionCase* c = nullptr;
+    for (const RegressionCase& rc : cases) {
+        c = std::string(rc.name) == name ? &rc : c;
+    }
+    ASSERT_NE(c, nullptr) << name;
+
+    const MetricMap measured = run_case(*c);
+    const MetricMap baseline = load_baseline();
+
+    for (const Tolerance& tol : tolerances) {
+        const std::string key = std::string(c->name) + "." + tol.metric;
+        const double value = measured.at(tol.metric);
+        auto it = baseline.find(key);
+        if (it == baseline.end()) {
+            ADD_FAILURE() << key << " missing from baseline (measured " << value
+                          << "); record it with SIM_REGRESSION_UPDATE=1";
+            continue;
+        }
+        const double limit = it->second * (1.0 + tol.rel) + tol.abs;
+        EXPECT_LE(value, limit) << key << " regressed: baseline " << it->second;
+    }
+}
+
+} // namespace
+
+TEST(Regression, RecordBaseline) {
+    if (!recording()) {
+        GTEST_SKIP() << "set SIM_REGRESSION_UPDATE=1 to re-record";
+    }
+    MetricMap baseline;
+    for (const RegressionCase& c : cases) {
+        for (const auto& kv : run_case(c)) {
+            baseline[std::string(c.name) + "." + kv.first] = kv.second;
+        }
+    }
+    store_baseline(baseline);
+}
+
+TEST(Regression, PositionStep) {
+    check_case("position_step");
+}
+
+TEST(Regression, VelocityStep) {
+    check_case("velocity_step");
+}
+
+TEST(Regression, CurrentStep) {
+    check_case("current_step");
+}
+
+TEST(Regression, VelocityStepWithDeadTime) {
+    check_case("velocity_step_deadtime");
+}
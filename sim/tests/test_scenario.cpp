@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "scenario.hpp"
+
+namespace {
+
+SimAxisConfig make_sim_axis_cfg()
+{
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.traj = TrajConfig{5.0f, 50.0f};
+    cfg.axis_cfg.pos  = PositionLoopConfig{-100.0f, 100.0f, PIConfig{20.0f, 0.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.spd  = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur  = CurrentLoopConfig{1.0f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                          PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+bool faster_than(const ScenarioContext& ctx, void* user)
+{
+    return ctx.st.motor_state.omega_m > *static_cast<const float*>(user);
+}
+
+Scenario move_load_ramp(ScenarioContext& ctx, float target, float* theta_after_load)
+{
+    move_to(ctx, target);
+    if (!co_await settle(ctx, 0.02f, 1.0f, 0.05f, 3.0f)) {
+        co_return false;
+    }
+
+    apply_load_step(ctx, 0.05f);
+    co_await wait_for(ctx, 0.5f);
+    *theta_after_load = position64_to_rad(ctx.st.theta_mech);
+
+    co_await ramp_speed(ctx, 50.0f, 0.5f);
+    static float w_min = 45.0f;
+    co_return co_await wait_until(ctx, faster_than, &w_min, 1.0f);
+}
+
+Scenario never_settles(ScenarioContext& ctx)
+{
+    move_to(ctx, 1.0f);
+    co_return co_await settle(ctx, 1e-7f, 1e-7f, 0.1f, 0.2f);
+}
+
+Scenario settle_without_hold(ScenarioContext& ctx)
+{
+    move_to(ctx, 1.0f);
+    co_return co_await settle(ctx, 1e-7f, 1e-7f, 0.0f, 0.2f);
+}
+
+} // namespace
+
+TEST(Scenario, MoveSettleLoadStepAndRamp) {
+    ScenarioRunner runner;
+    float theta_after_load = 0.0f;
+    int id = scenario_spawn(runner, make_sim_axis_cfg(), 5e-5f, move_load_ramp, 1.0f, &theta_after_load);
+
+    EXPECT_EQ(scenario_run(runner, 200000), 0);
+
+    ScenarioResult r = scenario_result(runner, id);
+    EXPECT_TRUE(r.done);
+    EXPECT_TRUE(r.passed);
+    EXPECT_NEAR(theta_after_load, 1.0f, 0.1f);
+    EXPECT_GT(r.ticks, static_cast<uint64_t>(1.0f / 5e-5f));
+}
+
+TEST(Scenario, SettleTimeoutFailsScenario) {
+    ScenarioRunner runner;
+    int id = scenario_spawn(runner, make_sim_axis_cfg(), 5e-5f, never_settles);
+    scenario_run(runner, 100000);
+
+    ScenarioResult r = scenario_result(runner, id);
+    EXPECT_TRUE(r.done);
+    EXPECT_FALSE(r.passed);
+    EXPECT_EQ(r.ticks, 4000u);
+}
+
+TEST(Scenario, SettleWithoutHoldStillChecksTheBand) {
+    ScenarioRunner runner;
+    int id = scenario_spawn(runner, make_sim_axis_cfg(), 5e-5f, settle_without_hold);
+    scenario_run(runner, 100000);
+
+    ScenarioResult r = scenario_result(runner, id);
+    EXPECT_TRUE(r.done);
+    EXPECT_FALSE(r.passed);
+    EXPECT_EQ(r.ticks, 4000u);
+}
+
+TEST(Scenario, InterleavedScenariosMatchSoloRun) {
+    constexpr int n = 32;
+    ScenarioRunner many;
+    float theta[n] = {};
+    for (int i = 0; i < n; ++i) {
+        scenario_spawn(many, make_sim_axis_cfg(), 5e-5f, move_load_ramp, 0.5f + 0.02f * i, &theta[i]);
+    }
+    EXPECT_EQ(scenario_run(many, 200000), 0);
+
+    ScenarioRunner solo;
+    float theta_solo = 0.0f;
+    int id = scenario_spawn(solo, make_sim_axis_cfg(), 5e-5f, move_load_ramp, 0.5f + 0.02f * 7, &theta_solo);
+    scenario_run(solo, 200000);
+
+    for (int i = 0; i < n; ++i) {
+        EXPECT_TRUE(scenario_result(many, i).passed) << "scenario " << i;
+    }
+    EXPECT_EQ(theta[7], theta_solo);
+    EXPECT_EQ(scenario_result(many, 7).ticks, scenario_result(solo, id).ticks);
+}
+
+TEST(Scenario, CaptureLessLambdaRunsAsFunction) {
+    ScenarioRunner runner;
+    int id = scenario_spawn(runner, make_sim_axis_cfg(), 5e-5f,
+                            +[](ScenarioContext& ctx, float seconds) -> Scenario {
+                                co_await wait_for(ctx, seconds);
+                                co_return true;
+                            },
+                            0.01f);
+    EXPECT_EQ(scenario_run(runner, 1000), 0);
+    EXPECT_TRUE(scenario_result(runner, id).passed);
+    EXPECT_EQ(scenario_result(runner, id).ticks, 200u);
+}
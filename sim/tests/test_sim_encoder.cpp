@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include "sim_axis_runner.hpp"
+#include "sim_encoder.hpp"
+#include "foc_math.hpp"
+
+// Worst electrical-angle error at the PWM centre for a shaft spinning at
+// w rad/s, sampled every period_ns.
+static float worst_elec_error(const SimEncoderConfig& enc, float w, bool compensate) {
+    const int64_t period_ns = 50000;
+    const uint32_t p = enc.decoder.pole_pairs;
+    EncoderState st{};
+    float worst = 0.0f;
+    for (int k = 0; k < 2000; ++k) {
+        int64_t t = k * period_ns;
+        Position64 theta = position64_from_rad(w * t * 1e-9f);
+        EncoderInput in = sim_encoder_sample(enc, theta);
+        in.t_sample_ns = t;
+        in.t_apply_ns = compensate ? t + period_ns / 2 : t;
+        EncoderOutput out = run_encoder(st, enc.decoder, in);
+
+        Position64 at_apply = position64_from_rad(w * (t + period_ns / 2) * 1e-9f);
+        float elec_true = angle32_to_rad(position64_angle(at_apply) * p);
+        if (k > 10) {
+            worst = std::fmax(worst, std::fabs(wrap_pi(out.theta_elec - elec_true)));
+        }
+    }
+    return worst;
+}
+
+TEST(SimEncoder, LatencyCompensationKeepsElectricalAngleAtHighSpeed) {
+    SimEncoderConfig enc{};
+    ASSERT_TRUE(encoder_build(enc.decoder, EncoderType::SinCos, 512, 4, 0, 0.0f));
+
+    const float w = 600.0f;  // ~5700 rpm
+    float raw = worst_elec_error(enc, w, false);
+    float comp = worst_elec_error(enc, w, true);
+    RecordProperty("uncompensated_rad", std::to_string(raw));
+    RecordProperty("compensated_rad", std::to_string(comp));
+
+    EXPECT_NEAR(raw, w * 4.0f * 25e-6f, 1e-3f);
+    EXPECT_LT(comp, 1e-3f);
+}
+
+TEST(SimEncoder, AnalogOffsetShowsAsBoundedInterpolationError) {
+    SimEncoderConfig enc{};
+    ASSERT_TRUE(encoder_build(enc.decoder, EncoderType::SinCos, 512, 4, 0, 0.0f));
+    enc.sin_offset = 0.02f;
+
+    EncoderState st{};
+    float worst = 0.0f;
+    const Position64 step = position64_one_turn / 512 / 37;
+    Position64 theta = 0;
+    for (int k = 0; k < 5000; ++k) {
+        theta += step;
+        EncoderOutput out = run_encoder(st, enc.decoder, sim_encoder_sample(enc, theta));
+        worst = std::fmax(worst, std::fabs(position64_delta_rad(out.theta_mech, theta)));
+    }
+    // A 2% offset bends the phase by about 0.02 rad of one period.
+    EXPECT_GT(worst, 1e-6f);
+    EXPECT_LT(worst, 0.03f * two_pi_v / 512.0f);
+}
+
+TEST(SimEncoder, ClosedLoopSpeedMatchesIdealMeasurement) {
+    SimEncoderConfig enc{};
+    ASSERT_TRUE(encoder_build(enc.decoder, EncoderType::Incremental, 4000, 4, 0, 0.0f));
+
+    float w_final[2] = {};
+    for (int use_encoder = 0; use_encoder < 2; ++use_encoder) {
+        SimAxisConfig cfg{};
+        cfg.axis_cfg.spd = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+        cfg.axis_cfg.cur = CurrentLoopConfig{1.0f, PIConfig{1.0f, 100.0f, -100.0f, 100.0f},
+                                             PIConfig{1.0f, 100.0f, -100.0f, 100.0f}};
+        cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+        cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+        cfg.axis_cfg.lim = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+        cfg.motor_params.Rs = 0.1f;
+        cfg.motor_params.Ls = 0.001f;
+        cfg.motor_params.psi_m = 0.05f;
+        cfg.motor_params.p = 4.0f;
+        cfg.motor_params.J = 0.0001f;
+        cfg.motor_params.B = 0.001f;
+        cfg.v_bus = 24.0f;
+        cfg.encoder = use_encoder ? &enc : nullptr;
+
+        SimAxisState st{};
+        for (int k = 0; k < 20000; ++k) {
+            sim_axis_step(st, cfg, 5e-5f, AxisMode::Velocity, 0.0f, 40.0f, 0.0f);
+        }
+        w_final[use_encoder] = st.motor_state.omega_m;
+    }
+    EXPECT_NEAR(w_final[0], 40.0f, 1.0f);
+    EXPECT_NEAR(w_final[1], w_final[0], 0.5f);
+}
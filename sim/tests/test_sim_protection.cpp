@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "sim_axis_runner.hpp"
+
+static SimAxisConfig make_cfg() {
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.spd = SpeedLoopConfig{-10.0f, 10.0f, PIConfig{0.05f, 2.0f, -10.0f, 10.0f}};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f, PIConfig{5.0f, 500.0f, -100.0f, 100.0f},
+                                         PIConfig{5.0f, 500.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim = LimitsConfig{-10.0f, 10.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+TEST(SimProtection, BlockedRotorTripsStallAndStopsDriving) {
+    SimAxisConfig cfg = make_cfg();
+    cfg.axis_cfg.prot.stall_iq = 5.0f;
+    cfg.axis_cfg.prot.stall_w = 1.0f;
+    cfg.axis_cfg.prot.stall_time = 0.05f;
+    // Friction well above the 3 N*m the 10 A limit can produce.
+    cfg.load.T_coulomb = 5.0f;
+    cfg.load.w_coulomb_band = 0.01f;
+
+    const float dt = 5e-5f;
+    SimAxisState st{};
+    int trip = -1;
+    AxisCoreOutput out{};
+    for (int k = 0; k < 4000; ++k) {
+        out = sim_axis_step(st, cfg, dt, AxisMode::Velocity, 0.0f, 50.0f, 0.0f);
+        if (trip < 0 && out.status.faults != 0) {
+            trip = k;
+        }
+    }
+    RecordProperty("trip_ms", std::to_string(trip * dt * 1e3f));
+
+    ASSERT_GE(trip, 0);
+    EXPECT_EQ(out.status.faults, axis_fault_stall);
+    // The speed loop needs a few ms to wind up to the stall current.
+    EXPECT_GT(trip * dt, 0.05f);
+    EXPECT_LT(trip * dt, 0.1f);
+    EXPECT_FLOAT_EQ(out.m_a, 0.0f);
+    EXPECT_NEAR(st.motor_state.ia, 0.0f, 0.5f);
+}
+
+TEST(SimProtection, SpinningFreelyDoesNotTrip) {
+    SimAxisConfig cfg = make_cfg();
+    cfg.axis_cfg.prot.i_phase_max = 30.0f;
+    cfg.axis_cfg.prot.i_rated = 5.0f;
+    cfg.axis_cfg.prot.i2t_limit = 10.0f;
+    cfg.axis_cfg.prot.stall_iq = 5.0f;
+    cfg.axis_cfg.prot.stall_w = 1.0f;
+    cfg.axis_cfg.prot.stall_time = 0.05f;
+    cfg.axis_cfg.prot.w_max = 100.0f;
+
+    SimAxisState st{};
+    for (int k = 0; k < 10000; ++k) {
+        AxisCoreOutput out = sim_axis_step(st, cfg, 5e-5f, AxisMode::Velocity, 0.0f, 50.0f, 0.0f);
+        ASSERT_EQ(out.status.faults, 0u) << "tick " << k;
+    }
+    EXPECT_NEAR(st.motor_state.omega_m, 50.0f, 2.0f);
+}
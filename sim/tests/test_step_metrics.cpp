@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "step_metrics.hpp"
+
+TEST(StepMetrics, FirstOrderResponse) {
+    StepMetricsConfig cfg{0.0f, 2.0f, 0.1f, 0.9f, 0.02f, 0.8f};
+    StepMetricsState st{};
+    const float tau = 0.05f;
+    const float dt = 1e-4f;
+    for (int k = 1; k <= 10000; ++k) {
+        float t = k * dt;
+        float y = 2.0f * (1.0f - std::exp(-t / tau));
+        step_metrics_update(st, cfg, t, y, 0.0f);
+    }
+    StepMetrics m = step_metrics_finish(st, cfg);
+
+    // 10-90 % rise of a first-order lag is tau * ln 9; 2 % settling is tau * ln 50.
+    EXPECT_NEAR(m.rise_time, tau * std::log(9.0f), 2 * dt);
+    EXPECT_NEAR(m.settling_time, tau * std::log(50.0f), 2 * dt);
+    EXPECT_FLOAT_EQ(m.overshoot, 0.0f);
+    EXPECT_LT(m.ss_error, 1e-4f);
+}
+
+TEST(StepMetrics, OvershootAndRippleOnNegativeStep) {
+    StepMetricsConfig cfg{1.0f, -1.0f, 0.1f, 0.9f, 0.05f, 0.5f};
+    StepMetricsState st{};
+    const float dt = 1e-3f;
+    for (int k = 1; k <= 1000; ++k) {
+        float t = k * dt;
+        // Undershoots to -1.3 (15 % of the 2.0 span), then sits at -1.
+        float y = t < 0.1f ? 1.0f - 23.0f * t : (t < 0.2f ? -1.3f : -1.0f);
+        float r = 0.5f * std::sin(2.0f * 3.14159265f * 100.0f * t);
+        step_metrics_update(st, cfg, t, y, r);
+    }
+    StepMetrics m = step_metrics_finish(st, cfg);
+
+    EXPECT_NEAR(m.overshoot, 0.15f, 1e-5f);
+    EXPECT_NEAR(m.settling_time, 0.199f, 1e-5f);
+    EXPECT_NEAR(m.ripple_rms, 0.5f / std::sqrt(2.0f), 1e-3f);
+    EXPECT_FLOAT_EQ(m.ss_error, 0.0f);
+}
+
+TEST(StepMetrics, NeverRisingReportsFullDuration) {
+    StepMetricsConfig cfg{0.0f, 1.0f, 0.1f, 0.9f, 0.02f, 0.5f};
+    StepMetricsState st{};
+    for (int k = 1; k <= 100; ++k) {
+        step_metrics_update(st, cfg, k * 0.01f, 0.5f, 0.0f);
+    }
+    StepMetrics m = step_metrics_finish(st, cfg);
+    EXPECT_FLOAT_EQ(m.rise_time, 1.0f);
+    EXPECT_FLOAT_EQ(m.settling_time, 1.0f);
+    EXPECT_NEAR(m.ss_error, 0.5f, 1e-6f);
+}
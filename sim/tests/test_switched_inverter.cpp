@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "switched_inverter.hpp"
+#include "sim_axis_runner.hpp"
+#include "foc_math.hpp"
+
+static PmsmParams make_locked_params() {
+    PmsmParams p{};
+    p.Rs = 0.1f;
+    p.Ls = 0.001f;
+    p.psi_m = 0.05f;
+    p.p = 4.0f;
+    p.J = 1e6f;
+    p.B = 0.0f;
+    return p;
+}
+
+static float ripple_pp(const SwitchedInverterOutput& out, int leg) {
+    return out.i_max[leg] - out.i_min[leg];
+}
+
+TEST(SwitchedInverter, ClampedLegsGiveSingleSegment) {
+    PmsmParams motor = make_locked_params();
+    InverterParams inv{};
+    PmsmState st{};
+
+    SwitchedInverterInput in{1.0f, -1.0f, -1.0f, 24.0f, 0.0f};
+    SwitchedInverterOutput out = switched_inverter_step(st, motor, LoadParams{}, inv, in, 5e-5f);
+
+    EXPECT_EQ(out.segments, 1);
+    EXPECT_GT(st.ia, 0.0f);
+    EXPECT_NEAR(st.ia + st.ib + st.ic, 0.0f, 1e-4f);
+}
+
+TEST(SwitchedInverter, PeriodAverageMatchesAveragedModel) {
+    PmsmParams motor = make_locked_params();
+    InverterParams inv{};
+    PmsmState sw{};
+    PmsmState avg{};
+
+    float m[3] = {0.3f, -0.1f, -0.2f};
+    float v_bus = 24.0f;
+    float T = 5e-5f;
+
+    for (int k = 0; k < 400; ++k) {
+        SwitchedInverterInput sw_in{m[0], m[1], m[2], v_bus, 0.0f};
+        switched_inverter_step(sw, motor, LoadParams{}, inv, sw_in, T);
+
+        InverterInput avg_in{m[0], m[1], m[2], avg.ia, avg.ib, avg.ic, v_bus};
+        InverterOutput v = inverter_step(inv, avg_in);
+        pmsm_step(avg, motor, PmsmInput{v.va, v.vb, v.vc, 0.0f}, T);
+    }
+
+    // Sampled at the period boundary, the middle of the zero vector, the
+    // switched current sits on the ripple midpoint of the averaged one.
+    EXPECT_NEAR(sw.ia, avg.ia, 0.02f * std::fabs(avg.ia));
+    EXPECT_NEAR(sw.ib, avg.ib, 0.02f * std::fabs(avg.ia));
+    EXPECT_NEAR(sw.ic, avg.ic, 0.02f * std::fabs(avg.ia));
+}
+
+TEST(SwitchedInverter, RippleScalesWithPeriod) {
+    PmsmParams motor = make_locked_params();
+    InverterParams inv{};
+
+    auto settled_ripple = [&](float T) {
+        PmsmState st{};
+        SwitchedInverterInput in{0.3f, -0.1f, -0.2f, 24.0f, 0.0f};
+        SwitchedInverterOutput out{};
+        for (int k = 0; k < static_cast<int>(0.02f / T); ++k) {
+            out = switched_inverter_step(st, motor, LoadParams{}, inv, in, T);
+        }
+        return ripple_pp(out, 0);
+    };
+
+    float r_slow = settled_ripple(1e-4f);
+    float r_fast = settled_ripple(5e-5f);
+
+    EXPECT_GT(r_fast, 0.0f);
+    EXPECT_NEAR(r_slow / r_fast, 2.0f, 0.1f);
+}
+
+TEST(SwitchedInverter, PulseShorterThanDeadtimeIsSwallowed) {
+    PmsmParams motor = make_locked_params();
+    InverterParams inv{};
+    inv.t_dead = 1e-6f;
+    const float T = 5e-5f;
+
+    // d * T = 0.5 us against 1 us of dead time, with current flowing out of
+    // leg a: the rising edge is held past its own falling edge, so the
+    // pole never leaves the bottom rail, exactly as with m = -1.
+    PmsmState pulse{5.0f, -2.5f, -2.5f};
+    PmsmState clamped = pulse;
+    SwitchedInverterInput in{-0.98f, -1.0f, -1.0f, 24.0f, 0.0f};
+    switched_inverter_step(pulse, motor, LoadParams{}, inv, in, T);
+    in.m_a = -1.0f;
+    switched_inverter_step(clamped, motor, LoadParams{}, inv, in, T);
+
+    EXPECT_NEAR(pulse.ia, clamped.ia, 1e-4f);
+    EXPECT_NEAR(pulse.ib, clamped.ib, 1e-4f);
+}
+
+TEST(SwitchedInverter, DeadtimeLossMatchesAveragedModel) {
+    PmsmParams motor = make_locked_params();
+    InverterParams inv{};
+    inv.t_dead = 1e-6f;
+    inv.f_pwm = 20000.0f;
+    InverterParams ideal{};
+
+    float m[3] = {0.3f, -0.1f, -0.2f};
+    float T = 1.0f / inv.f_pwm;
+    PmsmState sw{};
+    PmsmState sw_ideal{};
+    PmsmState avg{};
+
+    for (int k = 0; k < 1000; ++k) {
+        SwitchedInverterInput sw_in{m[0], m[1], m[2], 24.0f, 0.0f};
+        switched_inverter_step(sw, motor, LoadParams{}, inv, sw_in, T);
+        switched_inverter_step(sw_ideal, motor, LoadParams{}, ideal, sw_in, T);
+
+        InverterInput avg_in{m[0], m[1], m[2], avg.ia, avg.ib, avg.ic, 24.0f};
+        InverterOutput v = inverter_step(inv, avg_in);
+        pmsm_step(avg, motor, PmsmInput{v.va, v.vb, v.vc, 0.0f}, T);
+    }
+
+    EXPECT_LT(std::fabs(sw.ia), std::fabs(sw_ideal.ia));
+    EXPECT_NEAR(sw.ia, avg.ia, 0.02f * std::fabs(avg.ia));
+}
+
+static SimAxisConfig make_sim_axis_cfg() {
+    SimAxisConfig cfg{};
+
+    cfg.axis_cfg.cur  = CurrentLoopConfig{1.0f};
+    cfg.axis_cfg.foc  = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est  = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim  = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.02f;
+
+    cfg.inverter.t_dead = 5e-7f;
+    cfg.inverter.f_pwm = 20000.0f;
+
+    cfg.v_bus = 24.0f;
+    return cfg;
+}
+
+TEST(SwitchedInverter, ClosedLoopOneSecondRunTracksAveragedModel) {
+    SimAxisConfig avg_cfg = make_sim_axis_cfg();
+    SimAxisConfig sw_cfg = make_sim_axis_cfg();
+    sw_cfg.switched_pwm = true;
+
+    for (SimAxisConfig* cfg : {&avg_cfg, &sw_cfg}) {
+        cfg->axis_cfg.foc.loop.id = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+        cfg->axis_cfg.foc.loop.iq = PIConfig{1.0f, 100.0f, -100.0f, 100.0f};
+    }
+
+    SimAxisState avg{};
+    SimAxisState sw{};
+
+    const float dt = 1.0f / 20000.0f;
+    float iq_sw = 0.0f;
+    for (int k = 0; k < 20000; ++k) {
+        sim_axis_step(avg, avg_cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 1.0f);
+        AxisCoreOutput out =
+            sim_axis_step(sw, sw_cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 1.0f);
+        iq_sw = out.i_dq.q;
+    }
+
+    EXPECT_NEAR(iq_sw, 1.0f, 0.05f);
+    EXPECT_NEAR(sw.motor_state.omega_m, avg.motor_state.omega_m,
+                0.02f * std::fabs(avg.motor_state.omega_m));
+}
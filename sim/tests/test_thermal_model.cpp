@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "sim_axis_runner.hpp"
+
+static ThermalParams make_thermal() {
+    ThermalParams th{};
+    th.t_ambient = 25.0f;
+    th.t_ref = 25.0f;
+    th.alpha_cu = 0.0039f;
+    th.alpha_mag = -0.0012f;
+    th.C_cu = 1.5f;
+    th.C_mag = 4.0f;
+    th.R_cu_amb = 4.0f;
+    th.R_cu_mag = 2.0f;
+    th.R_mag_amb = 4.0f;
+    return th;
+}
+
+TEST(ThermalModel, SettlesOnTheNetworkDivider) {
+    ThermalParams th = make_thermal();
+    ThermalState st{};
+    for (int k = 0; k < 200000; ++k) {
+        thermal_step(st, th, 10.0f, 1e-3f);
+    }
+    // 10 W into 4 K/W in parallel with 2 + 4 K/W: 24 K at the copper, the
+    // magnet two thirds of the way along the second branch.
+    EXPECT_NEAR(st.rise_cu, 24.0f, 0.05f);
+    EXPECT_NEAR(st.rise_mag, 16.0f, 0.05f);
+
+    PmsmParams cold{};
+    cold.Rs = 0.1f;
+    cold.psi_m = 0.05f;
+    PmsmParams hot = thermal_motor_params(cold, th, st);
+    EXPECT_NEAR(hot.Rs, 0.1f * (1.0f + 0.0039f * 24.0f), 1e-5f);
+    EXPECT_NEAR(hot.psi_m, 0.05f * (1.0f - 0.0012f * 16.0f), 1e-6f);
+
+    // At t_ref the datasheet values come back unchanged.
+    PmsmParams ref = thermal_motor_params(cold, th, ThermalState{});
+    EXPECT_FLOAT_EQ(ref.Rs, cold.Rs);
+    EXPECT_FLOAT_EQ(ref.psi_m, cold.psi_m);
+}
+
+static SimAxisConfig make_cfg(const ThermalParams* th) {
+    SimAxisConfig cfg{};
+    cfg.axis_cfg.spd = SpeedLoopConfig{-20.0f, 20.0f, PIConfig{0.05f, 2.0f, -20.0f, 20.0f}};
+    cfg.axis_cfg.cur = CurrentLoopConfig{1.0f, PIConfig{5.0f, 500.0f, -100.0f, 100.0f},
+                                         PIConfig{5.0f, 500.0f, -100.0f, 100.0f}};
+    cfg.axis_cfg.foc = FocConfig{cfg.axis_cfg.cur};
+    cfg.axis_cfg.est = SpeedEstimatorConfig{LowPassConfig{0.2f}};
+    cfg.axis_cfg.lim = LimitsConfig{-20.0f, 20.0f, -500.0f, 500.0f};
+
+    cfg.motor_params.Rs = 0.1f;
+    cfg.motor_params.Ls = 0.001f;
+    cfg.motor_params.psi_m = 0.05f;
+    cfg.motor_params.p = 4.0f;
+    cfg.motor_params.J = 0.0001f;
+    cfg.motor_params.B = 0.001f;
+    cfg.v_bus = 24.0f;
+    cfg.thermal = th;
+
+    // Held against friction above the 6 N*m that 20 A produce: every watt
+    // goes into the copper.
+    cfg.load.T_coulomb = 10.0f;
+    cfg.load.w_coulomb_band = 0.01f;
+    return cfg;
+}
+
+// The core estimator's single node: the network's steady-state resistance,
+// and its initial heating rate through tau = C_cu * r_th.
+static ThermalEstimatorConfig make_estimator() {
+    return ThermalEstimatorConfig{0.1f, 0.0039f, 2.4f, 3.6f, 25.0f, 80.0f, 100.0f};
+}
+
+TEST(SimThermal, SustainedCurrentHeatsWindingAndRaisesRs) {
+    ThermalParams th = make_thermal();
+    SimAxisConfig cfg = make_cfg(&th);
+    cfg.axis_cfg.thermal = make_estimator();
+    cfg.axis_cfg.thermal.t_derate = 0.0f;
+
+    const float dt = 5e-5f;
+    SimAxisState st{};
+    AxisCoreOutput out{};
+    for (int k = 0; k < 300000; ++k) {
+        out = sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 20.0f);
+    }
+    float t_cu = th.t_ambient + st.thermal.rise_cu;
+    RecordProperty("t_cu", std::to_string(t_cu));
+    RecordProperty("t_est", std::to_string(out.status.t_winding));
+
+    EXPECT_GT(t_cu, 150.0f);
+    EXPECT_FLOAT_EQ(out.status.iq_scale, 1.0f);
+    // One node misses the magnets soaking up heat early on, so the
+    // estimate errs hot while the network is still filling.
+    EXPECT_GT(out.status.t_winding, t_cu);
+    EXPECT_LT(out.status.t_winding - t_cu, 0.5f * (t_cu - th.t_ambient));
+
+    PmsmParams hot = thermal_motor_params(cfg.motor_params, th, st.thermal);
+    EXPECT_GT(hot.Rs, 1.4f * cfg.motor_params.Rs);
+    EXPECT_LT(hot.psi_m, cfg.motor_params.psi_m);
+
+    // The current loop still holds 20 A through the hotter winding.
+    EXPECT_NEAR(out.i_dq.q, 20.0f, 0.5f);
+}
+
+TEST(SimThermal, DeratingHoldsWindingBelowMax) {
+    ThermalParams th = make_thermal();
+    SimAxisConfig cfg = make_cfg(&th);
+    cfg.axis_cfg.thermal = make_estimator();
+
+    const float dt = 5e-5f;
+    SimAxisState st{};
+    AxisCoreOutput out{};
+    float t_cu_max = 0.0f;
+    for (int k = 0; k < 300000; ++k) {
+        out = sim_axis_step(st, cfg, dt, AxisMode::CurrentIq, 0.0f, 0.0f, 20.0f);
+        t_cu_max = std::max(t_cu_max, th.t_ambient + st.thermal.rise_cu);
+    }
+    float t_cu = th.t_ambient + st.thermal.rise_cu;
+    RecordProperty("t_cu_max", std::to_string(t_cu_max));
+    RecordProperty("iq_scale", std::to_string(out.status.iq_scale));
+
+    EXPECT_LT(t_cu_max, 105.0f);
+    EXPECT_GT(t_cu, 70.0f);
+    EXPECT_GT(out.status.iq_scale, 0.2f);
+    EXPECT_LT(out.status.iq_scale, 0.9f);
+    EXPECT_TRUE(out.status.iq_limited);
+    EXPECT_NEAR(out.i_dq.q, 20.0f * out.status.iq_scale, 0.5f);
+    EXPECT_GT(out.status.t_winding, t_cu);
+    EXPECT_LT(out.status.t_winding, t_cu + 15.0f);
+}